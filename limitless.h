@@ -57,9 +57,20 @@ typedef char limitless__assert_size[(sizeof(limitless_size) >= sizeof(void*)) ?
 #define LIMITLESS_LIMB_BITS_32 32
 #define LIMITLESS_LIMB_BITS_64 64
 
+/*
+Targets with a native double-word product (unsigned __int128, i.e. x86-64,
+aarch64 and other 64-bit GCC/Clang targets) default to 64-bit limbs, which
+halves the multiply instructions per bit in every kernel. Everything else,
+including MSVC and 32-bit targets, uses 32-bit limbs. Define
+LIMITLESS_LIMB_BITS to 32 or 64 to pick the width explicitly.
+*/
 #ifndef LIMITLESS_LIMB_BITS
+#if defined(__SIZEOF_INT128__)
+#define LIMITLESS_LIMB_BITS LIMITLESS_LIMB_BITS_64
+#else
 #define LIMITLESS_LIMB_BITS LIMITLESS_LIMB_BITS_32
 #endif
+#endif
 
 #if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
 typedef limitless_u32 limitless_limb;
@@ -109,18 +120,93 @@ typedef struct limitless_alloc {
   void* user;
 } limitless_alloc;
 
+/*
+Limb kernels behind magnitude addition and subtraction and the schoolbook
+multiply, squaring and division loops. Each works on n-limb spans. mul_1
+stores a * m and returns the high limb. addmul_1 adds a * m and returns the
+carry limb. submul_1 subtracts a * m and returns the borrow limb. add_n and
+sub_n store a + b and a - b and return the carry or borrow bit; r may equal
+a or b. limitless_ctx_init picks the fastest set the running CPU supports.
+*/
+typedef limitless_limb (*limitless_span_kernel_fn)(limitless_limb* r, const limitless_limb* a, limitless_size n, limitless_limb m);
+typedef limitless_limb (*limitless_span_addsub_fn)(limitless_limb* r, const limitless_limb* a, const limitless_limb* b, limitless_size n);
+
+typedef struct limitless_kernels {
+  limitless_span_kernel_fn mul_1;
+  limitless_span_kernel_fn addmul_1;
+  limitless_span_kernel_fn submul_1;
+  limitless_span_addsub_fn add_n;
+  limitless_span_addsub_fn sub_n;
+} limitless_kernels;
+
 typedef struct limitless_ctx {
   limitless_alloc allocator;
+  limitless_kernels kernels;
   limitless_size karatsuba_threshold;
+  limitless_size toom3_threshold;
+  limitless_size ntt_threshold;
+  limitless_size bz_threshold;
+  limitless_size hgcd_threshold;
+  limitless_limb* scratch;
+  limitless_size scratch_cap;
+  limitless_size scratch_top;
+  limitless_size scratch_depth;
+  limitless_size scratch_high_water;
 } limitless_ctx;
 
+/*
+A limitless_pool sits between a context and a backing allocator. Freed
+blocks are kept on per-size-class free lists (class c holds blocks of
+16 << c bytes) and handed back on the next request of that class, so a warm
+pool serves steady-state arithmetic without calling the backing allocator.
+Class misses are carved from a bump arena before falling back to the backing
+allocator; limitless_pool_mark and limitless_pool_release rewind that arena
+once every block taken after the mark has been freed again. Requests above
+the largest class go straight to the backing allocator. A pool is not
+synchronized: give each thread its own, like the context it backs.
+*/
+#define LIMITLESS_POOL_CLASSES 20
+
+typedef struct limitless_pool_stats {
+  limitless_size hits;
+  limitless_size misses;
+  limitless_size backing_calls;
+  limitless_size cached_bytes;
+  limitless_size arena_used;
+  limitless_size arena_cap;
+} limitless_pool_stats;
+
+typedef struct limitless_pool {
+  limitless_alloc backing;
+  void* free_lists[LIMITLESS_POOL_CLASSES];
+  unsigned char* arena;
+  limitless_size arena_cap;
+  limitless_size arena_used;
+  limitless_size hits;
+  limitless_size misses;
+  limitless_size backing_calls;
+  limitless_size cached_bytes;
+} limitless_pool;
+
+/*
+Magnitudes of up to LIMITLESS_INLINE_LIMBS limbs (128 bits at either limb
+width) live in inline_limbs and never touch the allocator; limbs is NULL and
+cap is 0 in that state. Larger magnitudes own a heap block of cap limbs. The
+struct holds no pointer into itself, so it stays safe to move by value; read
+the active storage through LIMITLESS_BIGINT_LIMBS.
+*/
+#define LIMITLESS_INLINE_LIMBS (128 / LIMITLESS_LIMB_BITS)
+
 typedef struct limitless_bigint {
   int sign;
   limitless_size used;
   limitless_size cap;
   limitless_limb* limbs;
+  limitless_limb inline_limbs[LIMITLESS_INLINE_LIMBS];
 } limitless_bigint;
 
+#define LIMITLESS_BIGINT_LIMBS(b) ((b)->limbs ? (b)->limbs : (limitless_limb*)(b)->inline_limbs)
+
 typedef struct limitless_rational {
   limitless_bigint num;
   limitless_bigint den;
@@ -136,13 +222,56 @@ typedef struct limitless_number {
   limitless_value v;
 } limitless_number;
 
+/*
+A limitless_modctx holds one modulus m of n limbs together with everything
+reductions under it need: R^2 mod m and -m^-1 mod B for odd m (Montgomery
+form, R = B^n), floor(B^(2n) / m) for even m (Barrett), and the
+normalization shift with the shifted modulus for bringing arbitrary integers
+into range. Build it once with limitless_modctx_init and reuse it for every
+operation under that modulus. Residues are integer limitless_numbers in
+[0, m): limitless_modctx_to_residue maps an integer in (into Montgomery form
+when m is odd) and limitless_modctx_from_residue maps it back. The fields are
+internal. Operations use the work values t and q, so a modctx, like the
+context it was built with, belongs to one thread at a time.
+*/
+typedef struct limitless_modctx {
+  limitless_bigint m;
+  limitless_bigint mn; /* m << shift, top bit set */
+  limitless_bigint r2; /* R^2 mod m, Montgomery only */
+  limitless_bigint mu; /* floor(B^(2n) / m), Barrett only */
+  limitless_bigint t;
+  limitless_bigint q;
+  limitless_size n;
+  limitless_limb minv; /* -m^-1 mod B, Montgomery only */
+  limitless_limb dinv; /* reciprocal of mn for single-limb moduli */
+  limitless_u32 shift;
+  int mont;
+} limitless_modctx;
+
 LIMITLESS_API limitless_status limitless_ctx_init(limitless_ctx* ctx, const limitless_alloc* alloc);
 LIMITLESS_API limitless_status limitless_ctx_init_default(limitless_ctx* ctx);
 LIMITLESS_API void limitless_ctx_set_karatsuba_threshold(limitless_ctx* ctx, limitless_size limbs);
+LIMITLESS_API void limitless_ctx_set_toom3_threshold(limitless_ctx* ctx, limitless_size limbs);
+LIMITLESS_API void limitless_ctx_set_ntt_threshold(limitless_ctx* ctx, limitless_size limbs);
+LIMITLESS_API void limitless_ctx_set_bz_threshold(limitless_ctx* ctx, limitless_size limbs);
+LIMITLESS_API void limitless_ctx_set_hgcd_threshold(limitless_ctx* ctx, limitless_size limbs);
+LIMITLESS_API void limitless_ctx_set_scratch(limitless_ctx* ctx, limitless_limb* buf, limitless_size limbs);
+LIMITLESS_API limitless_size limitless_ctx_scratch_high_water(const limitless_ctx* ctx);
+LIMITLESS_API void limitless_ctx_set_kernels(limitless_ctx* ctx, const limitless_kernels* kernels);
+
+LIMITLESS_API limitless_status limitless_pool_init(limitless_pool* pool, const limitless_alloc* backing, limitless_size arena_bytes);
+LIMITLESS_API void limitless_pool_destroy(limitless_pool* pool);
+LIMITLESS_API void limitless_pool_allocator(limitless_pool* pool, limitless_alloc* out);
+LIMITLESS_API void limitless_pool_trim(limitless_pool* pool);
+LIMITLESS_API limitless_size limitless_pool_mark(const limitless_pool* pool);
+LIMITLESS_API void limitless_pool_release(limitless_pool* pool, limitless_size mark);
+LIMITLESS_API void limitless_pool_get_stats(const limitless_pool* pool, limitless_pool_stats* out);
 
 LIMITLESS_API limitless_status limitless_number_init(limitless_ctx* ctx, limitless_number* n);
 LIMITLESS_API void limitless_number_clear(limitless_ctx* ctx, limitless_number* n);
 LIMITLESS_API limitless_status limitless_number_copy(limitless_ctx* ctx, limitless_number* dst, const limitless_number* src);
+LIMITLESS_API limitless_status limitless_number_reserve(limitless_ctx* ctx, limitless_number* n, limitless_size bits);
+LIMITLESS_API limitless_status limitless_number_shrink_to_fit(limitless_ctx* ctx, limitless_number* n);
 
 LIMITLESS_API limitless_status limitless_number_from_i64(limitless_ctx* ctx, limitless_number* out, limitless_i64 v);
 LIMITLESS_API limitless_status limitless_number_from_u64(limitless_ctx* ctx, limitless_number* out, limitless_u64 v);
@@ -168,8 +297,24 @@ LIMITLESS_API limitless_status limitless_number_abs(limitless_ctx* ctx, limitles
 LIMITLESS_API int limitless_number_cmp(limitless_ctx* ctx, const limitless_number* a, const limitless_number* b, limitless_status* st);
 
 LIMITLESS_API limitless_status limitless_number_gcd(limitless_ctx* ctx, limitless_number* out, const limitless_number* a, const limitless_number* b);
+LIMITLESS_API limitless_status limitless_number_gcdext(limitless_ctx* ctx, limitless_number* g, limitless_number* s, limitless_number* t, const limitless_number* a, const limitless_number* b);
+LIMITLESS_API limitless_status limitless_number_invmod(limitless_ctx* ctx, limitless_number* out, const limitless_number* a, const limitless_number* m);
 LIMITLESS_API limitless_status limitless_number_pow_u64(limitless_ctx* ctx, limitless_number* out, const limitless_number* a, limitless_u64 exp);
 LIMITLESS_API limitless_status limitless_number_modexp_u64(limitless_ctx* ctx, limitless_number* out, const limitless_number* a, limitless_u64 exp, const limitless_number* mod);
+LIMITLESS_API limitless_status limitless_number_modexp(limitless_ctx* ctx, limitless_number* out, const limitless_number* a, const limitless_number* exp, const limitless_number* mod);
+LIMITLESS_API limitless_status limitless_number_divmod_u64(limitless_ctx* ctx, limitless_number* q, const limitless_number* a, limitless_u64 d, limitless_u64* rem);
+
+LIMITLESS_API limitless_status limitless_modctx_init(limitless_ctx* ctx, limitless_modctx* mc, const limitless_number* mod);
+LIMITLESS_API void limitless_modctx_clear(limitless_ctx* ctx, limitless_modctx* mc);
+LIMITLESS_API limitless_status limitless_modctx_to_residue(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a);
+LIMITLESS_API limitless_status limitless_modctx_from_residue(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a);
+LIMITLESS_API limitless_status limitless_modctx_addmod(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a, const limitless_number* b);
+LIMITLESS_API limitless_status limitless_modctx_submod(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a, const limitless_number* b);
+LIMITLESS_API limitless_status limitless_modctx_mulmod(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a, const limitless_number* b);
+LIMITLESS_API limitless_status limitless_modctx_powmod(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a, const limitless_number* exp);
+LIMITLESS_API limitless_status limitless_modctx_invmod(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a);
+LIMITLESS_API limitless_status limitless_modctx_mulmod_ct(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a, const limitless_number* b);
+LIMITLESS_API limitless_status limitless_modctx_powmod_ct(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a, const limitless_number* exp);
 
 LIMITLESS_API int limitless_number_is_zero(const limitless_number* n);
 LIMITLESS_API int limitless_number_is_integer(const limitless_number* n);
@@ -186,6 +331,15 @@ extern "C" {
 #endif
 
 #define LIMITLESS__DEFAULT_KARATSUBA_THRESHOLD ((limitless_size)32)
+#define LIMITLESS__DEFAULT_TOOM3_THRESHOLD ((limitless_size)512)
+/* each 64-bit limb is two transform points, so wide limbs reach the ntt crossover later */
+#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
+#define LIMITLESS__DEFAULT_NTT_THRESHOLD ((limitless_size)1024)
+#else
+#define LIMITLESS__DEFAULT_NTT_THRESHOLD ((limitless_size)3072)
+#endif
+#define LIMITLESS__DEFAULT_BZ_THRESHOLD ((limitless_size)128)
+#define LIMITLESS__DEFAULT_HGCD_THRESHOLD ((limitless_size)128)
 
 #ifndef LIMITLESS_DEFAULT_ALLOC
 #if defined(_MSC_VER)
@@ -223,24 +377,525 @@ extern void free(void* ptr);
 #define LIMITLESS_DEFAULT_FREE(ptr, size) free((ptr))
 #endif
 
+/*
+Memory primitives. GCC and Clang get __builtin_memset/__builtin_memcpy,
+which the compiler inlines for small sizes and otherwise hands to the
+platform's vectorized routines. Defining LIMITLESS_FREESTANDING keeps
+compiled code free of memset/memcpy references; the fallbacks then move one
+limb per step, four at a time, on limb buffers, and one limitless_size word
+per step on byte buffers once the destination is word aligned. The compiler
+can still recognize such loops as memset/memcpy, so freestanding builds
+should also pass -fno-builtin or -fno-tree-loop-distribute-patterns.
+*/
+#if !defined(LIMITLESS_FREESTANDING) && (defined(__GNUC__) || defined(__clang__))
+#define LIMITLESS__HAVE_BUILTIN_MEM 1
+#else
+/* byte buffers are reached through this word type, so it must alias anything */
+#if defined(__GNUC__) || defined(__clang__)
+typedef limitless_size __attribute__((__may_alias__)) limitless__mem_word;
+#else
+typedef limitless_size limitless__mem_word;
+#endif
+#define LIMITLESS__MEM_WORD_MASK ((limitless_size)sizeof(limitless__mem_word) - 1u)
+#endif
+
 /* GCOVR_EXCL_START */
 static void limitless__mem_zero(void* p, limitless_size n) {
-  limitless_size i;
+#if defined(LIMITLESS__HAVE_BUILTIN_MEM)
+  if (n != 0) __builtin_memset(p, 0, n);
+#else
   limitless_u8* b = (limitless_u8*)p;
-  for (i = 0; i < n; ++i) {
-    b[i] = (limitless_u8)0;
-  }
+  limitless__mem_word* w;
+  for (; n != 0 && ((limitless_size)b & LIMITLESS__MEM_WORD_MASK) != 0; --n) *b++ = (limitless_u8)0;
+  w = (limitless__mem_word*)(void*)b;
+  for (; n > LIMITLESS__MEM_WORD_MASK; n -= LIMITLESS__MEM_WORD_MASK + 1u) *w++ = (limitless__mem_word)0;
+  b = (limitless_u8*)(void*)w;
+  for (; n != 0; --n) *b++ = (limitless_u8)0;
+#endif
 }
 
 static void limitless__mem_copy(void* dst, const void* src, limitless_size n) {
-  limitless_size i;
+#if defined(LIMITLESS__HAVE_BUILTIN_MEM)
+  if (n == 0 || !dst || !src) return;
+  __builtin_memcpy(dst, src, n);
+#else
   limitless_u8* d = (limitless_u8*)dst;
   const limitless_u8* s = (const limitless_u8*)src;
   if (n == 0) return;
   if (!d || !s) return;
-  for (i = 0; i < n; ++i) {
+  /* words only when both sides reach a word boundary together */
+  if ((((limitless_size)d ^ (limitless_size)s) & LIMITLESS__MEM_WORD_MASK) == 0) {
+    limitless__mem_word* wd;
+    const limitless__mem_word* ws;
+    for (; n != 0 && ((limitless_size)d & LIMITLESS__MEM_WORD_MASK) != 0; --n) *d++ = *s++;
+    wd = (limitless__mem_word*)(void*)d;
+    ws = (const limitless__mem_word*)(const void*)s;
+    for (; n > LIMITLESS__MEM_WORD_MASK; n -= LIMITLESS__MEM_WORD_MASK + 1u) *wd++ = *ws++;
+    d = (limitless_u8*)(void*)wd;
+    s = (const limitless_u8*)(const void*)ws;
+  }
+  for (; n != 0; --n) *d++ = *s++;
+#endif
+}
+
+static void limitless__limbs_zero(limitless_limb* p, limitless_size n) {
+#if defined(LIMITLESS__HAVE_BUILTIN_MEM)
+  if (n != 0) __builtin_memset(p, 0, n * (limitless_size)sizeof(limitless_limb));
+#else
+  limitless_size i = 0;
+  for (; i + 4 <= n; i += 4) {
+    p[i] = (limitless_limb)0;
+    p[i + 1] = (limitless_limb)0;
+    p[i + 2] = (limitless_limb)0;
+    p[i + 3] = (limitless_limb)0;
+  }
+  for (; i < n; ++i) p[i] = (limitless_limb)0;
+#endif
+}
+
+/* d and s must not overlap */
+static void limitless__limbs_copy(limitless_limb* d, const limitless_limb* s, limitless_size n) {
+#if defined(LIMITLESS__HAVE_BUILTIN_MEM)
+  if (n != 0) __builtin_memcpy(d, s, n * (limitless_size)sizeof(limitless_limb));
+#else
+  limitless_size i = 0;
+  for (; i + 4 <= n; i += 4) {
     d[i] = s[i];
+    d[i + 1] = s[i + 1];
+    d[i + 2] = s[i + 2];
+    d[i + 3] = s[i + 3];
+  }
+  for (; i < n; ++i) d[i] = s[i];
+#endif
+}
+
+/*
+compares two n-limb magnitudes from the top. Equal runs are skipped four
+limbs per test; with compiler builtins, 32-limb blocks go through memcmp
+first, which the C library vectorises. memcmp orders bytes, not limbs, so
+it only answers "equal or not" here.
+*/
+static int limitless__limbs_cmp(const limitless_limb* a, const limitless_limb* b, limitless_size n) {
+#if defined(LIMITLESS__HAVE_BUILTIN_MEM)
+  while (n >= 32 && __builtin_memcmp(a + n - 32, b + n - 32, 32u * (limitless_size)sizeof(limitless_limb)) == 0) {
+    n -= 32;
+  }
+#endif
+  while (n >= 4 && ((a[n - 1] ^ b[n - 1]) | (a[n - 2] ^ b[n - 2]) | (a[n - 3] ^ b[n - 3]) | (a[n - 4] ^ b[n - 4])) == (limitless_limb)0) {
+    n -= 4;
+  }
+  while (n > 0 && a[n - 1] == b[n - 1]) --n;
+  if (n == 0) return 0;
+  return (a[n - 1] < b[n - 1]) ? -1 : 1;
+}
+
+/*
+Raw limb-span kernels. Spans are little-endian limb arrays with an explicit
+length and may carry leading zero limbs; the output span never overlaps the
+inputs unless stated otherwise.
+*/
+static limitless_limb limitless__span_mul_1_c(limitless_limb* r, const limitless_limb* a, limitless_size n, limitless_limb m) {
+  limitless_size i;
+  limitless_dlimb carry = (limitless_dlimb)0;
+  for (i = 0; i < n; ++i) {
+    limitless_dlimb p = (limitless_dlimb)a[i] * m + carry;
+    r[i] = (limitless_limb)p;
+    carry = p >> LIMITLESS_LIMB_BITS;
+  }
+  return (limitless_limb)carry;
+}
+
+static limitless_limb limitless__span_addmul_1_c(limitless_limb* r, const limitless_limb* a, limitless_size n, limitless_limb m) {
+  limitless_size i;
+  limitless_dlimb carry = (limitless_dlimb)0;
+  for (i = 0; i < n; ++i) {
+    limitless_dlimb p = (limitless_dlimb)a[i] * m + r[i] + carry;
+    r[i] = (limitless_limb)p;
+    carry = p >> LIMITLESS_LIMB_BITS;
+  }
+  return (limitless_limb)carry;
+}
+
+static limitless_limb limitless__span_submul_1_c(limitless_limb* r, const limitless_limb* a, limitless_size n, limitless_limb m) {
+  limitless_size i;
+  limitless_dlimb carry = (limitless_dlimb)0;
+  for (i = 0; i < n; ++i) {
+    limitless_dlimb p = (limitless_dlimb)a[i] * m + carry;
+    limitless_limb plo = (limitless_limb)p;
+    limitless_limb cur = r[i];
+    r[i] = (limitless_limb)(cur - plo);
+    carry = (p >> LIMITLESS_LIMB_BITS) + (limitless_dlimb)(cur < plo);
+  }
+  return (limitless_limb)carry;
+}
+
+static limitless_limb limitless__span_add_n_c(limitless_limb* r, const limitless_limb* a, const limitless_limb* b, limitless_size n) {
+  limitless_size i;
+  limitless_limb carry = (limitless_limb)0;
+  for (i = 0; i < n; ++i) {
+    limitless_limb s = (limitless_limb)(a[i] + carry);
+    limitless_limb t = (limitless_limb)(s + b[i]);
+    carry = (limitless_limb)((s < carry) | (t < s));
+    r[i] = t;
+  }
+  return carry;
+}
+
+static limitless_limb limitless__span_sub_n_c(limitless_limb* r, const limitless_limb* a, const limitless_limb* b, limitless_size n) {
+  limitless_size i;
+  limitless_limb borrow = (limitless_limb)0;
+  for (i = 0; i < n; ++i) {
+    limitless_limb ai = a[i];
+    limitless_limb d = (limitless_limb)(ai - b[i]);
+    limitless_limb nb = (limitless_limb)((ai < b[i]) | (d < borrow));
+    r[i] = (limitless_limb)(d - borrow);
+    borrow = nb;
+  }
+  return borrow;
+}
+
+/*
+x86-64 kernels for 64-bit limbs, built with GCC or Clang unless
+LIMITLESS_NO_ASM is defined. add_n and sub_n run the baseline ADC/SBB
+chain, or a carry-lookahead AVX-512 loop where the CPU and OS support it.
+The multiply kernels need BMI2 and ADX: MULX multiplies without touching
+the flags, so the low halves and the carried high halves ride two
+independent carry chains, ADCX on CF and ADOX on OF. Every loop steps with
+LEA and JRCXZ, which leave both flags alone. submul_1 adds the complement
+of each product limb with CF preset, so CF ends up as "no borrow" from the
+low part.
+*/
+#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_64) && !defined(LIMITLESS_NO_ASM) && \
+    (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__) && !defined(__ILP32__)
+#define LIMITLESS__HAVE_X86_64_ASM 1
+
+/*
+Shared loop skeleton: single steps for n % 4 limbs, then a four-way
+unrolled loop. The high half of each product alternates between hi and c so
+the unrolled body needs no register moves. [q] holds n / 4 and rcx starts
+at n % 4.
+*/
+#define LIMITLESS__ADX_LOOP(single, quad) \
+  "jrcxz 3f\n\t" \
+  "1:\n\t" single \
+  "leaq 8(%[a]), %[a]\n\t" \
+  "leaq 8(%[r]), %[r]\n\t" \
+  "leaq -1(%%rcx), %%rcx\n\t" \
+  "jrcxz 3f\n\t" \
+  "jmp 1b\n" \
+  "3:\n\t" \
+  "movq %[q], %%rcx\n\t" \
+  "jrcxz 2f\n\t" \
+  "4:\n\t" quad \
+  "leaq 32(%[a]), %[a]\n\t" \
+  "leaq 32(%[r]), %[r]\n\t" \
+  "leaq -1(%%rcx), %%rcx\n\t" \
+  "jrcxz 2f\n\t" \
+  "jmp 4b\n" \
+  "2:\n\t"
+
+/* r[k] = lo(a[k] * m) + previous high + CF */
+#define LIMITLESS__ADX_MUL_STEP(off, prev, next) \
+  "mulxq " off "(%[a]), %[lo], %[" next "]\n\t" \
+  "adcxq %[" prev "], %[lo]\n\t" \
+  "movq %[lo], " off "(%[r])\n\t"
+
+/* r[k] += lo(a[k] * m) + CF, then + previous high + OF */
+#define LIMITLESS__ADX_ADDMUL_STEP(off, prev, next) \
+  "mulxq " off "(%[a]), %[lo], %[" next "]\n\t" \
+  "adcxq " off "(%[r]), %[lo]\n\t" \
+  "adoxq %[" prev "], %[lo]\n\t" \
+  "movq %[lo], " off "(%[r])\n\t"
+
+/* p = lo(a[k] * m) + previous high + OF, then r[k] += ~p + CF */
+#define LIMITLESS__ADX_SUBMUL_STEP(off, prev, next) \
+  "mulxq " off "(%[a]), %[lo], %[" next "]\n\t" \
+  "adoxq %[" prev "], %[lo]\n\t" \
+  "notq %[lo]\n\t" \
+  "adcxq " off "(%[r]), %[lo]\n\t" \
+  "movq %[lo], " off "(%[r])\n\t"
+
+#define LIMITLESS__ADX_BODY(STEP) \
+  LIMITLESS__ADX_LOOP( \
+      STEP("0", "c", "hi") "movq %[hi], %[c]\n\t", \
+      STEP("0", "c", "hi") STEP("8", "hi", "c") STEP("16", "c", "hi") STEP("24", "hi", "c"))
+
+#define LIMITLESS__ADX_OPERANDS \
+  : [r] "+&r"(r), [a] "+&r"(a), [n] "+&c"(n), [c] "+&r"(c), [lo] "=&r"(lo), [hi] "=&r"(hi) \
+  : "d"(m), [q] "r"(q) \
+  : "cc", "memory"
+
+static limitless_limb limitless__span_mul_1_adx(limitless_limb* r, const limitless_limb* a, limitless_size n, limitless_limb m) {
+  limitless_limb c = (limitless_limb)0;
+  limitless_limb lo;
+  limitless_limb hi;
+  limitless_size q = n / 4u;
+  n %= 4u;
+  __asm__ __volatile__(
+      "xorl %k[lo], %k[lo]\n\t"
+      LIMITLESS__ADX_BODY(LIMITLESS__ADX_MUL_STEP)
+      "movl $0, %k[lo]\n\t"
+      "adcxq %[lo], %[c]\n\t"
+      LIMITLESS__ADX_OPERANDS);
+  return c;
+}
+
+static limitless_limb limitless__span_addmul_1_adx(limitless_limb* r, const limitless_limb* a, limitless_size n, limitless_limb m) {
+  limitless_limb c = (limitless_limb)0;
+  limitless_limb lo;
+  limitless_limb hi;
+  limitless_size q = n / 4u;
+  n %= 4u;
+  __asm__ __volatile__(
+      "xorl %k[lo], %k[lo]\n\t"
+      LIMITLESS__ADX_BODY(LIMITLESS__ADX_ADDMUL_STEP)
+      "movl $0, %k[lo]\n\t"
+      "adcxq %[lo], %[c]\n\t"
+      "adoxq %[lo], %[c]\n\t"
+      LIMITLESS__ADX_OPERANDS);
+  return c;
+}
+
+static limitless_limb limitless__span_submul_1_adx(limitless_limb* r, const limitless_limb* a, limitless_size n, limitless_limb m) {
+  limitless_limb c = (limitless_limb)0;
+  limitless_limb lo;
+  limitless_limb hi;
+  limitless_size q = n / 4u;
+  n %= 4u;
+  __asm__ __volatile__(
+      "xorl %k[lo], %k[lo]\n\t"
+      "stc\n\t"
+      LIMITLESS__ADX_BODY(LIMITLESS__ADX_SUBMUL_STEP)
+      "movl $0, %k[lo]\n\t"
+      "adoxq %[lo], %[c]\n\t"
+      "cmc\n\t"
+      "adcxq %[lo], %[c]\n\t"
+      LIMITLESS__ADX_OPERANDS);
+  return c;
+}
+
+/* same skeleton as the multiply kernels, with b advancing alongside a */
+#define LIMITLESS__X64_ADDSUB(op) \
+  "jrcxz 3f\n\t" \
+  "1:\n\t" \
+  "movq (%[a]), %[t0]\n\t" \
+  op " (%[b]), %[t0]\n\t" \
+  "movq %[t0], (%[r])\n\t" \
+  "leaq 8(%[a]), %[a]\n\t" \
+  "leaq 8(%[b]), %[b]\n\t" \
+  "leaq 8(%[r]), %[r]\n\t" \
+  "leaq -1(%%rcx), %%rcx\n\t" \
+  "jrcxz 3f\n\t" \
+  "jmp 1b\n" \
+  "3:\n\t" \
+  "movq %[q], %%rcx\n\t" \
+  "jrcxz 2f\n\t" \
+  "4:\n\t" \
+  "movq (%[a]), %[t0]\n\t" \
+  "movq 8(%[a]), %[t1]\n\t" \
+  op " (%[b]), %[t0]\n\t" \
+  op " 8(%[b]), %[t1]\n\t" \
+  "movq %[t0], (%[r])\n\t" \
+  "movq %[t1], 8(%[r])\n\t" \
+  "movq 16(%[a]), %[t0]\n\t" \
+  "movq 24(%[a]), %[t1]\n\t" \
+  op " 16(%[b]), %[t0]\n\t" \
+  op " 24(%[b]), %[t1]\n\t" \
+  "movq %[t0], 16(%[r])\n\t" \
+  "movq %[t1], 24(%[r])\n\t" \
+  "leaq 32(%[a]), %[a]\n\t" \
+  "leaq 32(%[b]), %[b]\n\t" \
+  "leaq 32(%[r]), %[r]\n\t" \
+  "leaq -1(%%rcx), %%rcx\n\t" \
+  "jrcxz 2f\n\t" \
+  "jmp 4b\n" \
+  "2:\n\t" \
+  "setc %b[c]\n\t"
+
+#define LIMITLESS__X64_ADDSUB_OPERANDS \
+  : [r] "+&r"(r), [a] "+&r"(a), [b] "+&r"(b), [n] "+&c"(n), [c] "+&r"(c), [t0] "=&r"(t0), [t1] "=&r"(t1) \
+  : [q] "r"(q) \
+  : "cc", "memory"
+
+static limitless_limb limitless__span_add_n_x64(limitless_limb* r, const limitless_limb* a, const limitless_limb* b, limitless_size n) {
+  limitless_limb c = (limitless_limb)0;
+  limitless_limb t0;
+  limitless_limb t1;
+  limitless_size q = n / 4u;
+  n %= 4u;
+  __asm__ __volatile__(
+      "xorl %k[t0], %k[t0]\n\t"
+      LIMITLESS__X64_ADDSUB("adcq")
+      LIMITLESS__X64_ADDSUB_OPERANDS);
+  return c;
+}
+
+static limitless_limb limitless__span_sub_n_x64(limitless_limb* r, const limitless_limb* a, const limitless_limb* b, limitless_size n) {
+  limitless_limb c = (limitless_limb)0;
+  limitless_limb t0;
+  limitless_limb t1;
+  limitless_size q = n / 4u;
+  n %= 4u;
+  __asm__ __volatile__(
+      "xorl %k[t0], %k[t0]\n\t"
+      LIMITLESS__X64_ADDSUB("sbbq")
+      LIMITLESS__X64_ADDSUB_OPERANDS);
+  return c;
+}
+
+/*
+AVX-512 add_n and sub_n, eight limbs per step. Lane sums are formed without
+carries; lanes that overflow generate a carry (bitmask G) and lanes equal to
+all ones (for sub: all zeros) propagate one (bitmask P). Resolving the
+carries is then an 8-bit integer addition: T = (2G | carry_in) + P, where
+T ^ P marks the lanes that receive a carry and bit 8 of T carries out. The
+n % 8 low limbs go through the ADC/SBB kernels first so the vector loop
+runs on whole blocks.
+*/
+#define LIMITLESS__AVX512_ADDSUB(lane_op, gen_cmp, prop, fix_op) \
+  "vpternlogq $0xff, %%zmm2, %%zmm2, %%zmm2\n\t" \
+  "vpxorq %%zmm3, %%zmm3, %%zmm3\n\t" \
+  "1:\n\t" \
+  "vmovdqu64 (%[a]), %%zmm0\n\t" \
+  "vmovdqu64 (%[b]), %%zmm4\n\t" \
+  lane_op " %%zmm4, %%zmm0, %%zmm1\n\t" \
+  gen_cmp "\n\t" \
+  "vpcmpeqq " prop ", %%zmm1, %%k2\n\t" \
+  "kmovw %%k1, %k[g]\n\t" \
+  "kmovw %%k2, %k[p]\n\t" \
+  "leaq (%[c], %[g], 2), %[g]\n\t" \
+  "addq %[p], %[g]\n\t" \
+  "xorq %[g], %[p]\n\t" \
+  "shrq $8, %[g]\n\t" \
+  "movq %[g], %[c]\n\t" \
+  "kmovw %k[p], %%k3\n\t" \
+  fix_op " %%zmm2, %%zmm1, %%zmm1%{%%k3%}\n\t" \
+  "vmovdqu64 %%zmm1, (%[r])\n\t" \
+  "addq $64, %[a]\n\t" \
+  "addq $64, %[b]\n\t" \
+  "addq $64, %[r]\n\t" \
+  "decq %[q]\n\t" \
+  "jnz 1b\n\t" \
+  "vzeroupper\n\t"
+
+#define LIMITLESS__AVX512_OPERANDS \
+  : [r] "+&r"(r), [a] "+&r"(a), [b] "+&r"(b), [q] "+&r"(q), [c] "+&r"(c), [g] "=&r"(g), [p] "=&r"(p) \
+  : \
+  : "cc", "memory", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "k1", "k2", "k3"
+
+__attribute__((target("avx512f"))) static limitless_limb limitless__span_add_n_avx512(limitless_limb* r, const limitless_limb* a, const limitless_limb* b, limitless_size n) {
+  limitless_size head = n % 8u;
+  limitless_size q = n / 8u;
+  limitless_limb c = limitless__span_add_n_x64(r, a, b, head);
+  limitless_limb g;
+  limitless_limb p;
+  if (q == 0) return c;
+  r += head;
+  a += head;
+  b += head;
+  /* G: sum < a; P: sum == ~0; a carry adds 1 (subtracts the all-ones vector) */
+  __asm__ __volatile__(
+      LIMITLESS__AVX512_ADDSUB("vpaddq", "vpcmpuq $1, %%zmm0, %%zmm1, %%k1", "%%zmm2", "vpsubq")
+      LIMITLESS__AVX512_OPERANDS);
+  return c;
+}
+
+__attribute__((target("avx512f"))) static limitless_limb limitless__span_sub_n_avx512(limitless_limb* r, const limitless_limb* a, const limitless_limb* b, limitless_size n) {
+  limitless_size head = n % 8u;
+  limitless_size q = n / 8u;
+  limitless_limb c = limitless__span_sub_n_x64(r, a, b, head);
+  limitless_limb g;
+  limitless_limb p;
+  if (q == 0) return c;
+  r += head;
+  a += head;
+  b += head;
+  /* G: a < b; P: difference == 0; a borrow subtracts 1 (adds the all-ones vector) */
+  __asm__ __volatile__(
+      LIMITLESS__AVX512_ADDSUB("vpsubq", "vpcmpuq $1, %%zmm4, %%zmm0, %%k1", "%%zmm3", "vpaddq")
+      LIMITLESS__AVX512_OPERANDS);
+  return c;
+}
+
+#define LIMITLESS__CPU_ADX 1u
+#define LIMITLESS__CPU_AVX512 2u
+
+/*
+CPUID leaf 7 EBX: bit 8 is BMI2 (MULX), bit 16 AVX512F, bit 19 ADX
+(ADCX/ADOX). AVX-512 also needs the OS to save the opmask and ZMM state:
+OSXSAVE (leaf 1 ECX bit 27) and XCR0 bits 1, 2 and 5-7.
+*/
+static unsigned limitless__cpu_features(void) {
+  limitless_u32 eax;
+  limitless_u32 ebx;
+  limitless_u32 ecx;
+  limitless_u32 edx;
+  limitless_u32 leaf1_ecx;
+  unsigned f = 0u;
+  __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(0u), "c"(0u));
+  if (eax < 7u) return f;
+  __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(1u), "c"(0u));
+  leaf1_ecx = ecx;
+  __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(7u), "c"(0u));
+  if (((ebx >> 8) & 1u) && ((ebx >> 19) & 1u)) f |= LIMITLESS__CPU_ADX;
+  if (((ebx >> 16) & 1u) && ((leaf1_ecx >> 27) & 1u)) {
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0u));
+    if ((eax & 0xe6u) == 0xe6u) f |= LIMITLESS__CPU_AVX512;
+  }
+  return f;
+}
+#endif
+
+static void limitless__kernels_portable(limitless_kernels* k) {
+  k->mul_1 = limitless__span_mul_1_c;
+  k->addmul_1 = limitless__span_addmul_1_c;
+  k->submul_1 = limitless__span_submul_1_c;
+  k->add_n = limitless__span_add_n_c;
+  k->sub_n = limitless__span_sub_n_c;
+}
+
+static void limitless__kernels_detect(limitless_kernels* k) {
+#if defined(LIMITLESS__HAVE_X86_64_ASM)
+  unsigned f = limitless__cpu_features();
+#endif
+  limitless__kernels_portable(k);
+#if defined(LIMITLESS__HAVE_X86_64_ASM)
+  k->add_n = limitless__span_add_n_x64;
+  k->sub_n = limitless__span_sub_n_x64;
+  if (f & LIMITLESS__CPU_ADX) {
+    k->mul_1 = limitless__span_mul_1_adx;
+    k->addmul_1 = limitless__span_addmul_1_adx;
+    k->submul_1 = limitless__span_submul_1_adx;
+  }
+  if (f & LIMITLESS__CPU_AVX512) {
+    k->add_n = limitless__span_add_n_avx512;
+    k->sub_n = limitless__span_sub_n_avx512;
+  }
+#endif
+}
+
+/* r = a + b for an >= bn; r may alias a. Returns the carry out of limb an - 1. */
+static limitless_limb limitless__span_add(const limitless_ctx* ctx, limitless_limb* r, const limitless_limb* a, limitless_size an, const limitless_limb* b, limitless_size bn) {
+  limitless_size i = bn;
+  limitless_limb carry = ctx->kernels.add_n(r, a, b, bn);
+  for (; carry != (limitless_limb)0 && i < an; ++i) {
+    r[i] = (limitless_limb)(a[i] + 1u);
+    carry = (limitless_limb)(r[i] == (limitless_limb)0);
+  }
+  if (r != a && i < an) limitless__limbs_copy(r + i, a + i, an - i);
+  return carry;
+}
+
+/* r = a - b for an >= bn and a >= b; r may alias a */
+static void limitless__span_sub(const limitless_ctx* ctx, limitless_limb* r, const limitless_limb* a, limitless_size an, const limitless_limb* b, limitless_size bn) {
+  limitless_size i = bn;
+  limitless_limb borrow = ctx->kernels.sub_n(r, a, b, bn);
+  for (; borrow != (limitless_limb)0 && i < an; ++i) {
+    limitless_limb ai = a[i];
+    r[i] = (limitless_limb)(ai - 1u);
+    borrow = (limitless_limb)(ai == (limitless_limb)0);
   }
+  if (r != a && i < an) limitless__limbs_copy(r + i, a + i, an - i);
 }
 
 static int limitless__is_space(char c) {
@@ -259,45 +914,122 @@ static char limitless__digit_chr(int v) {
   return (char)('a' + (v - 10));
 }
 
-#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
+/* ceil(256 * log2(base)): an upper bound on the bits per digit, in 1/256 bit units */
+static const limitless_u32 limitless__digit_bits_q8[37] = {
+  0, 0, 256, 406, 512, 595, 662, 719, 768, 812, 851, 886, 918, 948, 975, 1001, 1024, 1047, 1068,
+  1088, 1107, 1125, 1142, 1159, 1174, 1189, 1204, 1218, 1231, 1244, 1257, 1269, 1280, 1292, 1303, 1314, 1324
+};
+
+/*
+Bit scans. GCC and Clang lower __builtin_ctz/__builtin_clz to the hardware
+instructions (tzcnt/lzcnt, bsf/bsr, clz/rbit). MSVC gets the _BitScan
+intrinsics, declared here because the header includes nothing; 32-bit MSVC
+targets scan a 64-bit word as two halves. Other compilers use a branchy
+binary search that halves the window each step, as does any build that
+defines LIMITLESS_PORTABLE_BITSCAN. ctz requires x != 0.
+*/
+#if defined(LIMITLESS_PORTABLE_BITSCAN)
+/* forced portable scans, e.g. to test the fallback on a compiler that has builtins */
+#elif defined(__GNUC__) || defined(__clang__)
+#define LIMITLESS__HAVE_BUILTIN_BITSCAN 1
+#elif defined(_MSC_VER)
+#define LIMITLESS__HAVE_MSVC_BITSCAN 1
+unsigned char _BitScanForward(unsigned long* index, unsigned long mask);
+unsigned char _BitScanReverse(unsigned long* index, unsigned long mask);
+#pragma intrinsic(_BitScanForward, _BitScanReverse)
+#if defined(_M_X64) || defined(_M_ARM64)
+#define LIMITLESS__HAVE_MSVC_BITSCAN64 1
+unsigned char _BitScanForward64(unsigned long* index, unsigned __int64 mask);
+unsigned char _BitScanReverse64(unsigned long* index, unsigned __int64 mask);
+#pragma intrinsic(_BitScanForward64, _BitScanReverse64)
+#endif
+#endif
+
+/* 64-bit limbs only need the 32-bit scans when splitting a word in halves. */
+#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32) || \
+    (!defined(LIMITLESS__HAVE_BUILTIN_BITSCAN) && !defined(LIMITLESS__HAVE_MSVC_BITSCAN64))
 static limitless_u32 limitless__ctz_u32(limitless_u32 x) {
+#if defined(LIMITLESS__HAVE_BUILTIN_BITSCAN)
+  return (limitless_u32)__builtin_ctz(x);
+#elif defined(LIMITLESS__HAVE_MSVC_BITSCAN)
+  unsigned long i;
+  _BitScanForward(&i, (unsigned long)x);
+  return (limitless_u32)i;
+#else
   limitless_u32 n = 0;
-  while ((x & 1u) == 0u) {
-    x >>= 1;
-    ++n;
-  }
+  if ((x & 0xffffu) == 0u) { n += 16u; x >>= 16; }
+  if ((x & 0xffu) == 0u) { n += 8u; x >>= 8; }
+  if ((x & 0xfu) == 0u) { n += 4u; x >>= 4; }
+  if ((x & 0x3u) == 0u) { n += 2u; x >>= 2; }
+  if ((x & 0x1u) == 0u) n += 1u;
   return n;
+#endif
 }
 
 static limitless_u32 limitless__clz_u32(limitless_u32 x) {
+#if defined(LIMITLESS__HAVE_BUILTIN_BITSCAN)
+  return (x == 0u) ? 32u : (limitless_u32)__builtin_clz(x);
+#elif defined(LIMITLESS__HAVE_MSVC_BITSCAN)
+  unsigned long i;
+  if (!_BitScanReverse(&i, (unsigned long)x)) return 32u;
+  return (limitless_u32)(31u - i);
+#else
   limitless_u32 n = 0;
   if (x == 0u) return 32u;
-  while ((x & 0x80000000u) == 0u) {
-    x <<= 1;
-    ++n;
-  }
+  if ((x & 0xffff0000u) == 0u) { n += 16u; x <<= 16; }
+  if ((x & 0xff000000u) == 0u) { n += 8u; x <<= 8; }
+  if ((x & 0xf0000000u) == 0u) { n += 4u; x <<= 4; }
+  if ((x & 0xc0000000u) == 0u) { n += 2u; x <<= 2; }
+  if ((x & 0x80000000u) == 0u) n += 1u;
   return n;
+#endif
 }
-#else
+#endif
+
+#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_64)
 static limitless_u32 limitless__ctz_u64(limitless_u64 x) {
-  limitless_u32 n = 0;
-  while ((x & (limitless_u64)1u) == (limitless_u64)0u) {
-    x >>= 1;
-    ++n;
-  }
-  return n;
+#if defined(LIMITLESS__HAVE_BUILTIN_BITSCAN)
+  return (limitless_u32)__builtin_ctzll(x);
+#elif defined(LIMITLESS__HAVE_MSVC_BITSCAN64)
+  unsigned long i;
+  _BitScanForward64(&i, (unsigned __int64)x);
+  return (limitless_u32)i;
+#else
+  limitless_u32 lo = (limitless_u32)x;
+  return (lo != 0u) ? limitless__ctz_u32(lo) : 32u + limitless__ctz_u32((limitless_u32)(x >> 32));
+#endif
 }
 
 static limitless_u32 limitless__clz_u64(limitless_u64 x) {
-  limitless_u32 n = 0;
-  if (x == (limitless_u64)0u) return 64u;
-  while ((x & (((limitless_u64)1u) << 63)) == (limitless_u64)0u) {
-    x <<= 1;
-    ++n;
-  }
-  return n;
+#if defined(LIMITLESS__HAVE_BUILTIN_BITSCAN)
+  return (x == (limitless_u64)0u) ? 64u : (limitless_u32)__builtin_clzll(x);
+#elif defined(LIMITLESS__HAVE_MSVC_BITSCAN64)
+  unsigned long i;
+  if (!_BitScanReverse64(&i, (unsigned __int64)x)) return 64u;
+  return (limitless_u32)(63u - i);
+#else
+  limitless_u32 hi = (limitless_u32)(x >> 32);
+  return (hi != 0u) ? limitless__clz_u32(hi) : 32u + limitless__clz_u32((limitless_u32)x);
+#endif
+}
+#endif
+
+static limitless_u32 limitless__limb_clz(limitless_limb x) {
+#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
+  return limitless__clz_u32((limitless_u32)x);
+#else
+  return limitless__clz_u64((limitless_u64)x);
+#endif
 }
+
+/* x must be nonzero */
+static limitless_u32 limitless__limb_ctz(limitless_limb x) {
+#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
+  return limitless__ctz_u32((limitless_u32)x);
+#else
+  return limitless__ctz_u64((limitless_u64)x);
 #endif
+}
 
 static int limitless__alloc_valid(const limitless_alloc* a) {
   return a && a->alloc && a->realloc && a->free;
@@ -318,6 +1050,38 @@ static void limitless__free_bytes(limitless_ctx* ctx, void* ptr, limitless_size
   ctx->allocator.free(ctx->allocator.user, ptr, size);
 }
 
+/*
+Scratch stack. Internal temporaries whose size is known up front borrow n > 0
+limbs from the buffer installed with limitless_ctx_set_scratch and hand them
+back in LIFO order; a request that does not fit, or any request without a
+buffer, goes to the allocator instead. scratch_high_water records the deepest
+total demand either way, so it is the buffer size that would have served
+every request.
+*/
+static limitless_limb* limitless__scratch_push(limitless_ctx* ctx, limitless_size n) {
+  limitless_limb* p;
+  if (n <= ctx->scratch_cap - ctx->scratch_top) {
+    p = ctx->scratch + ctx->scratch_top;
+    ctx->scratch_top += n;
+  } else {
+    p = (limitless_limb*)limitless__alloc_bytes(ctx, n * (limitless_size)sizeof(limitless_limb));
+    if (!p) return NULL;
+  }
+  ctx->scratch_depth += n;
+  if (ctx->scratch_depth > ctx->scratch_high_water) ctx->scratch_high_water = ctx->scratch_depth;
+  return p;
+}
+
+static void limitless__scratch_pop(limitless_ctx* ctx, limitless_limb* p, limitless_size n) {
+  if (!p) return;
+  ctx->scratch_depth -= n;
+  if (ctx->scratch && p >= ctx->scratch && p < ctx->scratch + ctx->scratch_cap) {
+    ctx->scratch_top = (limitless_size)(p - ctx->scratch);
+  } else {
+    limitless__free_bytes(ctx, p, n * (limitless_size)sizeof(limitless_limb));
+  }
+}
+
 static void* limitless__default_alloc_fn(void* user, limitless_size size) {
   (void)user;
   return LIMITLESS_DEFAULT_ALLOC(size);
@@ -340,15 +1104,11 @@ static void limitless__bigint_init_raw(limitless_bigint* a) {
   a->used = 0;
   a->cap = 0;
   a->limbs = NULL;
+  limitless__mem_zero(a->inline_limbs, (limitless_size)sizeof(a->inline_limbs));
 }
 
 static void limitless__bigint_norm(limitless_bigint* a) {
-  if (a->used > 0 && !a->limbs) {
-    a->used = 0;
-    a->sign = 0;
-    return;
-  }
-  while (a->used > 0 && a->limbs[a->used - 1] == (limitless_limb)0) {
+  while (a->used > 0 && LIMITLESS_BIGINT_LIMBS(a)[a->used - 1] == (limitless_limb)0) {
     --a->used;
   }
   if (a->used == 0) {
@@ -356,15 +1116,38 @@ static void limitless__bigint_norm(limitless_bigint* a) {
   }
 }
 
-static limitless_status limitless__bigint_reserve(limitless_ctx* ctx, limitless_bigint* a, limitless_size need) {
-  limitless_size new_cap;
+/* moves a to a block of exactly new_cap limbs (more than it holds now), keeping its limbs; zero clears the new tail */
+static limitless_status limitless__bigint_regrow(limitless_ctx* ctx, limitless_bigint* a, limitless_size new_cap, int zero) {
   limitless_size old_bytes;
-  limitless_size new_bytes;
+  limitless_size new_bytes = new_cap * (limitless_size)sizeof(limitless_limb);
   void* mem;
-  if (need == 0) return LIMITLESS_OK;
-  if (!a->limbs) a->cap = 0;
-  if (need <= a->cap && a->limbs) return LIMITLESS_OK;
-  new_cap = (a->cap > 0) ? a->cap : (limitless_size)1;
+  if (a->limbs) {
+    old_bytes = a->cap * (limitless_size)sizeof(limitless_limb);
+    mem = limitless__realloc_bytes(ctx, a->limbs, old_bytes, new_bytes);
+    if (!mem) return LIMITLESS_EOOM;
+  } else {
+    /* leaving inline storage: the inline limbs become the first cap limbs */
+    mem = limitless__alloc_bytes(ctx, new_bytes);
+    if (!mem) return LIMITLESS_EOOM;
+    old_bytes = (limitless_size)sizeof(a->inline_limbs);
+    limitless__mem_copy(mem, a->inline_limbs, old_bytes);
+  }
+  a->limbs = (limitless_limb*)mem;
+  if (zero && new_bytes > old_bytes) {
+    limitless__mem_zero((unsigned char*)mem + old_bytes, new_bytes - old_bytes);
+  }
+  a->cap = new_cap;
+  return LIMITLESS_OK;
+}
+
+static limitless_size limitless__bigint_capacity(const limitless_bigint* a) {
+  return a->limbs ? a->cap : (limitless_size)LIMITLESS_INLINE_LIMBS;
+}
+
+/* geometric growth for values built up a limb at a time; grown limbs read as zero */
+static limitless_status limitless__bigint_reserve(limitless_ctx* ctx, limitless_bigint* a, limitless_size need) {
+  limitless_size new_cap = limitless__bigint_capacity(a);
+  if (need <= new_cap) return LIMITLESS_OK;
   while (new_cap < need) {
     if (new_cap > ((~(limitless_size)0) / 2u)) {
       new_cap = need;
@@ -372,19 +1155,34 @@ static limitless_status limitless__bigint_reserve(limitless_ctx* ctx, limitless_
     }
     new_cap *= 2u;
   }
-  old_bytes = a->cap * (limitless_size)(sizeof(limitless_limb));
-  new_bytes = new_cap * (limitless_size)(sizeof(limitless_limb));
-  if (a->limbs) {
-    mem = limitless__realloc_bytes(ctx, a->limbs, old_bytes, new_bytes);
-  } else {
-    mem = limitless__alloc_bytes(ctx, new_bytes);
+  return limitless__bigint_regrow(ctx, a, new_cap, 1);
+}
+
+/* exactly need limbs and no zero fill, for callers that know their result size and write all of it */
+static limitless_status limitless__bigint_reserve_exact(limitless_ctx* ctx, limitless_bigint* a, limitless_size need) {
+  if (need <= limitless__bigint_capacity(a)) return LIMITLESS_OK;
+  return limitless__bigint_regrow(ctx, a, need, 0);
+}
+
+/* trims the heap block to used limbs, or moves the value back inline when it fits */
+static limitless_status limitless__bigint_shrink(limitless_ctx* ctx, limitless_bigint* a) {
+  limitless_size old_bytes;
+  void* mem;
+  if (!a->limbs || a->cap == a->used) return LIMITLESS_OK;
+  old_bytes = a->cap * (limitless_size)sizeof(limitless_limb);
+  if (a->used <= (limitless_size)LIMITLESS_INLINE_LIMBS) {
+    mem = a->limbs;
+    limitless__mem_zero(a->inline_limbs, (limitless_size)sizeof(a->inline_limbs));
+    limitless__mem_copy(a->inline_limbs, mem, a->used * (limitless_size)sizeof(limitless_limb));
+    a->limbs = NULL;
+    a->cap = 0;
+    limitless__free_bytes(ctx, mem, old_bytes);
+    return LIMITLESS_OK;
   }
+  mem = limitless__realloc_bytes(ctx, a->limbs, old_bytes, a->used * (limitless_size)sizeof(limitless_limb));
   if (!mem) return LIMITLESS_EOOM;
   a->limbs = (limitless_limb*)mem;
-  if (new_cap > a->cap) {
-    limitless__mem_zero(a->limbs + a->cap, (new_cap - a->cap) * (limitless_size)sizeof(limitless_limb));
-  }
-  a->cap = new_cap;
+  a->cap = a->used;
   return LIMITLESS_OK;
 }
 
@@ -395,19 +1193,32 @@ static void limitless__bigint_clear_raw(limitless_ctx* ctx, limitless_bigint* a)
   limitless__bigint_init_raw(a);
 }
 
+/* a temporary backed by n scratch limbs (or inline ones); it must never be reserved past n */
+static limitless_status limitless__scratch_bigint(limitless_ctx* ctx, limitless_bigint* t, limitless_size n) {
+  limitless__bigint_init_raw(t);
+  if (n <= (limitless_size)LIMITLESS_INLINE_LIMBS) return LIMITLESS_OK;
+  t->limbs = limitless__scratch_push(ctx, n);
+  if (!t->limbs) return LIMITLESS_EOOM;
+  t->cap = n;
+  return LIMITLESS_OK;
+}
+
+static void limitless__scratch_bigint_release(limitless_ctx* ctx, limitless_bigint* t) {
+  limitless__scratch_pop(ctx, t->limbs, t->cap);
+  limitless__bigint_init_raw(t);
+}
+
 static limitless_status limitless__bigint_copy(limitless_ctx* ctx, limitless_bigint* dst, const limitless_bigint* src) {
   limitless_status st;
   if (dst == src) return LIMITLESS_OK;
-  if (src->used > 0 && !src->limbs) return LIMITLESS_EINVAL;
   if (src->used == 0) {
     dst->used = 0;
     dst->sign = 0;
     return LIMITLESS_OK;
   }
-  st = limitless__bigint_reserve(ctx, dst, src->used);
+  st = limitless__bigint_reserve_exact(ctx, dst, src->used);
   if (st != LIMITLESS_OK) return st;
-  if (!dst->limbs) return LIMITLESS_EOOM;
-  limitless__mem_copy(dst->limbs, src->limbs, src->used * (limitless_size)sizeof(limitless_limb));
+  limitless__limbs_copy(LIMITLESS_BIGINT_LIMBS(dst), LIMITLESS_BIGINT_LIMBS(src), src->used);
   dst->used = src->used;
   dst->sign = src->sign;
   return LIMITLESS_OK;
@@ -424,13 +1235,12 @@ static int limitless__bigint_is_zero(const limitless_bigint* a) {
 }
 
 static int limitless__bigint_is_one(const limitless_bigint* a) {
-  return a->sign > 0 && a->used == 1 && a->limbs[0] == (limitless_limb)1;
+  return a->sign > 0 && a->used == 1 && LIMITLESS_BIGINT_LIMBS(a)[0] == (limitless_limb)1;
 }
 
 static limitless_size limitless__mag_used(const limitless_bigint* a) {
-  if (!a->limbs) return 0;
   limitless_size u = a->used;
-  while (u > 0 && a->limbs[u - 1] == (limitless_limb)0) {
+  while (u > 0 && LIMITLESS_BIGINT_LIMBS(a)[u - 1] == (limitless_limb)0) {
     --u;
   }
   return u;
@@ -439,18 +1249,9 @@ static limitless_size limitless__mag_used(const limitless_bigint* a) {
 static int limitless__mag_cmp(const limitless_bigint* a, const limitless_bigint* b) {
   limitless_size au = limitless__mag_used(a);
   limitless_size bu = limitless__mag_used(b);
-  limitless_size i;
   if (au < bu) return -1;
   if (au > bu) return 1;
-  i = au;
-  while (i > 0) {
-    limitless_limb la = a->limbs[i - 1];
-    limitless_limb lb = b->limbs[i - 1];
-    if (la < lb) return -1;
-    if (la > lb) return 1;
-    --i;
-  }
-  return 0;
+  return limitless__limbs_cmp(LIMITLESS_BIGINT_LIMBS(a), LIMITLESS_BIGINT_LIMBS(b), au);
 }
 
 static int limitless__bigint_cmp_signed(const limitless_bigint* a, const limitless_bigint* b) {
@@ -490,10 +1291,10 @@ static limitless_status limitless__bigint_set_u64(limitless_ctx* ctx, limitless_
     return LIMITLESS_OK;
   }
 #if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
-  a->limbs[0] = (limitless_limb)(v & 0xffffffffULL);
-  if (need > 1) a->limbs[1] = (limitless_limb)(v >> 32);
+  LIMITLESS_BIGINT_LIMBS(a)[0] = (limitless_limb)(v & 0xffffffffULL);
+  if (need > 1) LIMITLESS_BIGINT_LIMBS(a)[1] = (limitless_limb)(v >> 32);
 #else
-  a->limbs[0] = (limitless_limb)v;
+  LIMITLESS_BIGINT_LIMBS(a)[0] = (limitless_limb)v;
 #endif
   a->used = need;
   a->sign = 1;
@@ -523,81 +1324,40 @@ static limitless_status limitless__bigint_abs_copy(limitless_ctx* ctx, limitless
 }
 
 static limitless_status limitless__mag_add(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b) {
-  limitless_size i;
-  limitless_size max_used = (a->used > b->used) ? a->used : b->used;
+  limitless_size max_used;
+  limitless_limb carry;
   limitless_status st;
+  if (a->used < b->used) {
+    const limitless_bigint* t = a;
+    a = b;
+    b = t;
+  }
+  max_used = a->used;
   if (max_used == ~(limitless_size)0) return LIMITLESS_EOOM;
   st = limitless__bigint_reserve(ctx, out, max_used + 1);
-  limitless_dlimb carry = (limitless_dlimb)0;
   if (st != LIMITLESS_OK) return st;
-  for (i = 0; i < max_used; ++i) {
-    limitless_dlimb av = (i < a->used) ? (limitless_dlimb)a->limbs[i] : (limitless_dlimb)0;
-    limitless_dlimb bv = (i < b->used) ? (limitless_dlimb)b->limbs[i] : (limitless_dlimb)0;
-    limitless_dlimb sum = av + bv + carry;
-    out->limbs[i] = (limitless_limb)sum;
-#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
-    carry = sum >> 32;
-#else
-    carry = sum >> 64;
-#endif
-  }
-  if (carry != (limitless_dlimb)0) {
-    out->limbs[max_used] = (limitless_limb)carry;
-    out->used = max_used + 1;
-  } else {
-    out->used = max_used;
-  }
+  carry = limitless__span_add(ctx, LIMITLESS_BIGINT_LIMBS(out), LIMITLESS_BIGINT_LIMBS(a), max_used, LIMITLESS_BIGINT_LIMBS(b), b->used);
+  LIMITLESS_BIGINT_LIMBS(out)[max_used] = carry;
+  out->used = max_used + (limitless_size)carry;
   out->sign = (out->used == 0) ? 0 : 1;
   limitless__bigint_norm(out);
   return LIMITLESS_OK;
 }
 
-static void limitless__mag_sub_inplace(limitless_bigint* a, const limitless_bigint* b) {
-  limitless_size i;
-  limitless_dlimb borrow = (limitless_dlimb)0;
-  for (i = 0; i < a->used; ++i) {
-    limitless_dlimb av = (limitless_dlimb)a->limbs[i];
-    limitless_dlimb bv = (i < b->used) ? (limitless_dlimb)b->limbs[i] : (limitless_dlimb)0;
-    limitless_dlimb sub = bv + borrow;
-    if (av < sub) {
-#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
-      a->limbs[i] = (limitless_limb)((((limitless_dlimb)1ULL << 32) + av) - sub);
-#else
-      a->limbs[i] = (limitless_limb)((((limitless_dlimb)1) << 64) + av - sub);
-#endif
-      borrow = (limitless_dlimb)1;
-    } else {
-      a->limbs[i] = (limitless_limb)(av - sub);
-      borrow = (limitless_dlimb)0;
-    }
-  }
+static void limitless__mag_sub_inplace(const limitless_ctx* ctx, limitless_bigint* a, const limitless_bigint* b) {
+  limitless_size bn = (b->used < a->used) ? b->used : a->used;
+  limitless__span_sub(ctx, LIMITLESS_BIGINT_LIMBS(a), LIMITLESS_BIGINT_LIMBS(a), a->used, LIMITLESS_BIGINT_LIMBS(b), bn);
   limitless__bigint_norm(a);
   if (a->used > 0) a->sign = 1;
 }
 
 static limitless_status limitless__mag_sub(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b) {
   limitless_status st;
-  limitless_size i;
-  limitless_dlimb borrow = (limitless_dlimb)0;
+  limitless_size bn = (b->used < a->used) ? b->used : a->used;
   /* requires |a| >= |b| */
-  st = limitless__bigint_reserve(ctx, out, a->used);
+  st = limitless__bigint_reserve_exact(ctx, out, a->used);
   if (st != LIMITLESS_OK) return st;
-  for (i = 0; i < a->used; ++i) {
-    limitless_dlimb av = (limitless_dlimb)a->limbs[i];
-    limitless_dlimb bv = (i < b->used) ? (limitless_dlimb)b->limbs[i] : (limitless_dlimb)0;
-    limitless_dlimb sub = bv + borrow;
-    if (av < sub) {
-#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
-      out->limbs[i] = (limitless_limb)((((limitless_dlimb)1ULL << 32) + av) - sub);
-#else
-      out->limbs[i] = (limitless_limb)((((limitless_dlimb)1) << 64) + av - sub);
-#endif
-      borrow = (limitless_dlimb)1;
-    } else {
-      out->limbs[i] = (limitless_limb)(av - sub);
-      borrow = (limitless_dlimb)0;
-    }
-  }
+  limitless__span_sub(ctx, LIMITLESS_BIGINT_LIMBS(out), LIMITLESS_BIGINT_LIMBS(a), a->used, LIMITLESS_BIGINT_LIMBS(b), bn);
   out->used = a->used;
   out->sign = (out->used == 0) ? 0 : 1;
   limitless__bigint_norm(out);
@@ -627,12 +1387,12 @@ static limitless_status limitless__bigint_shl_bits(limitless_ctx* ctx, limitless
   }
   limb_shift = bits / (limitless_size)LIMITLESS_LIMB_BITS;
   bit_shift = bits % (limitless_size)LIMITLESS_LIMB_BITS;
-  st = limitless__bigint_reserve(ctx, out, a->used + limb_shift + 1);
+  st = limitless__bigint_reserve_exact(ctx, out, a->used + limb_shift + 1);
   if (st != LIMITLESS_OK) return st;
-  for (i = 0; i < limb_shift; ++i) out->limbs[i] = (limitless_limb)0;
+  limitless__limbs_zero(LIMITLESS_BIGINT_LIMBS(out), limb_shift);
   for (i = 0; i < a->used; ++i) {
-    limitless_dlimb cur = ((limitless_dlimb)a->limbs[i] << bit_shift) | carry;
-    out->limbs[i + limb_shift] = (limitless_limb)cur;
+    limitless_dlimb cur = ((limitless_dlimb)LIMITLESS_BIGINT_LIMBS(a)[i] << bit_shift) | carry;
+    LIMITLESS_BIGINT_LIMBS(out)[i + limb_shift] = (limitless_limb)cur;
 #if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
     carry = (bit_shift == 0) ? (limitless_dlimb)0 : (cur >> 32);
 #else
@@ -641,7 +1401,7 @@ static limitless_status limitless__bigint_shl_bits(limitless_ctx* ctx, limitless
   }
   out->used = a->used + limb_shift;
   if (carry != (limitless_dlimb)0) {
-    out->limbs[out->used] = (limitless_limb)carry;
+    LIMITLESS_BIGINT_LIMBS(out)[out->used] = (limitless_limb)carry;
     ++out->used;
   }
   out->sign = a->sign;
@@ -653,8 +1413,8 @@ static void limitless__bigint_shr1_inplace(limitless_bigint* a) {
   limitless_size i = a->used;
   limitless_limb carry = (limitless_limb)0;
   while (i > 0) {
-    limitless_limb cur = a->limbs[i - 1];
-    a->limbs[i - 1] = (limitless_limb)((cur >> 1) | (carry << (LIMITLESS_LIMB_BITS - 1)));
+    limitless_limb cur = LIMITLESS_BIGINT_LIMBS(a)[i - 1];
+    LIMITLESS_BIGINT_LIMBS(a)[i - 1] = (limitless_limb)((cur >> 1) | (carry << (LIMITLESS_LIMB_BITS - 1)));
     carry = (limitless_limb)(cur & (limitless_limb)1);
     --i;
   }
@@ -675,7 +1435,7 @@ static void limitless__bigint_shr_bits_inplace(limitless_bigint* a, limitless_si
   }
   if (limb_shift > 0) {
     for (i = 0; i + limb_shift < a->used; ++i) {
-      a->limbs[i] = a->limbs[i + limb_shift];
+      LIMITLESS_BIGINT_LIMBS(a)[i] = LIMITLESS_BIGINT_LIMBS(a)[i + limb_shift];
     }
     a->used -= limb_shift;
   }
@@ -683,8 +1443,8 @@ static void limitless__bigint_shr_bits_inplace(limitless_bigint* a, limitless_si
     limitless_limb carry = (limitless_limb)0;
     i = a->used;
     while (i > 0) {
-      limitless_limb cur = a->limbs[i - 1];
-      a->limbs[i - 1] = (limitless_limb)((cur >> bit_shift) | (carry << (LIMITLESS_LIMB_BITS - bit_shift)));
+      limitless_limb cur = LIMITLESS_BIGINT_LIMBS(a)[i - 1];
+      LIMITLESS_BIGINT_LIMBS(a)[i - 1] = (limitless_limb)((cur >> bit_shift) | (carry << (LIMITLESS_LIMB_BITS - bit_shift)));
       carry = cur & (limitless_limb)((((limitless_limb)1) << bit_shift) - 1);
       --i;
     }
@@ -696,44 +1456,11 @@ static limitless_size limitless__bigint_bit_length(const limitless_bigint* a) {
   limitless_limb top;
   limitless_u32 lz;
   if (a->used == 0) return 0;
-  top = a->limbs[a->used - 1];
-#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
-  lz = limitless__clz_u32((limitless_u32)top);
-#else
-  lz = limitless__clz_u64((limitless_u64)top);
-#endif
+  top = LIMITLESS_BIGINT_LIMBS(a)[a->used - 1];
+  lz = limitless__limb_clz(top);
   return (a->used - 1) * (limitless_size)LIMITLESS_LIMB_BITS + ((limitless_size)LIMITLESS_LIMB_BITS - (limitless_size)lz);
 }
 
-static limitless_size limitless__bigint_ctz_bits(const limitless_bigint* a) {
-  limitless_size i = 0;
-  limitless_size z = 0;
-  while (i < a->used && a->limbs[i] == (limitless_limb)0) {
-    z += (limitless_size)LIMITLESS_LIMB_BITS;
-    ++i;
-  }
-  if (i == a->used) return z;
-#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
-  z += (limitless_size)limitless__ctz_u32((limitless_u32)a->limbs[i]);
-#else
-  z += (limitless_size)limitless__ctz_u64((limitless_u64)a->limbs[i]);
-#endif
-  return z;
-}
-
-static limitless_status limitless__bigint_set_bit(limitless_ctx* ctx, limitless_bigint* a, limitless_size bit) {
-  limitless_size limb = bit / (limitless_size)LIMITLESS_LIMB_BITS;
-  limitless_size off = bit % (limitless_size)LIMITLESS_LIMB_BITS;
-  limitless_status st = limitless__bigint_reserve(ctx, a, limb + 1);
-  if (st != LIMITLESS_OK) return st;
-  while (a->used <= limb) {
-    a->limbs[a->used++] = (limitless_limb)0;
-  }
-  a->limbs[limb] |= (limitless_limb)(((limitless_limb)1) << off);
-  a->sign = (a->used == 0) ? 0 : 1;
-  return LIMITLESS_OK;
-}
-
 static limitless_status limitless__bigint_mul_small_inplace(limitless_ctx* ctx, limitless_bigint* a, limitless_u32 m) {
   limitless_size i;
   limitless_dlimb carry = (limitless_dlimb)0;
@@ -747,8 +1474,8 @@ static limitless_status limitless__bigint_mul_small_inplace(limitless_ctx* ctx,
   st = limitless__bigint_reserve(ctx, a, a->used + 1);
   if (st != LIMITLESS_OK) return st;
   for (i = 0; i < a->used; ++i) {
-    limitless_dlimb prod = ((limitless_dlimb)a->limbs[i] * (limitless_dlimb)m) + carry;
-    a->limbs[i] = (limitless_limb)prod;
+    limitless_dlimb prod = ((limitless_dlimb)LIMITLESS_BIGINT_LIMBS(a)[i] * (limitless_dlimb)m) + carry;
+    LIMITLESS_BIGINT_LIMBS(a)[i] = (limitless_limb)prod;
 #if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
     carry = prod >> 32;
 #else
@@ -756,7 +1483,7 @@ static limitless_status limitless__bigint_mul_small_inplace(limitless_ctx* ctx,
 #endif
   }
   if (carry != (limitless_dlimb)0) {
-    a->limbs[a->used++] = (limitless_limb)carry;
+    LIMITLESS_BIGINT_LIMBS(a)[a->used++] = (limitless_limb)carry;
   }
   if (a->used > 0 && a->sign == 0) a->sign = 1;
   return LIMITLESS_OK;
@@ -775,8 +1502,8 @@ static limitless_status limitless__bigint_add_small_inplace(limitless_ctx* ctx,
   carry = (limitless_dlimb)v;
   i = 0;
   while (carry != (limitless_dlimb)0 && i < a->used) {
-    limitless_dlimb sum = (limitless_dlimb)a->limbs[i] + carry;
-    a->limbs[i] = (limitless_limb)sum;
+    limitless_dlimb sum = (limitless_dlimb)LIMITLESS_BIGINT_LIMBS(a)[i] + carry;
+    LIMITLESS_BIGINT_LIMBS(a)[i] = (limitless_limb)sum;
 #if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
     carry = sum >> 32;
 #else
@@ -785,26 +1512,86 @@ static limitless_status limitless__bigint_add_small_inplace(limitless_ctx* ctx,
     ++i;
   }
   if (carry != (limitless_dlimb)0) {
-    a->limbs[a->used++] = (limitless_limb)carry;
+    LIMITLESS_BIGINT_LIMBS(a)[a->used++] = (limitless_limb)carry;
   }
   if (a->used > 0 && a->sign == 0) a->sign = 1;
   return LIMITLESS_OK;
 }
 
-static limitless_u32 limitless__bigint_divmod_small_inplace(limitless_bigint* a, limitless_u32 base) {
-  limitless_size i = a->used;
-  limitless_dlimb rem = (limitless_dlimb)0;
+
+/*
+Single-limb divisor with a precomputed reciprocal (Moller and Granlund,
+"Improved division by invariant integers", 2011). d is stored shifted left
+until its top bit is set and v = floor((B^2 - 1) / d) - B, so each 2/1 step
+costs one widening multiply and at most two corrections instead of a
+hardware double-limb divide (a __udivti3 call with 64-bit limbs).
+*/
+typedef struct limitless__divisor {
+  limitless_limb d;
+  limitless_limb v;
+  limitless_u32 shift;
+} limitless__divisor;
+
+static void limitless__divisor_init(limitless__divisor* dv, limitless_limb d) {
+  limitless_limb n;
+  dv->shift = limitless__limb_clz(d);
+  n = (limitless_limb)(d << dv->shift);
+  dv->d = n;
+  dv->v = (limitless_limb)((((limitless_dlimb)(limitless_limb)~n << LIMITLESS_LIMB_BITS) | (limitless_dlimb)(limitless_limb)~(limitless_limb)0) / n);
+}
+
+/* (u1 * B + u0) / d for normalized d and u1 < d; the remainder goes to *r */
+static limitless_limb limitless__divisor_step(const limitless__divisor* dv, limitless_limb u1, limitless_limb u0, limitless_limb* r) {
+  limitless_dlimb p = (limitless_dlimb)dv->v * u1 + (((limitless_dlimb)(limitless_limb)(u1 + 1u) << LIMITLESS_LIMB_BITS) | (limitless_dlimb)u0);
+  limitless_limb q1 = (limitless_limb)(p >> LIMITLESS_LIMB_BITS);
+  limitless_limb q0 = (limitless_limb)p;
+  limitless_limb rem = (limitless_limb)(u0 - (limitless_limb)(q1 * dv->d));
+  if (rem > q0) {
+    --q1;
+    rem = (limitless_limb)(rem + dv->d);
+  }
+  if (rem >= dv->d) {
+    ++q1;
+    rem = (limitless_limb)(rem - dv->d);
+  }
+  *r = rem;
+  return q1;
+}
+
+/* q[0, n) = a / d, returns a % d; q may alias a, and q == NULL computes only the remainder */
+static limitless_limb limitless__span_divrem_1(limitless_limb* q, const limitless_limb* a, limitless_size n, const limitless__divisor* dv) {
+  limitless_u32 s = dv->shift;
+  limitless_limb r = (limitless_limb)0;
+  limitless_size i = n;
+  if (n == 0) return r;
+  if (s == 0u) {
+    while (i > 0) {
+      limitless_limb qi;
+      --i;
+      qi = limitless__divisor_step(dv, r, a[i], &r);
+      if (q) q[i] = qi;
+    }
+    return r;
+  }
+  /* shift the dividend by the same amount on the fly; the top bits seed the remainder */
+  r = (limitless_limb)(a[n - 1] >> (LIMITLESS_LIMB_BITS - s));
   while (i > 0) {
-    limitless_dlimb cur;
-#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
-    cur = (rem << 32) | (limitless_dlimb)a->limbs[i - 1];
-#else
-    cur = (rem << 64) | (limitless_dlimb)a->limbs[i - 1];
-#endif
-    a->limbs[i - 1] = (limitless_limb)(cur / (limitless_dlimb)base);
-    rem = cur % (limitless_dlimb)base;
+    limitless_limb u0;
+    limitless_limb qi;
     --i;
+    u0 = (limitless_limb)(a[i] << s);
+    if (i > 0) u0 |= (limitless_limb)(a[i - 1] >> (LIMITLESS_LIMB_BITS - s));
+    qi = limitless__divisor_step(dv, r, u0, &r);
+    if (q) q[i] = qi;
   }
+  return (limitless_limb)(r >> s);
+}
+
+static limitless_u32 limitless__bigint_divmod_small_inplace(limitless_bigint* a, limitless_u32 base) {
+  limitless__divisor dv;
+  limitless_limb rem;
+  limitless__divisor_init(&dv, (limitless_limb)base);
+  rem = limitless__span_divrem_1(LIMITLESS_BIGINT_LIMBS(a), LIMITLESS_BIGINT_LIMBS(a), a->used, &dv);
   limitless__bigint_norm(a);
   return (limitless_u32)rem;
 }
@@ -821,43 +1608,99 @@ static limitless_status limitless__bigint_slice(limitless_ctx* ctx, limitless_bi
   }
   if (end > a->used) end = a->used;
   actual = end - start;
-  st = limitless__bigint_reserve(ctx, out, actual);
+  st = limitless__bigint_reserve_exact(ctx, out, actual);
   if (st != LIMITLESS_OK) return st;
-  for (i = 0; i < actual; ++i) out->limbs[i] = a->limbs[start + i];
+  if (out != a) limitless__limbs_copy(LIMITLESS_BIGINT_LIMBS(out), LIMITLESS_BIGINT_LIMBS(a) + start, actual);
+  else for (i = 0; i < actual; ++i) LIMITLESS_BIGINT_LIMBS(out)[i] = LIMITLESS_BIGINT_LIMBS(a)[start + i];
   out->used = actual;
   out->sign = (actual == 0) ? 0 : 1;
   limitless__bigint_norm(out);
   return LIMITLESS_OK;
 }
 
-static limitless_status limitless__mag_mul_schoolbook(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b) {
+static void limitless__span_mul_basecase(const limitless_ctx* ctx, limitless_limb* r, const limitless_limb* a, limitless_size an, const limitless_limb* b, limitless_size bn) {
   limitless_size i;
-  limitless_size j;
+  if (an > bn) {
+    /* the kernels run along b, so make b the longer operand */
+    const limitless_limb* t = a;
+    limitless_size tn = an;
+    a = b;
+    an = bn;
+    b = t;
+    bn = tn;
+  }
+  if (an == 0) {
+    limitless__limbs_zero(r, bn);
+    return;
+  }
+  r[bn] = ctx->kernels.mul_1(r, b, bn, a[0]);
+  for (i = 1; i < an; ++i) r[i + bn] = ctx->kernels.addmul_1(r + i, b, bn, a[i]);
+}
+
+/* cross products a[i] * a[j] (i < j) are computed once and doubled, then the diagonal squares are added */
+static void limitless__span_sqr_basecase(const limitless_ctx* ctx, limitless_limb* r, const limitless_limb* a, limitless_size n) {
+  limitless_size i;
+  limitless_limb top = (limitless_limb)0;
+  limitless_dlimb carry;
+  limitless__limbs_zero(r, n * 2);
+  for (i = 0; i + 1 < n; ++i) r[i + n] = ctx->kernels.addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+  for (i = 0; i < n * 2; ++i) {
+    limitless_limb cur = r[i];
+    r[i] = (limitless_limb)((cur << 1) | top);
+    top = (limitless_limb)(cur >> (LIMITLESS_LIMB_BITS - 1));
+  }
+  carry = (limitless_dlimb)0;
+  for (i = 0; i < n; ++i) {
+    limitless_dlimb sq = (limitless_dlimb)a[i] * (limitless_dlimb)a[i];
+    limitless_dlimb cur;
+#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
+    cur = (limitless_dlimb)r[2 * i] + (sq & 0xffffffffu) + carry;
+    r[2 * i] = (limitless_limb)cur;
+    cur = (limitless_dlimb)r[2 * i + 1] + (sq >> 32) + (cur >> 32);
+    r[2 * i + 1] = (limitless_limb)cur;
+    carry = cur >> 32;
+#else
+    cur = (limitless_dlimb)r[2 * i] + (limitless_dlimb)(limitless_limb)sq + carry;
+    r[2 * i] = (limitless_limb)cur;
+    cur = (limitless_dlimb)r[2 * i + 1] + (sq >> 64) + (cur >> 64);
+    r[2 * i + 1] = (limitless_limb)cur;
+    carry = cur >> 64;
+#endif
+  }
+}
+
+static limitless_size limitless__span_trim(const limitless_limb* a, limitless_size n) {
+  while (n > 0 && a[n - 1] == (limitless_limb)0) --n;
+  return n;
+}
+
+static limitless_status limitless__mag_mul_schoolbook(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b) {
   limitless_status st;
-  limitless_size need;
   if (a->used == 0 || b->used == 0) {
     out->used = 0;
     out->sign = 0;
     return LIMITLESS_OK;
   }
-  need = a->used + b->used;
-  st = limitless__bigint_reserve(ctx, out, need);
+  st = limitless__bigint_reserve_exact(ctx, out, a->used + b->used);
   if (st != LIMITLESS_OK) return st;
-  for (i = 0; i < need; ++i) out->limbs[i] = (limitless_limb)0;
-  for (i = 0; i < a->used; ++i) {
-    limitless_dlimb carry = (limitless_dlimb)0;
-    for (j = 0; j < b->used; ++j) {
-      limitless_dlimb cur = (limitless_dlimb)out->limbs[i + j] + (limitless_dlimb)a->limbs[i] * (limitless_dlimb)b->limbs[j] + carry;
-      out->limbs[i + j] = (limitless_limb)cur;
-#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
-      carry = cur >> 32;
-#else
-      carry = cur >> 64;
-#endif
-    }
-    out->limbs[i + b->used] = (limitless_limb)((limitless_dlimb)out->limbs[i + b->used] + carry);
+  limitless__span_mul_basecase(ctx, LIMITLESS_BIGINT_LIMBS(out), LIMITLESS_BIGINT_LIMBS(a), a->used, LIMITLESS_BIGINT_LIMBS(b), b->used);
+  out->used = a->used + b->used;
+  out->sign = 1;
+  limitless__bigint_norm(out);
+  return LIMITLESS_OK;
+}
+
+static limitless_status limitless__mag_sqr_schoolbook(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a) {
+  limitless_status st;
+  if (a->used == 0) {
+    out->used = 0;
+    out->sign = 0;
+    return LIMITLESS_OK;
   }
-  out->used = need;
+  st = limitless__bigint_reserve_exact(ctx, out, a->used * 2);
+  if (st != LIMITLESS_OK) return st;
+  limitless__span_sqr_basecase(ctx, LIMITLESS_BIGINT_LIMBS(out), LIMITLESS_BIGINT_LIMBS(a), a->used);
+  out->used = a->used * 2;
   out->sign = 1;
   limitless__bigint_norm(out);
   return LIMITLESS_OK;
@@ -866,132 +1709,221 @@ static limitless_status limitless__mag_mul_schoolbook(limitless_ctx* ctx, limitl
 static limitless_status limitless__mag_add_shifted(limitless_ctx* ctx, limitless_bigint* acc, const limitless_bigint* term, limitless_size limb_shift) {
   limitless_size i;
   limitless_size need;
-  limitless_dlimb carry = (limitless_dlimb)0;
+  limitless_limb carry;
   limitless_status st;
   if (term->used == 0) return LIMITLESS_OK;
   need = (acc->used > term->used + limb_shift) ? acc->used : (term->used + limb_shift);
   st = limitless__bigint_reserve(ctx, acc, need + 1);
   if (st != LIMITLESS_OK) return st;
-  if (acc->used < need) {
-    for (i = acc->used; i < need; ++i) acc->limbs[i] = (limitless_limb)0;
-    acc->used = need;
-  }
-  for (i = 0; i < term->used; ++i) {
-    limitless_size idx = i + limb_shift;
-    limitless_dlimb sum = (limitless_dlimb)acc->limbs[idx] + (limitless_dlimb)term->limbs[i] + carry;
-    acc->limbs[idx] = (limitless_limb)sum;
-#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
-    carry = sum >> 32;
-#else
-    carry = sum >> 64;
-#endif
-    if (carry == (limitless_dlimb)0) {
-      while (++i < term->used) {
-        idx = i + limb_shift;
-        sum = (limitless_dlimb)acc->limbs[idx] + (limitless_dlimb)term->limbs[i];
-        acc->limbs[idx] = (limitless_limb)sum;
-#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
-        carry = sum >> 32;
-#else
-        carry = sum >> 64;
-#endif
-        if (carry != (limitless_dlimb)0) break;
-      }
-      break;
-    }
-  }
-  if (carry != (limitless_dlimb)0) {
-    limitless_size idx = term->used + limb_shift;
-    while (carry != (limitless_dlimb)0) {
-      limitless_dlimb sum = (limitless_dlimb)acc->limbs[idx] + carry;
-      acc->limbs[idx] = (limitless_limb)sum;
-#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
-      carry = sum >> 32;
-#else
-      carry = sum >> 64;
-#endif
-      ++idx;
-      if (idx > acc->used) {
-        acc->used = idx;
-      }
-      if (idx == acc->cap) {
-        st = limitless__bigint_reserve(ctx, acc, acc->cap + 1);
-        if (st != LIMITLESS_OK) return st;
-      }
-    }
-  }
+  for (i = acc->used; i < need; ++i) LIMITLESS_BIGINT_LIMBS(acc)[i] = (limitless_limb)0;
+  /* acc and term both fit below need limbs, so the carry stops at need at the latest */
+  carry = limitless__span_add(ctx, LIMITLESS_BIGINT_LIMBS(acc) + limb_shift, LIMITLESS_BIGINT_LIMBS(acc) + limb_shift, need - limb_shift, LIMITLESS_BIGINT_LIMBS(term), term->used);
+  LIMITLESS_BIGINT_LIMBS(acc)[need] = carry;
+  acc->used = need + (limitless_size)carry;
   limitless__bigint_norm(acc);
   if (acc->used > 0) acc->sign = 1;
   return LIMITLESS_OK;
 }
 
-static limitless_status limitless__mag_mul_karatsuba(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b, limitless_size threshold);
+static limitless_status limitless__mag_mul_karatsuba(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b);
+static limitless_status limitless__mag_mul_toom3(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b);
+static limitless_status limitless__mag_mul_unbalanced(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b);
+static limitless_status limitless__mag_mul_ntt(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b);
+static int limitless__ntt_fits(const limitless_bigint* a, const limitless_bigint* b);
 
-static limitless_status limitless__mag_mul(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b, limitless_size threshold) {
+static limitless_status limitless__mag_mul(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b) {
   limitless_size maxu = (a->used > b->used) ? a->used : b->used;
   limitless_size minu = (a->used < b->used) ? a->used : b->used;
-  if (maxu < threshold || minu < 2) {
+  /* a == b selects the squaring variant of each tier */
+  if (maxu < ctx->karatsuba_threshold || minu < 2) {
+    if (a == b) return limitless__mag_sqr_schoolbook(ctx, out, a);
     return limitless__mag_mul_schoolbook(ctx, out, a, b);
   }
-  return limitless__mag_mul_karatsuba(ctx, out, a, b, threshold);
+  if (minu >= ctx->ntt_threshold && limitless__ntt_fits(a, b)) {
+    return limitless__mag_mul_ntt(ctx, out, a, b);
+  }
+  /* toom-3 only pays off when all three pieces of both operands are non-empty */
+  if (maxu >= ctx->toom3_threshold && minu > 2 * ((maxu + 2) / 3)) {
+    return limitless__mag_mul_toom3(ctx, out, a, b);
+  }
+  if (minu >= ctx->toom3_threshold && maxu >= 2 * minu) {
+    return limitless__mag_mul_unbalanced(ctx, out, a, b);
+  }
+  return limitless__mag_mul_karatsuba(ctx, out, a, b);
 }
 
-static limitless_status limitless__mag_mul_karatsuba(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b, limitless_size threshold) {
-  limitless_status st;
-  limitless_size n = (a->used > b->used) ? a->used : b->used;
-  limitless_size m;
-  limitless_bigint a0, a1, b0, b1, z0, z1, z2, s1, s2, p, tmp;
-
-  if (n < threshold || a->used < 2 || b->used < 2) {
-    return limitless__mag_mul_schoolbook(ctx, out, a, b);
+/*
+Multiplies a long operand by a short one of at least toom-3 size by cutting the
+long side into blocks of the short length, so every block product is balanced
+and takes the fast tier. Shorter operands are blocked inside the karatsuba
+span kernel instead.
+*/
+static limitless_status limitless__mag_mul_unbalanced(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b) {
+  limitless_status st = LIMITLESS_OK;
+  const limitless_bigint* lng = (a->used >= b->used) ? a : b;
+  const limitless_bigint* sht = (a->used >= b->used) ? b : a;
+  limitless_size bs = sht->used;
+  limitless_size off;
+  limitless_bigint block, prod, acc;
+
+  limitless__bigint_init_raw(&block);
+  limitless__bigint_init_raw(&prod);
+  limitless__bigint_init_raw(&acc);
+  st = limitless__bigint_reserve(ctx, &acc, lng->used + bs + 1);
+  if (st != LIMITLESS_OK) goto cleanup;
+  for (off = 0; off < lng->used; off += bs) {
+    st = limitless__bigint_slice(ctx, &block, lng, off, bs); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__mag_mul(ctx, &prod, &block, sht); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__mag_add_shifted(ctx, &acc, &prod, off); if (st != LIMITLESS_OK) goto cleanup;
   }
+  limitless__bigint_swap(out, &acc);
 
-  m = n / 2;
-  limitless__bigint_init_raw(&a0); limitless__bigint_init_raw(&a1);
-  limitless__bigint_init_raw(&b0); limitless__bigint_init_raw(&b1);
-  limitless__bigint_init_raw(&z0); limitless__bigint_init_raw(&z1); limitless__bigint_init_raw(&z2);
-  limitless__bigint_init_raw(&s1); limitless__bigint_init_raw(&s2); limitless__bigint_init_raw(&p);
-  limitless__bigint_init_raw(&tmp);
+cleanup:
+  limitless__bigint_clear_raw(ctx, &block);
+  limitless__bigint_clear_raw(ctx, &prod);
+  limitless__bigint_clear_raw(ctx, &acc);
+  return st;
+}
 
-  st = limitless__bigint_slice(ctx, &a0, a, 0, m); if (st != LIMITLESS_OK) goto cleanup;
-  st = limitless__bigint_slice(ctx, &a1, a, m, n - m); if (st != LIMITLESS_OK) goto cleanup;
-  st = limitless__bigint_slice(ctx, &b0, b, 0, m); if (st != LIMITLESS_OK) goto cleanup;
-  st = limitless__bigint_slice(ctx, &b1, b, m, n - m); if (st != LIMITLESS_OK) goto cleanup;
+/*
+Karatsuba on limb spans. Each level splits at m = ceil(an / 2) and needs
+4 * (m + 1) scratch limbs for the two half sums and their product; the
+recursion reuses the rest of the scratch area, so one allocation of
+limitless__kara_scratch(an) limbs serves the whole multiply. Spans below
+four limbs always use the basecase so the half sums keep shrinking.
+*/
+static int limitless__kara_basecase(const limitless_ctx* ctx, limitless_size n) {
+  return n < ctx->karatsuba_threshold || n < 4;
+}
 
-  st = limitless__mag_mul(ctx, &z0, &a0, &b0, threshold); if (st != LIMITLESS_OK) goto cleanup;
-  st = limitless__mag_mul(ctx, &z2, &a1, &b1, threshold); if (st != LIMITLESS_OK) goto cleanup;
+static limitless_size limitless__kara_scratch(const limitless_ctx* ctx, limitless_size n) {
+  limitless_size total = 0;
+  while (!limitless__kara_basecase(ctx, n)) {
+    limitless_size m = (n + 1) / 2;
+    total += 4 * (m + 1);
+    n = m + 1;
+  }
+  return total;
+}
 
-  st = limitless__mag_add(ctx, &s1, &a0, &a1); if (st != LIMITLESS_OK) goto cleanup;
-  st = limitless__mag_add(ctx, &s2, &b0, &b1); if (st != LIMITLESS_OK) goto cleanup;
-  st = limitless__mag_mul(ctx, &p, &s1, &s2, threshold); if (st != LIMITLESS_OK) goto cleanup;
+/* r[0, 2n) = a^2 */
+static void limitless__kara_sqr_span(const limitless_ctx* ctx, limitless_limb* r, const limitless_limb* a, limitless_size n, limitless_limb* scratch) {
+  limitless_size m;
+  limitless_size sn;
+  limitless_size pn;
+  limitless_limb* s;
+  limitless_limb* p;
+  if (limitless__kara_basecase(ctx, n)) {
+    limitless__span_sqr_basecase(ctx, r, a, n);
+    return;
+  }
+  m = (n + 1) / 2;
+  s = scratch;
+  p = scratch + 2 * (m + 1);
+  limitless__kara_sqr_span(ctx, r, a, m, scratch);
+  limitless__kara_sqr_span(ctx, r + 2 * m, a + m, n - m, scratch);
+  s[m] = limitless__span_add(ctx, s, a, m, a + m, n - m);
+  sn = limitless__span_trim(s, m + 1);
+  limitless__kara_sqr_span(ctx, p, s, sn, scratch + 4 * (m + 1));
+  /* middle term: (a0 + a1)^2 - a0^2 - a1^2 */
+  pn = limitless__span_trim(p, sn * 2);
+  limitless__span_sub(ctx, p, p, pn, r, limitless__span_trim(r, 2 * m));
+  limitless__span_sub(ctx, p, p, pn, r + 2 * m, limitless__span_trim(r + 2 * m, 2 * (n - m)));
+  pn = limitless__span_trim(p, pn);
+  (void)limitless__span_add(ctx, r + m, r + m, 2 * n - m, p, pn);
+}
 
-  st = limitless__mag_sub(ctx, &tmp, &p, &z0); if (st != LIMITLESS_OK) goto cleanup;
-  st = limitless__mag_sub(ctx, &z1, &tmp, &z2); if (st != LIMITLESS_OK) goto cleanup;
+/* r[0, an + bn) = a * b for an >= bn */
+static void limitless__kara_mul_span(const limitless_ctx* ctx, limitless_limb* r, const limitless_limb* a, limitless_size an, const limitless_limb* b, limitless_size bn, limitless_limb* scratch) {
+  limitless_size m;
+  limitless_size s1n;
+  limitless_size s2n;
+  limitless_size pn;
+  limitless_limb* s1;
+  limitless_limb* s2;
+  limitless_limb* p;
+  if (limitless__kara_basecase(ctx, bn) || limitless__kara_basecase(ctx, an)) {
+    limitless__span_mul_basecase(ctx, r, a, an, b, bn);
+    return;
+  }
+  m = (an + 1) / 2;
+  if (bn <= m) {
+    /*
+    Unbalanced: cut a into bn-limb blocks so every product is balanced.
+    Block products go through 2 * bn scratch limbs, below the 4 * (m + 1)
+    reserved for this level.
+    */
+    limitless_size off;
+    limitless__kara_mul_span(ctx, r, a, bn, b, bn, scratch);
+    for (off = bn; off < an; off += bn) {
+      limitless_size blen = (an - off < bn) ? (an - off) : bn;
+      limitless__kara_mul_span(ctx, scratch, b, bn, a + off, blen, scratch + 2 * bn);
+      limitless__limbs_zero(r + off + bn, blen);
+      (void)limitless__span_add(ctx, r + off, r + off, blen + bn, scratch, blen + bn);
+    }
+    return;
+  }
+  s1 = scratch;
+  s2 = scratch + (m + 1);
+  p = scratch + 2 * (m + 1);
+  limitless__kara_mul_span(ctx, r, a, m, b, m, scratch);
+  limitless__kara_mul_span(ctx, r + 2 * m, a + m, an - m, b + m, bn - m, scratch);
+  s1[m] = limitless__span_add(ctx, s1, a, m, a + m, an - m);
+  s2[m] = limitless__span_add(ctx, s2, b, m, b + m, bn - m);
+  s1n = limitless__span_trim(s1, m + 1);
+  s2n = limitless__span_trim(s2, m + 1);
+  if (s1n >= s2n) limitless__kara_mul_span(ctx, p, s1, s1n, s2, s2n, scratch + 4 * (m + 1));
+  else limitless__kara_mul_span(ctx, p, s2, s2n, s1, s1n, scratch + 4 * (m + 1));
+  /* middle term: (a0 + a1)(b0 + b1) - a0 b0 - a1 b1 */
+  pn = limitless__span_trim(p, s1n + s2n);
+  limitless__span_sub(ctx, p, p, pn, r, limitless__span_trim(r, 2 * m));
+  limitless__span_sub(ctx, p, p, pn, r + 2 * m, limitless__span_trim(r + 2 * m, an + bn - 2 * m));
+  pn = limitless__span_trim(p, pn);
+  (void)limitless__span_add(ctx, r + m, r + m, an + bn - m, p, pn);
+}
 
-  out->used = 0;
-  out->sign = 0;
-  st = limitless__mag_add_shifted(ctx, out, &z0, 0); if (st != LIMITLESS_OK) goto cleanup;
-  st = limitless__mag_add_shifted(ctx, out, &z1, m); if (st != LIMITLESS_OK) goto cleanup;
-  st = limitless__mag_add_shifted(ctx, out, &z2, m * 2); if (st != LIMITLESS_OK) goto cleanup;
-  out->sign = (out->used == 0) ? 0 : 1;
+static limitless_status limitless__mag_mul_karatsuba(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b) {
+  limitless_status st;
+  limitless_size need = a->used + b->used;
+  limitless_size an = (a->used >= b->used) ? a->used : b->used;
+  limitless_size scratch_limbs = limitless__kara_scratch(ctx, an);
+  limitless_limb* scratch = NULL;
 
-cleanup:
-  limitless__bigint_clear_raw(ctx, &a0); limitless__bigint_clear_raw(ctx, &a1);
-  limitless__bigint_clear_raw(ctx, &b0); limitless__bigint_clear_raw(ctx, &b1);
-  limitless__bigint_clear_raw(ctx, &z0); limitless__bigint_clear_raw(ctx, &z1); limitless__bigint_clear_raw(ctx, &z2);
-  limitless__bigint_clear_raw(ctx, &s1); limitless__bigint_clear_raw(ctx, &s2); limitless__bigint_clear_raw(ctx, &p);
-  limitless__bigint_clear_raw(ctx, &tmp);
-  return st;
+  if (a->used == 0 || b->used == 0) {
+    out->used = 0;
+    out->sign = 0;
+    return LIMITLESS_OK;
+  }
+  if (scratch_limbs > 0) {
+    scratch = limitless__scratch_push(ctx, scratch_limbs);
+    if (!scratch) return LIMITLESS_EOOM;
+  }
+  st = limitless__bigint_reserve_exact(ctx, out, need);
+  if (st != LIMITLESS_OK) {
+    limitless__scratch_pop(ctx, scratch, scratch_limbs);
+    return st;
+  }
+  if (a == b) limitless__kara_sqr_span(ctx, LIMITLESS_BIGINT_LIMBS(out), LIMITLESS_BIGINT_LIMBS(a), a->used, scratch);
+  else if (a->used >= b->used) limitless__kara_mul_span(ctx, LIMITLESS_BIGINT_LIMBS(out), LIMITLESS_BIGINT_LIMBS(a), a->used, LIMITLESS_BIGINT_LIMBS(b), b->used, scratch);
+  else limitless__kara_mul_span(ctx, LIMITLESS_BIGINT_LIMBS(out), LIMITLESS_BIGINT_LIMBS(b), b->used, LIMITLESS_BIGINT_LIMBS(a), a->used, scratch);
+  limitless__scratch_pop(ctx, scratch, scratch_limbs);
+  out->used = need;
+  out->sign = 1;
+  limitless__bigint_norm(out);
+  return LIMITLESS_OK;
 }
 
 static limitless_status limitless__bigint_add_signed(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b) {
   limitless_status st;
-  if (a->sign == 0) return limitless__bigint_copy(ctx, out, b);
-  if (b->sign == 0) return limitless__bigint_copy(ctx, out, a);
-  if (a->sign == b->sign) {
+  /* signs are captured up front because out may alias a or b */
+  int as = a->sign;
+  int bs = b->sign;
+  if (as == 0) return limitless__bigint_copy(ctx, out, b);
+  if (bs == 0) return limitless__bigint_copy(ctx, out, a);
+  if (as == bs) {
     st = limitless__mag_add(ctx, out, a, b);
     if (st != LIMITLESS_OK) return st;
-    out->sign = a->sign;
+    out->sign = as;
     return LIMITLESS_OK;
   }
   {
@@ -1004,11 +1936,11 @@ static limitless_status limitless__bigint_add_signed(limitless_ctx* ctx, limitle
     if (cmp > 0) {
       st = limitless__mag_sub(ctx, out, a, b);
       if (st != LIMITLESS_OK) return st;
-      out->sign = a->sign;
+      out->sign = as;
     } else {
       st = limitless__mag_sub(ctx, out, b, a);
       if (st != LIMITLESS_OK) return st;
-      out->sign = b->sign;
+      out->sign = bs;
     }
   }
   limitless__bigint_norm(out);
@@ -1018,15 +1950,21 @@ static limitless_status limitless__bigint_add_signed(limitless_ctx* ctx, limitle
 static limitless_status limitless__bigint_sub_signed(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b) {
   limitless_bigint nb;
   limitless_status st;
-  limitless__bigint_init_raw(&nb);
-  st = limitless__bigint_copy(ctx, &nb, b);
-  if (st != LIMITLESS_OK) {
-    limitless__bigint_clear_raw(ctx, &nb);
-    return st;
+  if (out != b) {
+    /* a sign-flipped view of b; out never reallocates b's limbs, so the view stays valid */
+    nb = *b;
+    nb.sign = -nb.sign;
+    return limitless__bigint_add_signed(ctx, out, a, &nb);
+  }
+  if (a == b) {
+    out->used = 0;
+    out->sign = 0;
+    return LIMITLESS_OK;
   }
-  nb.sign = -nb.sign;
-  st = limitless__bigint_add_signed(ctx, out, a, &nb);
-  limitless__bigint_clear_raw(ctx, &nb);
+  /* out is b: negate it in place; add_signed fails before writing, so undoing the flip restores b */
+  out->sign = -out->sign;
+  st = limitless__bigint_add_signed(ctx, out, a, out);
+  if (st != LIMITLESS_OK) out->sign = -out->sign;
   return st;
 }
 
@@ -1037,185 +1975,1718 @@ static limitless_status limitless__bigint_mul_signed(limitless_ctx* ctx, limitle
     out->sign = 0;
     return LIMITLESS_OK;
   }
-  st = limitless__mag_mul(ctx, out, a, b, ctx->karatsuba_threshold);
+  st = limitless__mag_mul(ctx, out, a, b);
   if (st != LIMITLESS_OK) return st;
   out->sign = (a->sign == b->sign) ? 1 : -1;
   limitless__bigint_norm(out);
   return LIMITLESS_OK;
 }
 
-static limitless_status limitless__bigint_divmod_abs(limitless_ctx* ctx, limitless_bigint* q, limitless_bigint* r, const limitless_bigint* a, const limitless_bigint* b) {
-  limitless_status st;
-  int cmp;
-  limitless_size abit;
-  limitless_size bbit;
-  limitless_size shift;
-  limitless_size i;
-  limitless_bigint rem, den;
-
-  if (b->used == 0) return LIMITLESS_EDIVZERO;
-
-  limitless__bigint_init_raw(&rem);
-  limitless__bigint_init_raw(&den);
-
-  st = limitless__bigint_abs_copy(ctx, &rem, a);
-  if (st != LIMITLESS_OK) goto cleanup;
-  st = limitless__bigint_abs_copy(ctx, &den, b);
-  if (st != LIMITLESS_OK) goto cleanup;
+static limitless_status limitless__bigint_sqr_signed(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a) {
+  /* passing the same operand twice routes every tier to its squaring variant */
+  return limitless__bigint_mul_signed(ctx, out, a, a);
+}
 
-  cmp = limitless__mag_cmp(&rem, &den);
-  if (cmp < 0) {
-    q->used = 0;
-    q->sign = 0;
-    st = limitless__bigint_copy(ctx, r, &rem);
-    if (st == LIMITLESS_OK) r->sign = (r->used == 0) ? 0 : 1;
-    goto cleanup;
-  }
-  if (cmp == 0) {
-    st = limitless__bigint_set_u64(ctx, q, 1);
-    if (st != LIMITLESS_OK) goto cleanup;
-    r->used = 0;
-    r->sign = 0;
-    goto cleanup;
+static limitless_status limitless__mag_mul_toom3(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b) {
+  limitless_status st;
+  limitless_size n = (a->used > b->used) ? a->used : b->used;
+  limitless_size k = (n + 2) / 3;
+  int sq = (a == b);
+  limitless_bigint a0, a1, a2, b0, b1, b2, sa, sb, ea, eb, r0, r1, rm1, rm2, rinf, t;
+  /* when squaring, the b-side evaluations alias the a-side ones so every point product is a square */
+  const limitless_bigint* pb0 = sq ? &a0 : &b0;
+  const limitless_bigint* pb2 = sq ? &a2 : &b2;
+  const limitless_bigint* peb = sq ? &ea : &eb;
+
+  limitless__bigint_init_raw(&a0); limitless__bigint_init_raw(&a1); limitless__bigint_init_raw(&a2);
+  limitless__bigint_init_raw(&b0); limitless__bigint_init_raw(&b1); limitless__bigint_init_raw(&b2);
+  limitless__bigint_init_raw(&sa); limitless__bigint_init_raw(&sb);
+  limitless__bigint_init_raw(&ea); limitless__bigint_init_raw(&eb);
+  limitless__bigint_init_raw(&r0); limitless__bigint_init_raw(&r1); limitless__bigint_init_raw(&rm1);
+  limitless__bigint_init_raw(&rm2); limitless__bigint_init_raw(&rinf); limitless__bigint_init_raw(&t);
+
+  st = limitless__bigint_slice(ctx, &a0, a, 0, k); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_slice(ctx, &a1, a, k, k); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_slice(ctx, &a2, a, 2 * k, n - 2 * k); if (st != LIMITLESS_OK) goto cleanup;
+  if (!sq) {
+    st = limitless__bigint_slice(ctx, &b0, b, 0, k); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__bigint_slice(ctx, &b1, b, k, k); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__bigint_slice(ctx, &b2, b, 2 * k, n - 2 * k); if (st != LIMITLESS_OK) goto cleanup;
   }
 
-  abit = limitless__bigint_bit_length(&rem);
-  bbit = limitless__bigint_bit_length(&den);
-  shift = abit - bbit;
-
-  st = limitless__bigint_shl_bits(ctx, &den, &den, shift);
-  if (st != LIMITLESS_OK) goto cleanup;
-
-  st = limitless__bigint_reserve(ctx, q, (shift / (limitless_size)LIMITLESS_LIMB_BITS) + 1);
-  if (st != LIMITLESS_OK) goto cleanup;
-  for (i = 0; i < q->cap; ++i) q->limbs[i] = (limitless_limb)0;
-  q->used = (shift / (limitless_size)LIMITLESS_LIMB_BITS) + 1;
-  q->sign = 1;
-
-  i = shift + 1;
-  while (i > 0) {
-    limitless_size bit = i - 1;
-    if (limitless__mag_cmp(&rem, &den) >= 0) {
-      limitless__mag_sub_inplace(&rem, &den);
-      st = limitless__bigint_set_bit(ctx, q, bit);
-      if (st != LIMITLESS_OK) goto cleanup;
-    }
-    limitless__bigint_shr1_inplace(&den);
-    --i;
+  /* evaluate at 0, 1, -1, -2 and infinity */
+  st = limitless__bigint_mul_signed(ctx, &r0, &a0, pb0); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_mul_signed(ctx, &rinf, &a2, pb2); if (st != LIMITLESS_OK) goto cleanup;
+
+  st = limitless__bigint_add_signed(ctx, &sa, &a0, &a2); if (st != LIMITLESS_OK) goto cleanup;
+  if (!sq) { st = limitless__bigint_add_signed(ctx, &sb, &b0, &b2); if (st != LIMITLESS_OK) goto cleanup; }
+
+  st = limitless__bigint_add_signed(ctx, &ea, &sa, &a1); if (st != LIMITLESS_OK) goto cleanup;
+  if (!sq) { st = limitless__bigint_add_signed(ctx, &eb, &sb, &b1); if (st != LIMITLESS_OK) goto cleanup; }
+  st = limitless__bigint_mul_signed(ctx, &r1, &ea, peb); if (st != LIMITLESS_OK) goto cleanup;
+
+  st = limitless__bigint_sub_signed(ctx, &ea, &sa, &a1); if (st != LIMITLESS_OK) goto cleanup;
+  if (!sq) { st = limitless__bigint_sub_signed(ctx, &eb, &sb, &b1); if (st != LIMITLESS_OK) goto cleanup; }
+  st = limitless__bigint_mul_signed(ctx, &rm1, &ea, peb); if (st != LIMITLESS_OK) goto cleanup;
+
+  /* p(-2) = 2 * (p(-1) + x2) - x0 */
+  st = limitless__bigint_add_signed(ctx, &ea, &ea, &a2); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_shl_bits(ctx, &ea, &ea, 1); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_sub_signed(ctx, &ea, &ea, &a0); if (st != LIMITLESS_OK) goto cleanup;
+  if (!sq) {
+    st = limitless__bigint_add_signed(ctx, &eb, &eb, &b2); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__bigint_shl_bits(ctx, &eb, &eb, 1); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__bigint_sub_signed(ctx, &eb, &eb, &b0); if (st != LIMITLESS_OK) goto cleanup;
   }
-
-  st = limitless__bigint_copy(ctx, r, &rem);
-  if (st != LIMITLESS_OK) goto cleanup;
-  q->sign = (q->used == 0) ? 0 : 1;
-  r->sign = (r->used == 0) ? 0 : 1;
+  st = limitless__bigint_mul_signed(ctx, &rm2, &ea, peb); if (st != LIMITLESS_OK) goto cleanup;
+
+  /* Bodrato interpolation; every division below is exact */
+  st = limitless__bigint_sub_signed(ctx, &t, &rm2, &r1); if (st != LIMITLESS_OK) goto cleanup;
+  (void)limitless__bigint_divmod_small_inplace(&t, 3u);
+  st = limitless__bigint_sub_signed(ctx, &r1, &r1, &rm1); if (st != LIMITLESS_OK) goto cleanup;
+  limitless__bigint_shr1_inplace(&r1);
+  st = limitless__bigint_sub_signed(ctx, &rm1, &rm1, &r0); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_sub_signed(ctx, &t, &rm1, &t); if (st != LIMITLESS_OK) goto cleanup;
+  limitless__bigint_shr1_inplace(&t);
+  st = limitless__bigint_shl_bits(ctx, &ea, &rinf, 1); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_add_signed(ctx, &t, &t, &ea); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_add_signed(ctx, &rm1, &rm1, &r1); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_sub_signed(ctx, &rm1, &rm1, &rinf); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_sub_signed(ctx, &r1, &r1, &t); if (st != LIMITLESS_OK) goto cleanup;
+
+  /* recomposition into r0: all coefficients are non-negative here, and out is only touched by the final swap */
+  st = limitless__mag_add_shifted(ctx, &r0, &r1, k); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__mag_add_shifted(ctx, &r0, &rm1, 2 * k); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__mag_add_shifted(ctx, &r0, &t, 3 * k); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__mag_add_shifted(ctx, &r0, &rinf, 4 * k); if (st != LIMITLESS_OK) goto cleanup;
+  r0.sign = (r0.used == 0) ? 0 : 1;
+  limitless__bigint_swap(out, &r0);
 
 cleanup:
-  limitless__bigint_clear_raw(ctx, &rem);
-  limitless__bigint_clear_raw(ctx, &den);
+  limitless__bigint_clear_raw(ctx, &a0); limitless__bigint_clear_raw(ctx, &a1); limitless__bigint_clear_raw(ctx, &a2);
+  limitless__bigint_clear_raw(ctx, &b0); limitless__bigint_clear_raw(ctx, &b1); limitless__bigint_clear_raw(ctx, &b2);
+  limitless__bigint_clear_raw(ctx, &sa); limitless__bigint_clear_raw(ctx, &sb);
+  limitless__bigint_clear_raw(ctx, &ea); limitless__bigint_clear_raw(ctx, &eb);
+  limitless__bigint_clear_raw(ctx, &r0); limitless__bigint_clear_raw(ctx, &r1); limitless__bigint_clear_raw(ctx, &rm1);
+  limitless__bigint_clear_raw(ctx, &rm2); limitless__bigint_clear_raw(ctx, &rinf); limitless__bigint_clear_raw(ctx, &t);
   return st;
 }
 
-static limitless_status limitless__bigint_divmod_signed(limitless_ctx* ctx, limitless_bigint* q, limitless_bigint* r, const limitless_bigint* a, const limitless_bigint* b) {
-  limitless_status st = limitless__bigint_divmod_abs(ctx, q, r, a, b);
-  if (st != LIMITLESS_OK) return st;
-  if (q->used != 0) q->sign = (a->sign == b->sign) ? 1 : -1;
-  if (r->used != 0) r->sign = a->sign;
-  return LIMITLESS_OK;
+/*
+Three-prime number theoretic transform. Operands are cut into 32-bit pieces;
+each convolution coefficient is below 2^25 * 2^64 = 2^89 for transforms of at
+most 2^26 points, which the product of the three primes (about 2^90.5) covers,
+so the CRT reconstruction is exact and the result is bit-identical to
+schoolbook multiplication.
+*/
+#define LIMITLESS__NTT_MAX_LOG2 26u
+
+static const limitless_u32 limitless__ntt_primes[3] = {2013265921u, 1811939329u, 469762049u};
+static const limitless_u32 limitless__ntt_roots[3] = {31u, 13u, 3u};
+
+typedef struct limitless__ntt_mod {
+  limitless_u32 p;
+  limitless_u32 pinv; /* -p^-1 mod 2^32 */
+  limitless_u32 r2;   /* 2^64 mod p */
+} limitless__ntt_mod;
+
+static limitless_u32 limitless__ntt_pow(limitless_u32 base, limitless_u32 e, limitless_u32 p) {
+  limitless_u64 r = 1u;
+  limitless_u64 b = (limitless_u64)base % p;
+  while (e != 0u) {
+    if (e & 1u) r = (r * b) % p;
+    b = (b * b) % p;
+    e >>= 1;
+  }
+  return (limitless_u32)r;
 }
 
-static limitless_status limitless__bigint_mod(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* m) {
-  limitless_bigint q, r;
-  limitless_status st;
-  limitless__bigint_init_raw(&q);
-  limitless__bigint_init_raw(&r);
-  st = limitless__bigint_divmod_signed(ctx, &q, &r, a, m);
-  if (st == LIMITLESS_OK) {
-    st = limitless__bigint_copy(ctx, out, &r);
-  }
-  limitless__bigint_clear_raw(ctx, &q);
-  limitless__bigint_clear_raw(ctx, &r);
-  return st;
+static void limitless__ntt_mod_init(limitless__ntt_mod* m, limitless_u32 p) {
+  limitless_u32 inv = p;
+  int i;
+  /* Newton iteration doubles the number of correct low bits each step */
+  for (i = 0; i < 4; ++i) inv *= 2u - p * inv;
+  m->p = p;
+  m->pinv = (limitless_u32)0u - inv;
+  m->r2 = (limitless_u32)(((limitless_u64)0 - (limitless_u64)p) % p);
 }
 
-static limitless_status limitless__bigint_div_exact(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* d) {
-  limitless_bigint q, r;
-  limitless_status st;
-  limitless__bigint_init_raw(&q);
-  limitless__bigint_init_raw(&r);
-  st = limitless__bigint_divmod_signed(ctx, &q, &r, a, d);
-  if (st != LIMITLESS_OK) goto cleanup;
-  if (r.used != 0) {
-    st = LIMITLESS_EINVAL;
-    goto cleanup;
-  }
-  st = limitless__bigint_copy(ctx, out, &q);
-cleanup:
-  limitless__bigint_clear_raw(ctx, &q);
-  limitless__bigint_clear_raw(ctx, &r);
-  return st;
+static limitless_u32 limitless__ntt_mul(const limitless__ntt_mod* m, limitless_u32 a, limitless_u32 b) {
+  limitless_u64 t = (limitless_u64)a * b;
+  limitless_u32 q = (limitless_u32)t * m->pinv;
+  limitless_u64 u = (t + (limitless_u64)q * m->p) >> 32;
+  return (u >= m->p) ? (limitless_u32)(u - m->p) : (limitless_u32)u;
 }
 
-static limitless_status limitless__bigint_gcd(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b) {
-  limitless_bigint u, v;
-  limitless_size shift;
-  limitless_status st;
-  limitless__bigint_init_raw(&u);
-  limitless__bigint_init_raw(&v);
-  st = limitless__bigint_abs_copy(ctx, &u, a); if (st != LIMITLESS_OK) goto cleanup;
-  st = limitless__bigint_abs_copy(ctx, &v, b); if (st != LIMITLESS_OK) goto cleanup;
+static limitless_u32 limitless__ntt_piece(const limitless_bigint* a, limitless_size i) {
+#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
+  return LIMITLESS_BIGINT_LIMBS(a)[i];
+#else
+  const limitless_limb* al = LIMITLESS_BIGINT_LIMBS(a);
+  return (limitless_u32)(al[i >> 1] >> (32u * (unsigned)(i & 1u)));
+#endif
+}
 
-  if (u.used == 0) {
-    st = limitless__bigint_copy(ctx, out, &v);
-    if (st == LIMITLESS_OK && out->used > 0) out->sign = 1;
-    goto cleanup;
+static limitless_size limitless__ntt_pieces(const limitless_bigint* a) {
+#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
+  return a->used;
+#else
+  if (a->used == 0) return 0;
+  return a->used * 2u - (((LIMITLESS_BIGINT_LIMBS(a)[a->used - 1] >> 32) == 0u) ? 1u : 0u);
+#endif
+}
+
+static int limitless__ntt_fits(const limitless_bigint* a, const limitless_bigint* b) {
+  limitless_size na = limitless__ntt_pieces(a);
+  limitless_size nb = limitless__ntt_pieces(b);
+  return na + nb - 1u <= ((limitless_size)1 << LIMITLESS__NTT_MAX_LOG2);
+}
+
+/* twiddle tables are laid out heap-style: tw[h + j] = w_{2h}^j in montgomery form */
+static void limitless__ntt_twiddles(const limitless__ntt_mod* m, limitless_u32* tw, limitless_size len, limitless_u32 w) {
+  limitless_size h = len >> 1;
+  limitless_size j;
+  limitless_u32 cur = limitless__ntt_mul(m, 1u, m->r2);
+  limitless_u32 step = limitless__ntt_mul(m, w, m->r2);
+  for (j = 0; j < h; ++j) {
+    tw[h + j] = cur;
+    cur = limitless__ntt_mul(m, cur, step);
   }
-  if (v.used == 0) {
-    st = limitless__bigint_copy(ctx, out, &u);
-    if (st == LIMITLESS_OK && out->used > 0) out->sign = 1;
-    goto cleanup;
+  for (h >>= 1; h >= 1; h >>= 1) {
+    for (j = 0; j < h; ++j) tw[h + j] = tw[2u * h + 2u * j];
   }
+}
 
-  {
-    limitless_size uz = limitless__bigint_ctz_bits(&u);
-    limitless_size vz = limitless__bigint_ctz_bits(&v);
-    shift = (uz < vz) ? uz : vz;
-    limitless__bigint_shr_bits_inplace(&u, uz);
-    limitless__bigint_shr_bits_inplace(&v, vz);
-  }
-
-  while (u.used != 0 && v.used != 0) {
-    int c = limitless__mag_cmp(&u, &v);
-    if (c == 0) break;
-    if (c > 0) {
-      limitless__mag_sub_inplace(&u, &v);
-      limitless__bigint_shr_bits_inplace(&u, limitless__bigint_ctz_bits(&u));
-    } else {
-      limitless__mag_sub_inplace(&v, &u);
-      limitless__bigint_shr_bits_inplace(&v, limitless__bigint_ctz_bits(&v));
+/* decimation in frequency: natural order in, bit-reversed order out */
+static void limitless__ntt_forward(const limitless__ntt_mod* m, limitless_u32* a, limitless_size len, const limitless_u32* tw) {
+  limitless_u32 p = m->p;
+  limitless_size h;
+  limitless_size i;
+  limitless_size j;
+  for (h = len >> 1; h >= 1; h >>= 1) {
+    for (i = 0; i < len; i += 2u * h) {
+      for (j = 0; j < h; ++j) {
+        limitless_u32 u = a[i + j];
+        limitless_u32 v = a[i + j + h];
+        limitless_u32 s = u + v;
+        limitless_u32 d = u + (p - v);
+        if (s >= p) s -= p;
+        if (d >= p) d -= p;
+        a[i + j] = s;
+        a[i + j + h] = limitless__ntt_mul(m, d, tw[h + j]);
+      }
     }
   }
+}
 
-  if (u.used == 0) {
-    st = limitless__bigint_copy(ctx, out, &v);
-  } else {
-    st = limitless__bigint_copy(ctx, out, &u);
-  }
-  if (st != LIMITLESS_OK) goto cleanup;
-  if (shift > 0) {
-    limitless_bigint tmp;
-    limitless__bigint_init_raw(&tmp);
-    st = limitless__bigint_shl_bits(ctx, &tmp, out, shift);
-    if (st == LIMITLESS_OK) {
-      limitless__bigint_swap(out, &tmp);
+/* decimation in time: bit-reversed order in, natural order out (unscaled) */
+static void limitless__ntt_inverse(const limitless__ntt_mod* m, limitless_u32* a, limitless_size len, const limitless_u32* itw) {
+  limitless_u32 p = m->p;
+  limitless_size h;
+  limitless_size i;
+  limitless_size j;
+  for (h = 1; h < len; h <<= 1) {
+    for (i = 0; i < len; i += 2u * h) {
+      for (j = 0; j < h; ++j) {
+        limitless_u32 u = a[i + j];
+        limitless_u32 v = limitless__ntt_mul(m, a[i + j + h], itw[h + j]);
+        limitless_u32 s = u + v;
+        limitless_u32 d = u + (p - v);
+        if (s >= p) s -= p;
+        if (d >= p) d -= p;
+        a[i + j] = s;
+        a[i + j + h] = d;
+      }
+    }
+  }
+}
+
+static limitless_status limitless__mag_mul_ntt(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b) {
+  limitless_status st;
+  limitless_size na = limitless__ntt_pieces(a);
+  limitless_size nb = limitless__ntt_pieces(b);
+  limitless_size nc = na + nb - 1u;
+  limitless_size len = 2;
+  int sq = (a == b);
+  limitless_size bytes;
+  limitless_size i;
+  limitless_size need;
+  limitless_u32* mem;
+  limitless_u32* fa;
+  limitless_u32* fb;
+  limitless_u32* res[3];
+  limitless_u32* tw;
+  limitless_u32* itw;
+  limitless_u32 p1 = limitless__ntt_primes[0];
+  limitless_u32 p2 = limitless__ntt_primes[1];
+  limitless_u32 p3 = limitless__ntt_primes[2];
+  limitless_u64 inv1;
+  limitless_u64 inv12;
+  limitless_u64 p12;
+  limitless_u64 carry = 0u;
+  int k;
+
+  while (len < nc) len <<= 1;
+  bytes = len * 6u * (limitless_size)sizeof(limitless_u32);
+  mem = (limitless_u32*)limitless__alloc_bytes(ctx, bytes);
+  if (!mem) return LIMITLESS_EOOM;
+  fa = mem;
+  fb = mem + len;
+  res[0] = mem + 2u * len;
+  res[1] = mem + 3u * len;
+  tw = mem + 4u * len;
+  itw = mem + 5u * len;
+  /* the last prime's convolution stays in fa */
+  res[2] = fa;
+
+  for (k = 0; k < 3; ++k) {
+    limitless__ntt_mod m;
+    limitless_u32 w;
+    limitless_u32 scale;
+    limitless_u32* dst = res[k];
+    limitless__ntt_mod_init(&m, limitless__ntt_primes[k]);
+    w = limitless__ntt_pow(limitless__ntt_roots[k], (m.p - 1u) / (limitless_u32)len, m.p);
+    limitless__ntt_twiddles(&m, tw, len, w);
+    limitless__ntt_twiddles(&m, itw, len, limitless__ntt_pow(w, (limitless_u32)len - 1u, m.p));
+
+    for (i = 0; i < len; ++i) fa[i] = (i < na) ? limitless__ntt_piece(a, i) % m.p : 0u;
+    limitless__ntt_forward(&m, fa, len, tw);
+    if (sq) {
+      /* squaring needs a single forward transform */
+      for (i = 0; i < len; ++i) dst[i] = limitless__ntt_mul(&m, fa[i], fa[i]);
+    } else {
+      for (i = 0; i < len; ++i) fb[i] = (i < nb) ? limitless__ntt_piece(b, i) % m.p : 0u;
+      limitless__ntt_forward(&m, fb, len, tw);
+      for (i = 0; i < len; ++i) dst[i] = limitless__ntt_mul(&m, fa[i], fb[i]);
+    }
+    limitless__ntt_inverse(&m, dst, len, itw);
+    /* the pointwise product left a factor R^-1 and the inverse a factor len: multiply by R^2 / len */
+    scale = (limitless_u32)(((limitless_u64)m.r2 * limitless__ntt_pow((limitless_u32)len, m.p - 2u, m.p)) % m.p);
+    for (i = 0; i < nc; ++i) dst[i] = limitless__ntt_mul(&m, dst[i], scale);
+  }
+
+  need = a->used + b->used;
+  st = limitless__bigint_reserve_exact(ctx, out, need);
+  if (st != LIMITLESS_OK) {
+    limitless__free_bytes(ctx, mem, bytes);
+    return st;
+  }
+  limitless__limbs_zero(LIMITLESS_BIGINT_LIMBS(out), need);
+
+  /* garner: x = r1 + p1 * y2 + p1 * p2 * y3 */
+  inv1 = limitless__ntt_pow(p1 % p2, p2 - 2u, p2);
+  inv12 = limitless__ntt_pow((limitless_u32)(((limitless_u64)p1 * p2) % p3), p3 - 2u, p3);
+  p12 = (limitless_u64)p1 * p2;
+  /* the product fits in na + nb pieces, so the carry left after the last coefficient is one word */
+  for (i = 0; i <= nc; ++i) {
+    limitless_u32 word;
+    if (i < nc) {
+      limitless_u64 r1 = res[0][i];
+      limitless_u64 y2 = ((res[1][i] + (limitless_u64)p2 - r1 % p2) % p2) * inv1 % p2;
+      limitless_u64 v = r1 + (limitless_u64)p1 * y2;
+      limitless_u64 y3 = ((res[2][i] + (limitless_u64)p3 - v % p3) % p3) * inv12 % p3;
+      /* x = v + p12 * y3 spans three 32-bit words; fold them into the running carry */
+      limitless_u64 lo = (p12 & 0xffffffffu) * y3;
+      limitless_u64 hi = (p12 >> 32) * y3;
+      limitless_u64 w0 = (v & 0xffffffffu) + (lo & 0xffffffffu) + (carry & 0xffffffffu);
+      word = (limitless_u32)w0;
+      carry = (v >> 32) + (lo >> 32) + hi + (carry >> 32) + (w0 >> 32);
+    } else {
+      word = (limitless_u32)carry;
+    }
+#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
+    LIMITLESS_BIGINT_LIMBS(out)[i] = word;
+#else
+    LIMITLESS_BIGINT_LIMBS(out)[i >> 1] |= (limitless_limb)word << (32u * (unsigned)(i & 1u));
+#endif
+  }
+  limitless__free_bytes(ctx, mem, bytes);
+
+  out->used = need;
+  out->sign = 1;
+  limitless__bigint_norm(out);
+  return LIMITLESS_OK;
+}
+
+/*
+Knuth, TAOCP vol. 2, 4.3.1, Algorithm D. v[0, vn) is normalized (top bit of
+v[vn - 1] set, vn >= 2) and u has un + 1 limbs. Each quotient limb is
+estimated from the top two limbs of the running remainder divided by
+v[vn - 1], corrected against v[vn - 2], and is then off by at most one, which
+the add-back step repairs. q receives un - vn + 1 limbs; u[0, vn) is left
+holding the remainder.
+*/
+static void limitless__span_divrem_knuth(const limitless_ctx* ctx, limitless_limb* q, limitless_limb* u, limitless_size un, const limitless_limb* v, limitless_size vn) {
+  const limitless_dlimb base = (limitless_dlimb)1 << LIMITLESS_LIMB_BITS;
+  limitless_limb vtop = v[vn - 1];
+  limitless_limb vnext = v[vn - 2];
+  limitless_size j = un - vn + 1;
+  while (j > 0) {
+    limitless_dlimb num;
+    limitless_dlimb qhat;
+    limitless_dlimb rhat;
+    limitless_limb borrow;
+    limitless_limb top;
+    --j;
+    num = ((limitless_dlimb)u[j + vn] << LIMITLESS_LIMB_BITS) | (limitless_dlimb)u[j + vn - 1];
+    qhat = num / vtop;
+    rhat = num % vtop;
+    while (qhat >= base || qhat * vnext > ((rhat << LIMITLESS_LIMB_BITS) | (limitless_dlimb)u[j + vn - 2])) {
+      --qhat;
+      rhat += vtop;
+      if (rhat >= base) break;
+    }
+    /* qhat < base here, and qhat * v fits vn + 1 limbs, so the borrow fits a limb */
+    borrow = ctx->kernels.submul_1(u + j, v, vn, (limitless_limb)qhat);
+    top = u[j + vn];
+    u[j + vn] = (limitless_limb)(top - borrow);
+    if (top < borrow) {
+      --qhat;
+      u[j + vn] = (limitless_limb)(u[j + vn] + limitless__span_add(ctx, u + j, u + j, vn, v, vn));
+    }
+    q[j] = (limitless_limb)qhat;
+  }
+}
+
+/* schoolbook division of magnitudes; q and r must not alias a or b */
+static limitless_status limitless__bigint_divmod_knuth(limitless_ctx* ctx, limitless_bigint* q, limitless_bigint* r, const limitless_bigint* a, const limitless_bigint* b) {
+  limitless_status st;
+  limitless_size shift;
+  limitless_bigint u, v;
+
+  if (a->used < b->used) {
+    q->used = 0;
+    q->sign = 0;
+    st = limitless__bigint_copy(ctx, r, a);
+    if (st == LIMITLESS_OK) r->sign = (r->used == 0) ? 0 : 1;
+    return st;
+  }
+  if (b->used == 1) {
+    limitless__divisor dv;
+    limitless_limb rem;
+    st = limitless__bigint_reserve_exact(ctx, q, a->used); if (st != LIMITLESS_OK) return st;
+    st = limitless__bigint_reserve(ctx, r, 1); if (st != LIMITLESS_OK) return st;
+    limitless__divisor_init(&dv, LIMITLESS_BIGINT_LIMBS(b)[0]);
+    rem = limitless__span_divrem_1(LIMITLESS_BIGINT_LIMBS(q), LIMITLESS_BIGINT_LIMBS(a), a->used, &dv);
+    q->used = a->used;
+    q->sign = 1;
+    limitless__bigint_norm(q);
+    LIMITLESS_BIGINT_LIMBS(r)[0] = rem;
+    r->used = 1;
+    r->sign = 1;
+    limitless__bigint_norm(r);
+    return LIMITLESS_OK;
+  }
+
+  /* u becomes the remainder; the normalized divisor only lives for this call */
+  limitless__bigint_init_raw(&u);
+  st = limitless__scratch_bigint(ctx, &v, b->used + 1); if (st != LIMITLESS_OK) goto cleanup;
+  shift = (limitless_size)limitless__limb_clz(LIMITLESS_BIGINT_LIMBS(b)[b->used - 1]);
+  st = limitless__bigint_shl_bits(ctx, &u, a, shift); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_shl_bits(ctx, &v, b, shift); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_reserve(ctx, &u, a->used + 1); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_reserve_exact(ctx, q, a->used - b->used + 1); if (st != LIMITLESS_OK) goto cleanup;
+  limitless__limbs_zero(LIMITLESS_BIGINT_LIMBS(&u) + u.used, a->used + 1 - u.used);
+
+  limitless__span_divrem_knuth(ctx, LIMITLESS_BIGINT_LIMBS(q), LIMITLESS_BIGINT_LIMBS(&u), a->used, LIMITLESS_BIGINT_LIMBS(&v), b->used);
+  q->used = a->used - b->used + 1;
+  q->sign = 1;
+  limitless__bigint_norm(q);
+  u.used = b->used;
+  u.sign = 1;
+  limitless__bigint_norm(&u);
+  limitless__bigint_shr_bits_inplace(&u, shift);
+  limitless__bigint_swap(r, &u);
+
+cleanup:
+  limitless__scratch_bigint_release(ctx, &v);
+  limitless__bigint_clear_raw(ctx, &u);
+  return st;
+}
+
+/*
+Burnikel-Ziegler recursive division ("Fast Recursive Division", 1998).
+div2n1n divides a < b * B^n by a normalized n-limb b through two 3n/2n steps
+on half-size pieces; each 3n/2n step recurses on the top halves and fixes
+the estimate with one multiply by the low half of b, so the cost follows the
+fast multiply. Sizes below ctx->bz_threshold fall back to Algorithm D.
+*/
+static limitless_status limitless__bz_div2n1n(limitless_ctx* ctx, limitless_bigint* q, limitless_bigint* r, const limitless_bigint* a, const limitless_bigint* b, limitless_size n);
+
+static limitless_status limitless__bz_div3n2n(limitless_ctx* ctx, limitless_bigint* q, limitless_bigint* r, const limitless_bigint* a12, const limitless_bigint* a3,
+                                              const limitless_bigint* b, const limitless_bigint* b1, const limitless_bigint* b2, limitless_size n) {
+  limitless_status st;
+  limitless_size i;
+  limitless_bigint top, c, d, one;
+
+  limitless__bigint_init_raw(&top);
+  limitless__bigint_init_raw(&c);
+  limitless__bigint_init_raw(&d);
+  limitless__bigint_init_raw(&one);
+
+  st = limitless__bigint_slice(ctx, &top, a12, n, a12->used); if (st != LIMITLESS_OK) goto cleanup;
+  if (limitless__mag_cmp(&top, b1) == 0) {
+    /* the estimate would overflow n limbs: q = B^n - 1, c = a12 - b1 * B^n + b1 */
+    st = limitless__bigint_reserve(ctx, q, n); if (st != LIMITLESS_OK) goto cleanup;
+    for (i = 0; i < n; ++i) LIMITLESS_BIGINT_LIMBS(q)[i] = (limitless_limb)~(limitless_limb)0;
+    q->used = n;
+    q->sign = 1;
+    st = limitless__bigint_slice(ctx, &c, a12, 0, n); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__bigint_add_signed(ctx, &c, &c, b1); if (st != LIMITLESS_OK) goto cleanup;
+  } else {
+    st = limitless__bz_div2n1n(ctx, q, &c, a12, b1, n); if (st != LIMITLESS_OK) goto cleanup;
+  }
+
+  /* r = c * B^n + a3 - q * b2, then correct q downwards while r < 0 (at most twice) */
+  st = limitless__bigint_copy(ctx, r, a3); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__mag_add_shifted(ctx, r, &c, n); if (st != LIMITLESS_OK) goto cleanup;
+  r->sign = (r->used == 0) ? 0 : 1;
+  st = limitless__mag_mul(ctx, &d, q, b2); if (st != LIMITLESS_OK) goto cleanup;
+  d.sign = (d.used == 0) ? 0 : 1;
+  st = limitless__bigint_sub_signed(ctx, r, r, &d); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_set_u64(ctx, &one, 1u); if (st != LIMITLESS_OK) goto cleanup;
+  while (r->sign < 0) {
+    limitless__mag_sub_inplace(ctx, q, &one);
+    st = limitless__bigint_add_signed(ctx, r, r, b); if (st != LIMITLESS_OK) goto cleanup;
+  }
+
+cleanup:
+  limitless__bigint_clear_raw(ctx, &top);
+  limitless__bigint_clear_raw(ctx, &c);
+  limitless__bigint_clear_raw(ctx, &d);
+  limitless__bigint_clear_raw(ctx, &one);
+  return st;
+}
+
+static limitless_status limitless__bz_div2n1n(limitless_ctx* ctx, limitless_bigint* q, limitless_bigint* r, const limitless_bigint* a, const limitless_bigint* b, limitless_size n) {
+  limitless_status st;
+  limitless_size half;
+  limitless_bigint b1, b2, a12, a3, a4, q1, r1, q2;
+
+  if (n < ctx->bz_threshold) return limitless__bigint_divmod_knuth(ctx, q, r, a, b);
+  if (n & 1u) {
+    /* pad odd sizes by one limb so the halves stay equal */
+    limitless_bigint pa, pb;
+    limitless__bigint_init_raw(&pa);
+    limitless__bigint_init_raw(&pb);
+    st = limitless__bigint_shl_bits(ctx, &pa, a, (limitless_size)LIMITLESS_LIMB_BITS);
+    if (st == LIMITLESS_OK) st = limitless__bigint_shl_bits(ctx, &pb, b, (limitless_size)LIMITLESS_LIMB_BITS);
+    if (st == LIMITLESS_OK) st = limitless__bz_div2n1n(ctx, q, r, &pa, &pb, n + 1);
+    if (st == LIMITLESS_OK) limitless__bigint_shr_bits_inplace(r, (limitless_size)LIMITLESS_LIMB_BITS);
+    limitless__bigint_clear_raw(ctx, &pa);
+    limitless__bigint_clear_raw(ctx, &pb);
+    return st;
+  }
+
+  half = n / 2;
+  limitless__bigint_init_raw(&b1); limitless__bigint_init_raw(&b2);
+  limitless__bigint_init_raw(&a12); limitless__bigint_init_raw(&a3); limitless__bigint_init_raw(&a4);
+  limitless__bigint_init_raw(&q1); limitless__bigint_init_raw(&r1); limitless__bigint_init_raw(&q2);
+
+  st = limitless__bigint_slice(ctx, &b1, b, half, half); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_slice(ctx, &b2, b, 0, half); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_slice(ctx, &a12, a, n, n); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_slice(ctx, &a3, a, half, half); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_slice(ctx, &a4, a, 0, half); if (st != LIMITLESS_OK) goto cleanup;
+
+  st = limitless__bz_div3n2n(ctx, &q1, &r1, &a12, &a3, b, &b1, &b2, half); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bz_div3n2n(ctx, &q2, r, &r1, &a4, b, &b1, &b2, half); if (st != LIMITLESS_OK) goto cleanup;
+
+  q->used = 0;
+  q->sign = 0;
+  st = limitless__mag_add_shifted(ctx, q, &q2, 0); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__mag_add_shifted(ctx, q, &q1, half); if (st != LIMITLESS_OK) goto cleanup;
+
+cleanup:
+  limitless__bigint_clear_raw(ctx, &b1); limitless__bigint_clear_raw(ctx, &b2);
+  limitless__bigint_clear_raw(ctx, &a12); limitless__bigint_clear_raw(ctx, &a3); limitless__bigint_clear_raw(ctx, &a4);
+  limitless__bigint_clear_raw(ctx, &q1); limitless__bigint_clear_raw(ctx, &r1); limitless__bigint_clear_raw(ctx, &q2);
+  return st;
+}
+
+/* splits a into n-limb digits of the normalized divisor and runs div2n1n on each, top first */
+static limitless_status limitless__bigint_divmod_bz(limitless_ctx* ctx, limitless_bigint* q, limitless_bigint* r, const limitless_bigint* a, const limitless_bigint* b) {
+  limitless_status st;
+  limitless_size shift = (limitless_size)limitless__limb_clz(LIMITLESS_BIGINT_LIMBS(b)[b->used - 1]);
+  limitless_size n = b->used;
+  limitless_size k;
+  limitless_bigint u, v, x, qd;
+
+  limitless__bigint_init_raw(&u); limitless__bigint_init_raw(&v);
+  limitless__bigint_init_raw(&x); limitless__bigint_init_raw(&qd);
+
+  st = limitless__bigint_shl_bits(ctx, &u, a, shift); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_shl_bits(ctx, &v, b, shift); if (st != LIMITLESS_OK) goto cleanup;
+  /* the corrections in div3n2n add v back, so it must be a magnitude */
+  u.sign = 1;
+  v.sign = 1;
+  q->used = 0;
+  q->sign = 0;
+  r->used = 0;
+  r->sign = 0;
+  k = (u.used + n - 1) / n;
+  while (k > 0) {
+    --k;
+    st = limitless__bigint_slice(ctx, &x, &u, k * n, n); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__mag_add_shifted(ctx, &x, r, n); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__bz_div2n1n(ctx, &qd, r, &x, &v, n); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__mag_add_shifted(ctx, q, &qd, k * n); if (st != LIMITLESS_OK) goto cleanup;
+  }
+  limitless__bigint_shr_bits_inplace(r, shift);
+
+cleanup:
+  limitless__bigint_clear_raw(ctx, &u); limitless__bigint_clear_raw(ctx, &v);
+  limitless__bigint_clear_raw(ctx, &x); limitless__bigint_clear_raw(ctx, &qd);
+  return st;
+}
+
+static limitless_status limitless__bigint_divmod_abs(limitless_ctx* ctx, limitless_bigint* q, limitless_bigint* r, const limitless_bigint* a, const limitless_bigint* b) {
+  limitless_status st;
+  int cmp;
+  limitless_bigint nq, nr;
+
+  if (b->used == 0) return LIMITLESS_EDIVZERO;
+
+  cmp = limitless__mag_cmp(a, b);
+  if (cmp < 0) {
+    st = limitless__bigint_abs_copy(ctx, r, a);
+    if (st != LIMITLESS_OK) return st;
+    q->used = 0;
+    q->sign = 0;
+    r->sign = (r->used == 0) ? 0 : 1;
+    return LIMITLESS_OK;
+  }
+  if (cmp == 0) {
+    st = limitless__bigint_set_u64(ctx, q, 1);
+    if (st != LIMITLESS_OK) return st;
+    r->used = 0;
+    r->sign = 0;
+    return LIMITLESS_OK;
+  }
+
+  /* results are built in locals so q and r may alias the inputs and stay untouched on failure */
+  limitless__bigint_init_raw(&nq);
+  limitless__bigint_init_raw(&nr);
+  if (b->used < ctx->bz_threshold || a->used - b->used < ctx->bz_threshold) {
+    st = limitless__bigint_divmod_knuth(ctx, &nq, &nr, a, b);
+  } else {
+    st = limitless__bigint_divmod_bz(ctx, &nq, &nr, a, b);
+  }
+  if (st == LIMITLESS_OK) {
+    nq.sign = (nq.used == 0) ? 0 : 1;
+    nr.sign = (nr.used == 0) ? 0 : 1;
+    limitless__bigint_swap(q, &nq);
+    limitless__bigint_swap(r, &nr);
+  }
+  limitless__bigint_clear_raw(ctx, &nq);
+  limitless__bigint_clear_raw(ctx, &nr);
+  return st;
+}
+
+static limitless_status limitless__bigint_divmod_signed(limitless_ctx* ctx, limitless_bigint* q, limitless_bigint* r, const limitless_bigint* a, const limitless_bigint* b) {
+  limitless_status st = limitless__bigint_divmod_abs(ctx, q, r, a, b);
+  if (st != LIMITLESS_OK) return st;
+  if (q->used != 0) q->sign = (a->sign == b->sign) ? 1 : -1;
+  if (r->used != 0) r->sign = a->sign;
+  return LIMITLESS_OK;
+}
+
+static limitless_status limitless__bigint_mod(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* m) {
+  limitless_bigint q, r;
+  limitless_status st;
+  if (m->used == 1) {
+    /* remainder by a single limb never needs the quotient */
+    limitless__divisor dv;
+    limitless_limb rem;
+    limitless__divisor_init(&dv, LIMITLESS_BIGINT_LIMBS(m)[0]);
+    rem = limitless__span_divrem_1(NULL, LIMITLESS_BIGINT_LIMBS(a), a->used, &dv);
+    st = limitless__bigint_reserve(ctx, out, 1);
+    if (st != LIMITLESS_OK) return st;
+    LIMITLESS_BIGINT_LIMBS(out)[0] = rem;
+    out->used = 1;
+    out->sign = a->sign;
+    limitless__bigint_norm(out);
+    return LIMITLESS_OK;
+  }
+  limitless__bigint_init_raw(&q);
+  limitless__bigint_init_raw(&r);
+  st = limitless__bigint_divmod_signed(ctx, &q, &r, a, m);
+  if (st == LIMITLESS_OK) {
+    st = limitless__bigint_copy(ctx, out, &r);
+  }
+  limitless__bigint_clear_raw(ctx, &q);
+  limitless__bigint_clear_raw(ctx, &r);
+  return st;
+}
+
+static limitless_status limitless__bigint_div_exact(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* d) {
+  limitless_bigint q, r;
+  limitless_status st;
+  limitless__bigint_init_raw(&q);
+  limitless__bigint_init_raw(&r);
+  st = limitless__bigint_divmod_signed(ctx, &q, &r, a, d);
+  if (st != LIMITLESS_OK) goto cleanup;
+  if (r.used != 0) {
+    st = LIMITLESS_EINVAL;
+    goto cleanup;
+  }
+  limitless__bigint_swap(out, &q);
+cleanup:
+  limitless__bigint_clear_raw(ctx, &q);
+  limitless__bigint_clear_raw(ctx, &r);
+  return st;
+}
+
+/*
+Modular reduction for chains of products under one modulus m of n limbs.
+Odd moduli use Montgomery reduction (Montgomery, "Modular multiplication
+without trial division", 1985): residues are held as x * R mod m with
+R = B^n, and a product is reduced by n addmul_1 passes instead of a
+division. Even moduli use Barrett reduction ("Implementing the Rivest
+Shamir and Adleman public key encryption algorithm on a standard digital
+signal processor", 1986) with mu = floor(B^(2n) / m): two multiplications
+and at most two subtractions per product, on plain residues. Integers
+entering the residue domain are divided by the normalized modulus kept in
+the context, so the divisor is shifted once per modulus rather than once
+per reduction.
+*/
+
+/* -m0^-1 mod B for odd m0; m0 * m0 == 1 mod 8 gives 3 correct bits and each Newton step doubles them */
+static limitless_limb limitless__limb_neg_inverse(limitless_limb m0) {
+  limitless_limb inv = m0;
+  int i;
+  for (i = 0; i < 5; ++i) inv = (limitless_limb)(inv * (limitless_limb)(2u - m0 * inv));
+  return (limitless_limb)(0u - inv);
+}
+
+static void limitless__modctx_init_raw(limitless_modctx* mc) {
+  limitless__bigint_init_raw(&mc->m);
+  limitless__bigint_init_raw(&mc->mn);
+  limitless__bigint_init_raw(&mc->r2);
+  limitless__bigint_init_raw(&mc->mu);
+  limitless__bigint_init_raw(&mc->t);
+  limitless__bigint_init_raw(&mc->q);
+  mc->n = 0;
+  mc->minv = (limitless_limb)0;
+  mc->dinv = (limitless_limb)0;
+  mc->shift = 0u;
+  mc->mont = 0;
+}
+
+static void limitless__modctx_clear(limitless_ctx* ctx, limitless_modctx* mc) {
+  limitless__bigint_clear_raw(ctx, &mc->m);
+  limitless__bigint_clear_raw(ctx, &mc->mn);
+  limitless__bigint_clear_raw(ctx, &mc->r2);
+  limitless__bigint_clear_raw(ctx, &mc->mu);
+  limitless__bigint_clear_raw(ctx, &mc->t);
+  limitless__bigint_clear_raw(ctx, &mc->q);
+  mc->n = 0;
+}
+
+/* m must be positive; every caller rejects m <= 0 with EDIVZERO first */
+static limitless_status limitless__modctx_setup(limitless_ctx* ctx, limitless_modctx* mc, const limitless_bigint* m) {
+  limitless_status st;
+  limitless_size n = m->used;
+  if (n > ((~(limitless_size)0) - 1u) / 2u) return LIMITLESS_EOOM;
+  st = limitless__bigint_copy(ctx, &mc->m, m);
+  if (st != LIMITLESS_OK) return st;
+  mc->n = n;
+  mc->mont = (LIMITLESS_BIGINT_LIMBS(m)[0] & 1u) != 0;
+  mc->shift = limitless__limb_clz(LIMITLESS_BIGINT_LIMBS(m)[n - 1]);
+  st = limitless__bigint_shl_bits(ctx, &mc->mn, &mc->m, (limitless_size)mc->shift);
+  if (st != LIMITLESS_OK) return st;
+  if (n == 1) {
+    limitless__divisor dv;
+    limitless__divisor_init(&dv, LIMITLESS_BIGINT_LIMBS(m)[0]);
+    mc->dinv = dv.v;
+  }
+  /* B^(2n) is the numerator of both constants */
+  st = limitless__bigint_reserve_exact(ctx, &mc->t, 2 * n + 1);
+  if (st != LIMITLESS_OK) return st;
+  limitless__limbs_zero(LIMITLESS_BIGINT_LIMBS(&mc->t), 2 * n);
+  LIMITLESS_BIGINT_LIMBS(&mc->t)[2 * n] = (limitless_limb)1;
+  mc->t.used = 2 * n + 1;
+  mc->t.sign = 1;
+  if (mc->mont) {
+    mc->minv = limitless__limb_neg_inverse(LIMITLESS_BIGINT_LIMBS(m)[0]);
+    return limitless__bigint_mod(ctx, &mc->r2, &mc->t, &mc->m);
+  }
+  return limitless__bigint_divmod_abs(ctx, &mc->mu, &mc->q, &mc->t, &mc->m);
+}
+
+/* out = a mod m in [0, m) for any integer a; out may alias a */
+static limitless_status limitless__modctx_reduce_int(limitless_ctx* ctx, limitless_modctx* mc, limitless_bigint* out, const limitless_bigint* a) {
+  limitless_status st;
+  limitless_size n = mc->n;
+  int neg = a->sign < 0;
+  if (limitless__mag_cmp(a, &mc->m) < 0) {
+    st = limitless__bigint_abs_copy(ctx, out, a);
+  } else if (n == 1) {
+    limitless__divisor dv;
+    limitless_limb rem;
+    dv.d = LIMITLESS_BIGINT_LIMBS(&mc->mn)[0];
+    dv.v = mc->dinv;
+    dv.shift = mc->shift;
+    rem = limitless__span_divrem_1(NULL, LIMITLESS_BIGINT_LIMBS(a), a->used, &dv);
+    st = limitless__bigint_reserve(ctx, out, 1);
+    if (st != LIMITLESS_OK) return st;
+    LIMITLESS_BIGINT_LIMBS(out)[0] = rem;
+    out->used = 1;
+    out->sign = 1;
+    limitless__bigint_norm(out);
+  } else if (n >= ctx->bz_threshold && a->used - n >= ctx->bz_threshold) {
+    st = limitless__bigint_divmod_abs(ctx, &mc->q, out, a, &mc->m);
+  } else {
+    /* Algorithm D against the cached normalized modulus; only the dividend is shifted here */
+    limitless_size un = a->used;
+    limitless_bigint* u = &mc->t;
+    st = limitless__bigint_shl_bits(ctx, u, a, (limitless_size)mc->shift); if (st != LIMITLESS_OK) return st;
+    st = limitless__bigint_reserve(ctx, u, un + 1); if (st != LIMITLESS_OK) return st;
+    st = limitless__bigint_reserve_exact(ctx, &mc->q, un - n + 1); if (st != LIMITLESS_OK) return st;
+    limitless__limbs_zero(LIMITLESS_BIGINT_LIMBS(u) + u->used, un + 1 - u->used);
+    limitless__span_divrem_knuth(ctx, LIMITLESS_BIGINT_LIMBS(&mc->q), LIMITLESS_BIGINT_LIMBS(u), un, LIMITLESS_BIGINT_LIMBS(&mc->mn), n);
+    u->used = n;
+    u->sign = 1;
+    limitless__bigint_norm(u);
+    limitless__bigint_shr_bits_inplace(u, (limitless_size)mc->shift);
+    st = limitless__bigint_copy(ctx, out, u);
+  }
+  if (st != LIMITLESS_OK) return st;
+  if (neg && out->used != 0) return limitless__mag_sub(ctx, out, &mc->m, out);
+  return LIMITLESS_OK;
+}
+
+/* out = mc->t * R^-1 mod m (Montgomery) or mc->t mod m (Barrett), for mc->t < m^2; mc->t is consumed */
+static limitless_status limitless__modctx_reduce(limitless_ctx* ctx, limitless_modctx* mc, limitless_bigint* out) {
+  limitless_status st;
+  limitless_size n = mc->n;
+  limitless_bigint* t = &mc->t;
+  if (mc->mont) {
+    const limitless_limb* mp = LIMITLESS_BIGINT_LIMBS(&mc->m);
+    limitless_limb* tp;
+    limitless_limb carry;
+    limitless_size i;
+    st = limitless__bigint_reserve_exact(ctx, t, 2 * n);
+    if (st != LIMITLESS_OK) return st;
+    tp = LIMITLESS_BIGINT_LIMBS(t);
+    limitless__limbs_zero(tp + t->used, 2 * n - t->used);
+    for (i = 0; i < n; ++i) {
+      /* each pass clears limb i; its carry belongs at limb i + n and is parked in limb i until the end */
+      limitless_limb u = (limitless_limb)(tp[i] * mc->minv);
+      tp[i] = ctx->kernels.addmul_1(tp + i, mp, n, u);
+    }
+    carry = ctx->kernels.add_n(tp + n, tp + n, tp, n);
+    /* the sum is below 2m */
+    if (carry != (limitless_limb)0 || limitless__limbs_cmp(tp + n, mp, n) >= 0) {
+      (void)ctx->kernels.sub_n(tp + n, tp + n, mp, n);
+    }
+    st = limitless__bigint_reserve_exact(ctx, out, n);
+    if (st != LIMITLESS_OK) return st;
+    limitless__limbs_copy(LIMITLESS_BIGINT_LIMBS(out), tp + n, n);
+    out->used = n;
+    out->sign = 1;
+    limitless__bigint_norm(out);
+    return LIMITLESS_OK;
+  }
+  if (limitless__mag_cmp(t, &mc->m) < 0) return limitless__bigint_copy(ctx, out, t);
+  /* q = floor(floor(t / B^(n-1)) * mu / B^(n+1)) undershoots floor(t / m) by at most 2 */
+  st = limitless__bigint_slice(ctx, &mc->q, t, n - 1, n + 2);
+  if (st != LIMITLESS_OK) return st;
+  st = limitless__bigint_mul_signed(ctx, out, &mc->q, &mc->mu);
+  if (st != LIMITLESS_OK) return st;
+  st = limitless__bigint_slice(ctx, &mc->q, out, n + 1, n + 2);
+  if (st != LIMITLESS_OK) return st;
+  st = limitless__bigint_mul_signed(ctx, out, &mc->q, &mc->m);
+  if (st != LIMITLESS_OK) return st;
+  st = limitless__mag_sub(ctx, out, t, out);
+  if (st != LIMITLESS_OK) return st;
+  while (limitless__mag_cmp(out, &mc->m) >= 0) limitless__mag_sub_inplace(ctx, out, &mc->m);
+  return LIMITLESS_OK;
+}
+
+/* out = a * b in the reduced domain; a and b are residues in [0, m) and out may alias either */
+static limitless_status limitless__modctx_mul(limitless_ctx* ctx, limitless_modctx* mc, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b) {
+  limitless_status st = limitless__bigint_mul_signed(ctx, &mc->t, a, b);
+  if (st != LIMITLESS_OK) return st;
+  return limitless__modctx_reduce(ctx, mc, out);
+}
+
+/* maps a value in [0, m) into the reduced domain */
+static limitless_status limitless__modctx_enter(limitless_ctx* ctx, limitless_modctx* mc, limitless_bigint* out, const limitless_bigint* a) {
+  if (mc->mont) return limitless__modctx_mul(ctx, mc, out, a, &mc->r2);
+  return limitless__bigint_copy(ctx, out, a);
+}
+
+/* maps a residue back to its value in [0, m) */
+static limitless_status limitless__modctx_leave(limitless_ctx* ctx, limitless_modctx* mc, limitless_bigint* out, const limitless_bigint* a) {
+  limitless_status st = limitless__bigint_copy(ctx, mc->mont ? &mc->t : out, a);
+  if (st != LIMITLESS_OK || !mc->mont) return st;
+  return limitless__modctx_reduce(ctx, mc, out);
+}
+
+/* the residue of 1: R mod m in Montgomery form, which is 0 when m == 1 */
+static limitless_status limitless__modctx_one(limitless_ctx* ctx, limitless_modctx* mc, limitless_bigint* out) {
+  limitless_status st = limitless__bigint_set_u64(ctx, out, 1u);
+  if (st != LIMITLESS_OK) return st;
+  return limitless__modctx_enter(ctx, mc, out, out);
+}
+
+#define LIMITLESS__POW_MAX_WINDOW 6
+
+/* sliding-window width for a bits-long exponent: each extra bit saves multiplies but doubles the table */
+static int limitless__pow_window(limitless_size bits) {
+  static const limitless_size limits[LIMITLESS__POW_MAX_WINDOW - 1] = {7u, 25u, 81u, 241u, 673u};
+  int w = 1;
+  while (w < LIMITLESS__POW_MAX_WINDOW && bits > limits[w - 1]) ++w;
+  return w;
+}
+
+static int limitless__bigint_bit(const limitless_bigint* a, limitless_size i) {
+  const limitless_limb* al = LIMITLESS_BIGINT_LIMBS(a);
+  return (int)((al[i / LIMITLESS_LIMB_BITS] >> (i % LIMITLESS_LIMB_BITS)) & 1u);
+}
+
+/*
+out = base^e for a residue base and e >= 0, as a residue. The exponent is scanned
+from the top in windows that start and end on a set bit, so each window
+costs its length in squarings plus one multiply by an odd power of base
+from a table of base^1, base^3, ..., base^(2^w - 1).
+*/
+static limitless_status limitless__modctx_pow(limitless_ctx* ctx, limitless_modctx* mc, limitless_bigint* out, const limitless_bigint* base, const limitless_bigint* e) {
+  limitless_bigint tab[1 << (LIMITLESS__POW_MAX_WINDOW - 1)];
+  limitless_bigint acc, g2;
+  limitless_status st = LIMITLESS_OK;
+  limitless_size bits = limitless__bigint_bit_length(e);
+  limitless_size i = bits;
+  int w = limitless__pow_window(bits);
+  int count = 1 << (w - 1);
+  int started = 0;
+  int k;
+
+  if (bits == 0) return limitless__modctx_one(ctx, mc, out);
+  for (k = 0; k < count; ++k) limitless__bigint_init_raw(&tab[k]);
+  limitless__bigint_init_raw(&acc);
+  limitless__bigint_init_raw(&g2);
+
+  st = limitless__bigint_copy(ctx, &tab[0], base); if (st != LIMITLESS_OK) goto cleanup;
+  if (count > 1) {
+    st = limitless__modctx_mul(ctx, mc, &g2, &tab[0], &tab[0]); if (st != LIMITLESS_OK) goto cleanup;
+  }
+  for (k = 1; k < count; ++k) {
+    st = limitless__modctx_mul(ctx, mc, &tab[k], &tab[k - 1], &g2); if (st != LIMITLESS_OK) goto cleanup;
+  }
+
+  while (i > 0) {
+    limitless_size top = i - 1;
+    limitless_size lo;
+    limitless_size j;
+    limitless_size val = 0;
+    if (!limitless__bigint_bit(e, top)) {
+      /* the top bit is set, so acc is already started here */
+      st = limitless__modctx_mul(ctx, mc, &acc, &acc, &acc); if (st != LIMITLESS_OK) goto cleanup;
+      i = top;
+      continue;
+    }
+    lo = (top + 1 > (limitless_size)w) ? top + 1 - (limitless_size)w : 0;
+    while (!limitless__bigint_bit(e, lo)) ++lo;
+    for (j = top + 1; j > lo; --j) {
+      val = (val << 1) | (limitless_size)limitless__bigint_bit(e, j - 1);
+      if (started) {
+        st = limitless__modctx_mul(ctx, mc, &acc, &acc, &acc); if (st != LIMITLESS_OK) goto cleanup;
+      }
+    }
+    if (started) {
+      st = limitless__modctx_mul(ctx, mc, &acc, &acc, &tab[val >> 1]);
+    } else {
+      st = limitless__bigint_copy(ctx, &acc, &tab[val >> 1]);
+      started = 1;
+    }
+    if (st != LIMITLESS_OK) goto cleanup;
+    i = lo;
+  }
+  limitless__bigint_swap(out, &acc);
+
+cleanup:
+  for (k = 0; k < count; ++k) limitless__bigint_clear_raw(ctx, &tab[k]);
+  limitless__bigint_clear_raw(ctx, &acc);
+  limitless__bigint_clear_raw(ctx, &g2);
+  return st;
+}
+
+/*
+Constant-time Montgomery arithmetic for odd moduli. Values live in fixed
+n-limb spans that keep their leading zero limbs, every loop runs a count
+fixed by n or by the exponent's padded length, and choices that depend on
+values (the final subtraction after a product, the table entry for an
+exponent window) are made with masks instead of branches. The built-in
+multiply kernels branch only on the length they are given.
+*/
+#define LIMITLESS__CT_WINDOW 4
+
+/* all ones when x != 0, zero otherwise */
+static limitless_limb limitless__ct_nonzero_mask(limitless_limb x) {
+  limitless_limb top = (limitless_limb)((x | (limitless_limb)(0u - x)) >> (LIMITLESS_LIMB_BITS - 1));
+  return (limitless_limb)(0u - top);
+}
+
+/* r = a - b over n limbs, returning the borrow; r may alias a or b */
+static limitless_limb limitless__ct_sub_n(limitless_limb* r, const limitless_limb* a, const limitless_limb* b, limitless_size n) {
+  limitless_limb borrow = (limitless_limb)0;
+  limitless_size i;
+  for (i = 0; i < n; ++i) {
+    limitless_dlimb d = (limitless_dlimb)a[i] - b[i] - borrow;
+    r[i] = (limitless_limb)d;
+    borrow = (limitless_limb)(d >> (2 * LIMITLESS_LIMB_BITS - 1));
+  }
+  return borrow;
+}
+
+/* r = a where mask is all ones, b where it is zero; r may alias either */
+static void limitless__ct_select(limitless_limb* r, const limitless_limb* a, const limitless_limb* b, limitless_size n, limitless_limb mask) {
+  limitless_size i;
+  for (i = 0; i < n; ++i) r[i] = (limitless_limb)((a[i] & mask) | (b[i] & (limitless_limb)~mask));
+}
+
+/*
+r = a * b * R^-1 mod m for a, b < m, interleaving one row of the product with
+one Montgomery step per limb of b. t holds 2n + 2 limbs of workspace; r may
+alias a or b.
+*/
+static void limitless__ct_mont_mul(const limitless_ctx* ctx, const limitless_modctx* mc, limitless_limb* r, const limitless_limb* a, const limitless_limb* b, limitless_limb* t) {
+  const limitless_limb* mp = LIMITLESS_BIGINT_LIMBS(&mc->m);
+  limitless_size n = mc->n;
+  limitless_size i;
+  limitless_limb borrow;
+  limitless_limb keep;
+  limitless__limbs_zero(t, 2 * n + 2);
+  for (i = 0; i < n; ++i) {
+    limitless_dlimb s = (limitless_dlimb)t[i + n] + ctx->kernels.addmul_1(t + i, a, n, b[i]);
+    t[i + n] = (limitless_limb)s;
+    t[i + n + 1] = (limitless_limb)(s >> LIMITLESS_LIMB_BITS);
+    s = (limitless_dlimb)t[i + n] + ctx->kernels.addmul_1(t + i, mp, n, (limitless_limb)(t[i] * mc->minv));
+    t[i + n] = (limitless_limb)s;
+    t[i + n + 1] = (limitless_limb)(t[i + n + 1] + (limitless_limb)(s >> LIMITLESS_LIMB_BITS));
+  }
+  /* t[n, 2n] is below 2m; subtract m unless that borrows past the top limb */
+  borrow = limitless__ct_sub_n(r, t + n, mp, n);
+  keep = (limitless_limb)(~limitless__ct_nonzero_mask(t[2 * n]) & (limitless_limb)(0u - borrow));
+  limitless__ct_select(r, t + n, r, n, keep);
+}
+
+/* r = tab[k] for a table of count n-limb entries, reading every entry */
+static void limitless__ct_lookup(limitless_limb* r, const limitless_limb* tab, limitless_size count, limitless_size n, limitless_size k) {
+  limitless_size j;
+  limitless_size i;
+  limitless__limbs_zero(r, n);
+  for (j = 0; j < count; ++j) {
+    limitless_limb hit = (limitless_limb)~limitless__ct_nonzero_mask((limitless_limb)(j ^ k));
+    for (i = 0; i < n; ++i) r[i] |= (limitless_limb)(tab[j * n + i] & hit);
+  }
+}
+
+/*
+r = a^e mod m for a < m and an en-limb exponent span, with a, r and the
+result in plain form. The exponent is read in fixed windows of
+LIMITLESS__CT_WINDOW bits from the top of its en limbs, and every window costs
+the same squarings and one multiply by a table entry, zero windows included.
+r2 and one are n-limb copies of R^2 mod m and 1; w holds
+(2^LIMITLESS__CT_WINDOW + 2) * n + 2n + 2 limbs.
+*/
+static void limitless__ct_pow(const limitless_ctx* ctx, const limitless_modctx* mc, limitless_limb* r, const limitless_limb* a, const limitless_limb* e, limitless_size en, const limitless_limb* r2, const limitless_limb* one, limitless_limb* w) {
+  limitless_size n = mc->n;
+  limitless_size count = (limitless_size)1 << LIMITLESS__CT_WINDOW;
+  limitless_limb* tab = w;
+  limitless_limb* acc = tab + count * n;
+  limitless_limb* sel = acc + n;
+  limitless_limb* t = sel + n;
+  limitless_size bit = en * (limitless_size)LIMITLESS_LIMB_BITS;
+  limitless_size k;
+
+  /* tab[k] = a^k R mod m; R^2 * 1 * R^-1 is the Montgomery form of 1 */
+  limitless__ct_mont_mul(ctx, mc, tab, r2, one, t);
+  limitless__ct_mont_mul(ctx, mc, tab + n, a, r2, t);
+  for (k = 2; k < count; ++k) limitless__ct_mont_mul(ctx, mc, tab + k * n, tab + (k - 1) * n, tab + n, t);
+  limitless__limbs_copy(acc, tab, n);
+  /* the window divides the limb width, so no window straddles two limbs */
+  while (bit > 0) {
+    limitless_size digit;
+    bit -= LIMITLESS__CT_WINDOW;
+    for (k = 0; k < LIMITLESS__CT_WINDOW; ++k) limitless__ct_mont_mul(ctx, mc, acc, acc, acc, t);
+    digit = (limitless_size)((e[bit / LIMITLESS_LIMB_BITS] >> (bit % LIMITLESS_LIMB_BITS)) & (limitless_limb)(count - 1));
+    limitless__ct_lookup(sel, tab, count, n, digit);
+    limitless__ct_mont_mul(ctx, mc, acc, acc, sel, t);
+  }
+  limitless__ct_mont_mul(ctx, mc, r, acc, one, t);
+}
+
+/*
+GCD tiers. The Lehmer loop reduces both operands by about one limb per pass
+with a 2x2 cofactor matrix computed from their top two limbs. Above
+ctx->hgcd_threshold limbs, half-gcd (Moller, "On Schonhage's algorithm and
+subquadratic integer gcd computation", 2008) builds that matrix recursively
+from the top limbs so the reduction runs at multiplication speed. Every
+matrix is a product of nonnegative elementary steps with determinant 1, so
+the gcd is preserved whatever the top limbs predict; the size checks below
+only keep the reduced operands positive and above the half-gcd floor s.
+*/
+typedef struct limitless__gcd_matrix {
+  limitless_bigint m[2][2];
+} limitless__gcd_matrix;
+
+static limitless_status limitless__gcd_matrix_init(limitless_ctx* ctx, limitless__gcd_matrix* M) {
+  limitless_status st;
+  limitless__bigint_init_raw(&M->m[0][0]);
+  limitless__bigint_init_raw(&M->m[0][1]);
+  limitless__bigint_init_raw(&M->m[1][0]);
+  limitless__bigint_init_raw(&M->m[1][1]);
+  st = limitless__bigint_set_u64(ctx, &M->m[0][0], 1u);
+  if (st != LIMITLESS_OK) return st;
+  return limitless__bigint_set_u64(ctx, &M->m[1][1], 1u);
+}
+
+static void limitless__gcd_matrix_clear(limitless_ctx* ctx, limitless__gcd_matrix* M) {
+  limitless__bigint_clear_raw(ctx, &M->m[0][0]);
+  limitless__bigint_clear_raw(ctx, &M->m[0][1]);
+  limitless__bigint_clear_raw(ctx, &M->m[1][0]);
+  limitless__bigint_clear_raw(ctx, &M->m[1][1]);
+}
+
+/* out = a * m on magnitudes; out may alias a */
+static limitless_status limitless__bigint_mul_1(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, limitless_limb m) {
+  limitless_size n = a->used;
+  limitless_status st = limitless__bigint_reserve(ctx, out, n + 1);
+  if (st != LIMITLESS_OK) return st;
+  LIMITLESS_BIGINT_LIMBS(out)[n] = ctx->kernels.mul_1(LIMITLESS_BIGINT_LIMBS(out), LIMITLESS_BIGINT_LIMBS(a), n, m);
+  out->used = n + 1;
+  out->sign = 1;
+  limitless__bigint_norm(out);
+  return LIMITLESS_OK;
+}
+
+/* acc += a * m on magnitudes */
+static limitless_status limitless__bigint_addmul_1(limitless_ctx* ctx, limitless_bigint* acc, const limitless_bigint* a, limitless_limb m) {
+  limitless_size i;
+  limitless_size n = (acc->used > a->used) ? acc->used : a->used;
+  limitless_dlimb carry;
+  limitless_status st = limitless__bigint_reserve(ctx, acc, n + 1);
+  if (st != LIMITLESS_OK) return st;
+  for (i = acc->used; i <= n; ++i) LIMITLESS_BIGINT_LIMBS(acc)[i] = (limitless_limb)0;
+  carry = ctx->kernels.addmul_1(LIMITLESS_BIGINT_LIMBS(acc), LIMITLESS_BIGINT_LIMBS(a), a->used, m);
+  for (i = a->used; carry != (limitless_dlimb)0; ++i) {
+    limitless_dlimb p = (limitless_dlimb)LIMITLESS_BIGINT_LIMBS(acc)[i] + carry;
+    LIMITLESS_BIGINT_LIMBS(acc)[i] = (limitless_limb)p;
+    carry = p >> LIMITLESS_LIMB_BITS;
+  }
+  acc->used = n + 1;
+  acc->sign = 1;
+  limitless__bigint_norm(acc);
+  return LIMITLESS_OK;
+}
+
+/* binary gcd of two words; a must be nonzero */
+static limitless_limb limitless__limb_gcd(limitless_limb a, limitless_limb b) {
+  limitless_u32 shift;
+  if (b == (limitless_limb)0) return a;
+  shift = limitless__limb_ctz((limitless_limb)(a | b));
+  a = (limitless_limb)(a >> limitless__limb_ctz(a));
+  while (b != (limitless_limb)0) {
+    b = (limitless_limb)(b >> limitless__limb_ctz(b));
+    if (a > b) {
+      limitless_limb t = a;
+      a = b;
+      b = t;
+    }
+    b = (limitless_limb)(b - a);
+  }
+  return (limitless_limb)(a << shift);
+}
+
+/* the top two limbs of a, after shifting left by shift bits, with limb index n - 1 on top */
+static limitless_dlimb limitless__gcd_top2(const limitless_bigint* a, limitless_size n, limitless_u32 shift) {
+  limitless_limb w[3];
+  limitless_size i;
+  for (i = 0; i < 3; ++i) {
+    w[i] = (n >= i + 1 && n - 1 - i < a->used) ? LIMITLESS_BIGINT_LIMBS(a)[n - 1 - i] : (limitless_limb)0;
+  }
+  if (shift != 0u) {
+    w[0] = (limitless_limb)((w[0] << shift) | (w[1] >> (LIMITLESS_LIMB_BITS - shift)));
+    w[1] = (limitless_limb)((w[1] << shift) | (w[2] >> (LIMITLESS_LIMB_BITS - shift)));
+  }
+  return ((limitless_dlimb)w[0] << LIMITLESS_LIMB_BITS) | (limitless_dlimb)w[1];
+}
+
+/*
+Euclid on the double-limb tops x, y of two operands, recording the steps in
+a matrix M1 with (x; y) = M1 (x'; y'). A step is kept only while both
+remainders stay at or above 2^(LIMB_BITS + 1), which bounds the entries of
+M1 by 2^(LIMB_BITS - 1) and keeps M1^-1 applied to the full operands
+positive. Returns 0 when not even one step qualifies.
+*/
+static int limitless__gcd_lehmer2(limitless_dlimb x, limitless_dlimb y, limitless_limb M1[2][2]) {
+  const limitless_dlimb floor_v = (limitless_dlimb)1 << (LIMITLESS_LIMB_BITS + 1);
+  limitless_dlimb m00 = 1u, m01 = 0u, m10 = 0u, m11 = 1u;
+  int progress = 0;
+  if (x < floor_v || y < floor_v) return 0;
+  for (;;) {
+    limitless_dlimb q;
+    limitless_dlimb r;
+    if (x == y) break;
+    if (x > y) {
+      if (x - y < y) {
+        q = 1u;
+        r = x - y;
+      } else {
+        q = x / y;
+        r = x - q * y;
+      }
+      if (r < floor_v) {
+        /* back off one quotient; the pair then differs by less than the floor and stops */
+        if (q == 1u) break;
+        --q;
+        r += y;
+      }
+      x = r;
+      m01 += q * m00;
+      m11 += q * m10;
+    } else {
+      if (y - x < x) {
+        q = 1u;
+        r = y - x;
+      } else {
+        q = y / x;
+        r = y - q * x;
+      }
+      if (r < floor_v) {
+        if (q == 1u) break;
+        --q;
+        r += x;
+      }
+      y = r;
+      m00 += q * m01;
+      m10 += q * m11;
+    }
+    progress = 1;
+  }
+  M1[0][0] = (limitless_limb)m00;
+  M1[0][1] = (limitless_limb)m01;
+  M1[1][0] = (limitless_limb)m10;
+  M1[1][1] = (limitless_limb)m11;
+  return progress;
+}
+
+/* (a; b) = M1^-1 (a; b) = (m11 a - m01 b; m00 b - m10 a) */
+static limitless_status limitless__gcd_apply_1(limitless_ctx* ctx, limitless_bigint* a, limitless_bigint* b, limitless_limb M1[2][2], limitless_bigint* t0, limitless_bigint* t1) {
+  limitless_status st;
+  st = limitless__bigint_mul_1(ctx, t0, a, M1[1][1]); if (st != LIMITLESS_OK) return st;
+  st = limitless__bigint_mul_1(ctx, t1, b, M1[0][1]); if (st != LIMITLESS_OK) return st;
+  limitless__mag_sub_inplace(ctx, t0, t1);
+  st = limitless__bigint_mul_1(ctx, t1, a, M1[1][0]); if (st != LIMITLESS_OK) return st;
+  st = limitless__bigint_mul_1(ctx, b, b, M1[0][0]); if (st != LIMITLESS_OK) return st;
+  limitless__mag_sub_inplace(ctx, b, t1);
+  limitless__bigint_swap(a, t0);
+  return LIMITLESS_OK;
+}
+
+/* M = M * M1 for a single-limb M1 */
+static limitless_status limitless__gcd_matrix_mul_1(limitless_ctx* ctx, limitless__gcd_matrix* M, limitless_limb M1[2][2], limitless_bigint* t0, limitless_bigint* t1) {
+  int i;
+  limitless_status st;
+  for (i = 0; i < 2; ++i) {
+    st = limitless__bigint_mul_1(ctx, t0, &M->m[i][0], M1[0][0]); if (st != LIMITLESS_OK) return st;
+    st = limitless__bigint_addmul_1(ctx, t0, &M->m[i][1], M1[1][0]); if (st != LIMITLESS_OK) return st;
+    st = limitless__bigint_mul_1(ctx, t1, &M->m[i][0], M1[0][1]); if (st != LIMITLESS_OK) return st;
+    st = limitless__bigint_addmul_1(ctx, t1, &M->m[i][1], M1[1][1]); if (st != LIMITLESS_OK) return st;
+    limitless__bigint_swap(&M->m[i][0], t0);
+    limitless__bigint_swap(&M->m[i][1], t1);
+  }
+  return LIMITLESS_OK;
+}
+
+/* M = M * M1 */
+static limitless_status limitless__gcd_matrix_mul(limitless_ctx* ctx, limitless__gcd_matrix* M, const limitless__gcd_matrix* M1) {
+  limitless_bigint t0, t1, p;
+  limitless_status st = LIMITLESS_OK;
+  int i;
+  limitless__bigint_init_raw(&t0);
+  limitless__bigint_init_raw(&t1);
+  limitless__bigint_init_raw(&p);
+  for (i = 0; i < 2; ++i) {
+    st = limitless__mag_mul(ctx, &t0, &M->m[i][0], &M1->m[0][0]); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__mag_mul(ctx, &p, &M->m[i][1], &M1->m[1][0]); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__mag_add(ctx, &t0, &t0, &p); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__mag_mul(ctx, &t1, &M->m[i][0], &M1->m[0][1]); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__mag_mul(ctx, &p, &M->m[i][1], &M1->m[1][1]); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__mag_add(ctx, &t1, &t1, &p); if (st != LIMITLESS_OK) goto cleanup;
+    limitless__bigint_swap(&M->m[i][0], &t0);
+    limitless__bigint_swap(&M->m[i][1], &t1);
+  }
+cleanup:
+  limitless__bigint_clear_raw(ctx, &t0);
+  limitless__bigint_clear_raw(ctx, &t1);
+  limitless__bigint_clear_raw(ctx, &p);
+  return st;
+}
+
+/* column j of M absorbs q times column 1 - j: the step that subtracted q copies of the other operand */
+static limitless_status limitless__gcd_matrix_step(limitless_ctx* ctx, limitless__gcd_matrix* M, int j, const limitless_bigint* q, limitless_bigint* t) {
+  int i;
+  limitless_status st;
+  for (i = 0; i < 2; ++i) {
+    if (q->used == 1) {
+      st = limitless__bigint_addmul_1(ctx, &M->m[i][j], &M->m[i][1 - j], LIMITLESS_BIGINT_LIMBS(q)[0]);
+    } else {
+      st = limitless__mag_mul(ctx, t, &M->m[i][1 - j], q);
+      if (st == LIMITLESS_OK) st = limitless__mag_add(ctx, &M->m[i][j], &M->m[i][j], t);
+    }
+    if (st != LIMITLESS_OK) return st;
+  }
+  return LIMITLESS_OK;
+}
+
+/*
+One reduction step that keeps both operands above s limbs: a Lehmer pass
+when the operands are long enough for the top-limb matrix to be safe,
+otherwise one division of the larger by the smaller, backed off by one
+quotient if the remainder would drop to s limbs. *progress is 0 when no
+step is possible. M may be NULL when the cofactors are not needed.
+*/
+static limitless_status limitless__hgcd_step(limitless_ctx* ctx, limitless_bigint* a, limitless_bigint* b, limitless_size s, limitless__gcd_matrix* M, int* progress) {
+  limitless_size n = (a->used > b->used) ? a->used : b->used;
+  limitless_bigint t0, t1, q;
+  limitless_bigint* big;
+  limitless_bigint* small;
+  limitless_status st = LIMITLESS_OK;
+  int c;
+  *progress = 0;
+  limitless__bigint_init_raw(&t0);
+  limitless__bigint_init_raw(&t1);
+  limitless__bigint_init_raw(&q);
+
+  if (n >= s + 2) {
+    limitless_limb M1[2][2];
+    limitless_limb top = (limitless_limb)(((a->used == n) ? LIMITLESS_BIGINT_LIMBS(a)[n - 1] : 0u) | ((b->used == n) ? LIMITLESS_BIGINT_LIMBS(b)[n - 1] : 0u));
+    limitless_u32 shift = limitless__limb_clz(top);
+    if (limitless__gcd_lehmer2(limitless__gcd_top2(a, n, shift), limitless__gcd_top2(b, n, shift), M1)) {
+      st = limitless__gcd_apply_1(ctx, a, b, M1, &t0, &t1);
+      if (st == LIMITLESS_OK && M) st = limitless__gcd_matrix_mul_1(ctx, M, M1, &t0, &t1);
+      if (st == LIMITLESS_OK) *progress = 1;
+      goto cleanup;
+    }
+  }
+
+  c = limitless__mag_cmp(a, b);
+  if (c == 0) goto cleanup;
+  big = (c > 0) ? a : b;
+  small = (c > 0) ? b : a;
+  if (small->used <= s) goto cleanup;
+  st = limitless__mag_sub(ctx, &t0, big, small); if (st != LIMITLESS_OK) goto cleanup;
+  if (t0.used <= s) goto cleanup;
+  st = limitless__bigint_divmod_abs(ctx, &q, &t1, big, small); if (st != LIMITLESS_OK) goto cleanup;
+  if (t1.used <= s) {
+    /* the quotient is at least 2 here because big - small already cleared s limbs */
+    limitless_limb one = (limitless_limb)1;
+    limitless_bigint unit;
+    unit.sign = 1;
+    unit.used = 1;
+    unit.cap = 1;
+    unit.limbs = &one;
+    st = limitless__mag_add(ctx, &t1, &t1, small); if (st != LIMITLESS_OK) goto cleanup;
+    limitless__mag_sub_inplace(ctx, &q, &unit);
+  }
+  limitless__bigint_swap(big, &t1);
+  if (M) st = limitless__gcd_matrix_step(ctx, M, (big == a) ? 1 : 0, &q, &t0);
+  if (st == LIMITLESS_OK) *progress = 1;
+
+cleanup:
+  limitless__bigint_clear_raw(ctx, &t0);
+  limitless__bigint_clear_raw(ctx, &t1);
+  limitless__bigint_clear_raw(ctx, &q);
+  return st;
+}
+
+/*
+(a; b) = M^-1 (a; b) given the already reduced tops ah, bh of a >> p limbs
+and b >> p limbs: only the low p limbs need the matrix, and the sum is
+positive because the tops stay larger than the entries of M times B.
+*/
+static limitless_status limitless__gcd_adjust(limitless_ctx* ctx, limitless_bigint* a, limitless_bigint* b, const limitless_bigint* ah, const limitless_bigint* bh, const limitless__gcd_matrix* M, limitless_size p) {
+  limitless_bigint al, bl, x, y, t;
+  limitless_status st;
+  limitless__bigint_init_raw(&al);
+  limitless__bigint_init_raw(&bl);
+  limitless__bigint_init_raw(&x);
+  limitless__bigint_init_raw(&y);
+  limitless__bigint_init_raw(&t);
+  st = limitless__bigint_slice(ctx, &al, a, 0, p); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_slice(ctx, &bl, b, 0, p); if (st != LIMITLESS_OK) goto cleanup;
+
+  st = limitless__bigint_mul_signed(ctx, &x, &M->m[1][1], &al); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_mul_signed(ctx, &t, &M->m[0][1], &bl); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_sub_signed(ctx, &x, &x, &t); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_shl_bits(ctx, &t, ah, p * (limitless_size)LIMITLESS_LIMB_BITS); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_add_signed(ctx, &x, &x, &t); if (st != LIMITLESS_OK) goto cleanup;
+
+  st = limitless__bigint_mul_signed(ctx, &y, &M->m[0][0], &bl); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_mul_signed(ctx, &t, &M->m[1][0], &al); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_sub_signed(ctx, &y, &y, &t); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_shl_bits(ctx, &t, bh, p * (limitless_size)LIMITLESS_LIMB_BITS); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_add_signed(ctx, &y, &y, &t); if (st != LIMITLESS_OK) goto cleanup;
+
+  limitless__bigint_swap(a, &x);
+  limitless__bigint_swap(b, &y);
+
+cleanup:
+  limitless__bigint_clear_raw(ctx, &al);
+  limitless__bigint_clear_raw(ctx, &bl);
+  limitless__bigint_clear_raw(ctx, &x);
+  limitless__bigint_clear_raw(ctx, &y);
+  limitless__bigint_clear_raw(ctx, &t);
+  return st;
+}
+
+static limitless_status limitless__hgcd(limitless_ctx* ctx, limitless_bigint* a, limitless_bigint* b, limitless__gcd_matrix* M, int* progress);
+
+/* reduce the tops a >> p, b >> p recursively, then carry the matrix down to the full operands */
+static limitless_status limitless__hgcd_reduce(limitless_ctx* ctx, limitless_bigint* a, limitless_bigint* b, limitless__gcd_matrix* M, limitless_size p, int* progress) {
+  limitless_bigint ah, bh;
+  limitless__gcd_matrix M1;
+  limitless_status st;
+  int sub = 0;
+  limitless__bigint_init_raw(&ah);
+  limitless__bigint_init_raw(&bh);
+  st = limitless__gcd_matrix_init(ctx, &M1); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_slice(ctx, &ah, a, p, a->used); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_slice(ctx, &bh, b, p, b->used); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__hgcd(ctx, &ah, &bh, &M1, &sub); if (st != LIMITLESS_OK) goto cleanup;
+  if (sub) {
+    st = limitless__gcd_adjust(ctx, a, b, &ah, &bh, &M1, p); if (st != LIMITLESS_OK) goto cleanup;
+    if (M) st = limitless__gcd_matrix_mul(ctx, M, &M1);
+    if (st == LIMITLESS_OK) *progress = 1;
+  }
+cleanup:
+  limitless__bigint_clear_raw(ctx, &ah);
+  limitless__bigint_clear_raw(ctx, &bh);
+  limitless__gcd_matrix_clear(ctx, &M1);
+  return st;
+}
+
+/*
+Half-gcd: with n the longer operand length and s = n / 2 + 1, reduce (a, b)
+in place to M^-1 (a, b) while both stay above s limbs, accumulating the
+steps into M. Large inputs recurse twice on top halves, with single steps in
+between, as in Moller's algorithm.
+*/
+static limitless_status limitless__hgcd(limitless_ctx* ctx, limitless_bigint* a, limitless_bigint* b, limitless__gcd_matrix* M, int* progress) {
+  limitless_size n = (a->used > b->used) ? a->used : b->used;
+  limitless_size s = n / 2 + 1;
+  limitless_status st = LIMITLESS_OK;
+  int step = 1;
+  *progress = 0;
+  if (a->used <= s || b->used <= s) return LIMITLESS_OK;
+
+  if (n >= ctx->hgcd_threshold) {
+    limitless_size n2 = (3 * n) / 4 + 1;
+    limitless_size cur;
+    st = limitless__hgcd_reduce(ctx, a, b, M, n / 2, progress);
+    if (st != LIMITLESS_OK) return st;
+    while (step && ((a->used > b->used) ? a->used : b->used) > n2) {
+      st = limitless__hgcd_step(ctx, a, b, s, M, &step);
+      if (st != LIMITLESS_OK) return st;
+      if (step) *progress = 1;
+    }
+    cur = (a->used > b->used) ? a->used : b->used;
+    if (step && cur > s + 2) {
+      st = limitless__hgcd_reduce(ctx, a, b, M, 2 * s - cur + 1, progress);
+      if (st != LIMITLESS_OK) return st;
+    }
+  }
+  while (step) {
+    st = limitless__hgcd_step(ctx, a, b, s, M, &step);
+    if (st != LIMITLESS_OK) return st;
+    if (step) *progress = 1;
+  }
+  return LIMITLESS_OK;
+}
+
+static limitless_status limitless__bigint_gcd(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* b) {
+  limitless_bigint u, v, t0, t1;
+  limitless_status st;
+  limitless__bigint_init_raw(&u);
+  limitless__bigint_init_raw(&v);
+  limitless__bigint_init_raw(&t0);
+  limitless__bigint_init_raw(&t1);
+  st = limitless__bigint_abs_copy(ctx, &u, a); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_abs_copy(ctx, &v, b); if (st != LIMITLESS_OK) goto cleanup;
+
+  for (;;) {
+    limitless_limb M1[2][2];
+    limitless_u32 shift;
+    if (limitless__mag_cmp(&u, &v) < 0) limitless__bigint_swap(&u, &v);
+    if (v.used == 0) break;
+    if (v.used == 1) {
+      /* single-limb tail: one reduction by the precomputed divisor, then word Euclid */
+      limitless__divisor dv;
+      limitless_limb r;
+      limitless__divisor_init(&dv, LIMITLESS_BIGINT_LIMBS(&v)[0]);
+      r = limitless__span_divrem_1(NULL, LIMITLESS_BIGINT_LIMBS(&u), u.used, &dv);
+      LIMITLESS_BIGINT_LIMBS(&v)[0] = limitless__limb_gcd(LIMITLESS_BIGINT_LIMBS(&v)[0], r);
+      limitless__bigint_swap(&u, &v);
+      break;
+    }
+    if (v.used >= ctx->hgcd_threshold && u.used - v.used < v.used / 2) {
+      /* half-gcd on the top third removes about a sixth of the operand per round */
+      limitless_size p = (2 * u.used) / 3;
+      int progress = 0;
+      st = limitless__hgcd_reduce(ctx, &u, &v, NULL, p, &progress);
+      if (st != LIMITLESS_OK) goto cleanup;
+      if (progress) continue;
+    } else if (u.used - v.used <= 1) {
+      shift = limitless__limb_clz((limitless_limb)(LIMITLESS_BIGINT_LIMBS(&u)[u.used - 1] | ((v.used == u.used) ? LIMITLESS_BIGINT_LIMBS(&v)[u.used - 1] : 0u)));
+      if (limitless__gcd_lehmer2(limitless__gcd_top2(&u, u.used, shift), limitless__gcd_top2(&v, u.used, shift), M1)) {
+        st = limitless__gcd_apply_1(ctx, &u, &v, M1, &t0, &t1);
+        if (st != LIMITLESS_OK) goto cleanup;
+        continue;
+      }
+    }
+    st = limitless__bigint_divmod_abs(ctx, &t0, &t1, &u, &v); if (st != LIMITLESS_OK) goto cleanup;
+    limitless__bigint_swap(&u, &t1);
+  }
+
+  st = limitless__bigint_copy(ctx, out, &u);
+  if (st == LIMITLESS_OK && out->used > 0) out->sign = 1;
+
+cleanup:
+  limitless__bigint_clear_raw(ctx, &u);
+  limitless__bigint_clear_raw(ctx, &v);
+  limitless__bigint_clear_raw(ctx, &t0);
+  limitless__bigint_clear_raw(ctx, &t1);
+  return st;
+}
+
+/*
+Extended gcd. The loop is limitless__bigint_gcd's, with every matrix it
+applies to (u; v) applied as well to the cofactors (su; sv) of |a|, kept so
+that u == su |a| and v == sv |a| modulo |b|. A Lehmer pass costs the
+cofactors four word multiplies and a half-gcd round one matrix product, and
+the last two words run Euclid to the end in a word matrix, so most quotients
+never touch a big number. The cofactor of |b| is not tracked; callers that
+need it get it from one exact division.
+*/
+
+/* out = a * m keeping the sign of a; out may alias a */
+static limitless_status limitless__bigint_mul_1_signed(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, limitless_limb m) {
+  int sign = a->sign;
+  limitless_status st = limitless__bigint_mul_1(ctx, out, a, m);
+  if (st == LIMITLESS_OK && out->used != 0) out->sign = sign;
+  return st;
+}
+
+/* (x; y) = M1^-1 (x; y) on signed cofactors, the companion of limitless__gcd_apply_1 */
+static limitless_status limitless__gcdext_apply_1(limitless_ctx* ctx, limitless_bigint* x, limitless_bigint* y, limitless_limb M1[2][2], limitless_bigint* t0, limitless_bigint* t1) {
+  limitless_status st;
+  st = limitless__bigint_mul_1_signed(ctx, t0, x, M1[1][1]); if (st != LIMITLESS_OK) return st;
+  st = limitless__bigint_mul_1_signed(ctx, t1, y, M1[0][1]); if (st != LIMITLESS_OK) return st;
+  st = limitless__bigint_sub_signed(ctx, t0, t0, t1); if (st != LIMITLESS_OK) return st;
+  st = limitless__bigint_mul_1_signed(ctx, t1, x, M1[1][0]); if (st != LIMITLESS_OK) return st;
+  st = limitless__bigint_mul_1_signed(ctx, y, y, M1[0][0]); if (st != LIMITLESS_OK) return st;
+  st = limitless__bigint_sub_signed(ctx, y, y, t1); if (st != LIMITLESS_OK) return st;
+  limitless__bigint_swap(x, t0);
+  return LIMITLESS_OK;
+}
+
+/* (x; y) = M^-1 (x; y) on signed cofactors for a half-gcd matrix */
+static limitless_status limitless__gcdext_apply(limitless_ctx* ctx, limitless_bigint* x, limitless_bigint* y, const limitless__gcd_matrix* M, limitless_bigint* t0, limitless_bigint* t1) {
+  limitless_status st;
+  st = limitless__bigint_mul_signed(ctx, t0, &M->m[1][1], x); if (st != LIMITLESS_OK) return st;
+  st = limitless__bigint_mul_signed(ctx, t1, &M->m[0][1], y); if (st != LIMITLESS_OK) return st;
+  st = limitless__bigint_sub_signed(ctx, t0, t0, t1); if (st != LIMITLESS_OK) return st;
+  st = limitless__bigint_mul_signed(ctx, t1, &M->m[1][0], x); if (st != LIMITLESS_OK) return st;
+  limitless__bigint_swap(x, t0);
+  st = limitless__bigint_mul_signed(ctx, t0, &M->m[0][0], y); if (st != LIMITLESS_OK) return st;
+  return limitless__bigint_sub_signed(ctx, y, t0, t1);
+}
+
+/*
+Euclid to the end on two words, with (x; y) = M1 (x'; y') for the final
+pair, one of which is zero. The entries never exceed the larger input.
+*/
+static void limitless__limb_gcdext(limitless_limb* x, limitless_limb* y, limitless_limb M1[2][2]) {
+  limitless_limb m00 = 1u, m01 = 0u, m10 = 0u, m11 = 1u;
+  while (*x != (limitless_limb)0 && *y != (limitless_limb)0) {
+    limitless_limb q;
+    if (*x >= *y) {
+      q = (limitless_limb)(*x / *y);
+      *x = (limitless_limb)(*x - q * *y);
+      m01 = (limitless_limb)(m01 + q * m00);
+      m11 = (limitless_limb)(m11 + q * m10);
+    } else {
+      q = (limitless_limb)(*y / *x);
+      *y = (limitless_limb)(*y - q * *x);
+      m00 = (limitless_limb)(m00 + q * m01);
+      m10 = (limitless_limb)(m10 + q * m11);
     }
-    limitless__bigint_clear_raw(ctx, &tmp);
-    if (st != LIMITLESS_OK) goto cleanup;
   }
-  if (out->used > 0) out->sign = 1;
+  M1[0][0] = m00;
+  M1[0][1] = m01;
+  M1[1][0] = m10;
+  M1[1][1] = m11;
+}
+
+/* g = gcd(|a|, |b|) and s with s |a| == g (mod |b|), s not reduced */
+static limitless_status limitless__bigint_gcd_cofactor(limitless_ctx* ctx, limitless_bigint* g, limitless_bigint* s, const limitless_bigint* a, const limitless_bigint* b) {
+  limitless_bigint u, v, su, sv, t0, t1;
+  limitless_status st;
+  limitless__bigint_init_raw(&u);
+  limitless__bigint_init_raw(&v);
+  limitless__bigint_init_raw(&su);
+  limitless__bigint_init_raw(&sv);
+  limitless__bigint_init_raw(&t0);
+  limitless__bigint_init_raw(&t1);
+  st = limitless__bigint_abs_copy(ctx, &u, a); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_abs_copy(ctx, &v, b); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_set_u64(ctx, &su, 1u); if (st != LIMITLESS_OK) goto cleanup;
+
+  for (;;) {
+    limitless_limb M1[2][2];
+    limitless_u32 shift;
+    if (limitless__mag_cmp(&u, &v) < 0) {
+      limitless__bigint_swap(&u, &v);
+      limitless__bigint_swap(&su, &sv);
+    }
+    if (v.used == 0) break;
+    if (u.used == 1) {
+      limitless_limb x = LIMITLESS_BIGINT_LIMBS(&u)[0];
+      limitless_limb y = LIMITLESS_BIGINT_LIMBS(&v)[0];
+      limitless__limb_gcdext(&x, &y, M1);
+      LIMITLESS_BIGINT_LIMBS(&u)[0] = x;
+      LIMITLESS_BIGINT_LIMBS(&v)[0] = y;
+      limitless__bigint_norm(&u);
+      limitless__bigint_norm(&v);
+      st = limitless__gcdext_apply_1(ctx, &su, &sv, M1, &t0, &t1);
+      if (st != LIMITLESS_OK) goto cleanup;
+      continue;
+    }
+    if (v.used >= ctx->hgcd_threshold && u.used - v.used < v.used / 2) {
+      limitless_size p = (2 * u.used) / 3;
+      limitless__gcd_matrix M;
+      int progress = 0;
+      st = limitless__gcd_matrix_init(ctx, &M);
+      if (st == LIMITLESS_OK) st = limitless__hgcd_reduce(ctx, &u, &v, &M, p, &progress);
+      if (st == LIMITLESS_OK && progress) st = limitless__gcdext_apply(ctx, &su, &sv, &M, &t0, &t1);
+      limitless__gcd_matrix_clear(ctx, &M);
+      if (st != LIMITLESS_OK) goto cleanup;
+      if (progress) continue;
+    } else if (u.used - v.used <= 1) {
+      shift = limitless__limb_clz((limitless_limb)(LIMITLESS_BIGINT_LIMBS(&u)[u.used - 1] | ((v.used == u.used) ? LIMITLESS_BIGINT_LIMBS(&v)[u.used - 1] : 0u)));
+      if (limitless__gcd_lehmer2(limitless__gcd_top2(&u, u.used, shift), limitless__gcd_top2(&v, u.used, shift), M1)) {
+        st = limitless__gcd_apply_1(ctx, &u, &v, M1, &t0, &t1); if (st != LIMITLESS_OK) goto cleanup;
+        st = limitless__gcdext_apply_1(ctx, &su, &sv, M1, &t0, &t1); if (st != LIMITLESS_OK) goto cleanup;
+        continue;
+      }
+    }
+    /* u = u - q v, su = su - q sv */
+    st = limitless__bigint_divmod_abs(ctx, &t0, &t1, &u, &v); if (st != LIMITLESS_OK) goto cleanup;
+    limitless__bigint_swap(&u, &t1);
+    st = limitless__bigint_mul_signed(ctx, &t1, &t0, &sv); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__bigint_sub_signed(ctx, &su, &su, &t1); if (st != LIMITLESS_OK) goto cleanup;
+  }
+
+  limitless__bigint_swap(g, &u);
+  limitless__bigint_swap(s, &su);
 
 cleanup:
   limitless__bigint_clear_raw(ctx, &u);
   limitless__bigint_clear_raw(ctx, &v);
+  limitless__bigint_clear_raw(ctx, &su);
+  limitless__bigint_clear_raw(ctx, &sv);
+  limitless__bigint_clear_raw(ctx, &t0);
+  limitless__bigint_clear_raw(ctx, &t1);
+  return st;
+}
+
+/*
+g = gcd(a, b) >= 0 and s a + t b = g, with |s| <= |b| / (2 g) when b != 0;
+gcd(a, 0) gives s = sign(a) and t = 0. s and t may be NULL.
+*/
+static limitless_status limitless__bigint_gcdext(limitless_ctx* ctx, limitless_bigint* g, limitless_bigint* s, limitless_bigint* t, const limitless_bigint* a, const limitless_bigint* b) {
+  limitless_bigint rg, rs, bg, x;
+  limitless_status st;
+  limitless__bigint_init_raw(&rg);
+  limitless__bigint_init_raw(&rs);
+  limitless__bigint_init_raw(&bg);
+  limitless__bigint_init_raw(&x);
+  st = limitless__bigint_gcd_cofactor(ctx, &rg, &rs, a, b); if (st != LIMITLESS_OK) goto cleanup;
+  if (a->used == 0) {
+    rs.used = 0;
+    rs.sign = 0;
+  } else if (a->sign < 0) {
+    rs.sign = -rs.sign;
+  }
+
+  if (b->used != 0 && (s || t)) {
+    /* the cofactors repeat with period |b| / g in s; pick the representative nearest zero */
+    if (limitless__bigint_is_one(&rg)) {
+      st = limitless__bigint_abs_copy(ctx, &bg, b);
+    } else {
+      st = limitless__bigint_div_exact(ctx, &bg, b, &rg);
+      bg.sign = 1;
+    }
+    if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__bigint_mod(ctx, &x, &rs, &bg); if (st != LIMITLESS_OK) goto cleanup;
+    if (x.sign < 0) {
+      st = limitless__bigint_add_signed(ctx, &x, &x, &bg); if (st != LIMITLESS_OK) goto cleanup;
+    }
+    st = limitless__mag_add(ctx, &rs, &x, &x); if (st != LIMITLESS_OK) goto cleanup;
+    if (limitless__mag_cmp(&rs, &bg) > 0) {
+      st = limitless__bigint_sub_signed(ctx, &x, &x, &bg); if (st != LIMITLESS_OK) goto cleanup;
+    }
+    limitless__bigint_swap(&rs, &x);
+    if (t) {
+      /* t = (g - s a) / b */
+      st = limitless__bigint_mul_signed(ctx, &x, &rs, a); if (st != LIMITLESS_OK) goto cleanup;
+      st = limitless__bigint_sub_signed(ctx, &x, &rg, &x); if (st != LIMITLESS_OK) goto cleanup;
+      st = limitless__bigint_div_exact(ctx, t, &x, b); if (st != LIMITLESS_OK) goto cleanup;
+    }
+  } else if (t) {
+    t->used = 0;
+    t->sign = 0;
+  }
+  if (s) limitless__bigint_swap(s, &rs);
+  limitless__bigint_swap(g, &rg);
+
+cleanup:
+  limitless__bigint_clear_raw(ctx, &rg);
+  limitless__bigint_clear_raw(ctx, &rs);
+  limitless__bigint_clear_raw(ctx, &bg);
+  limitless__bigint_clear_raw(ctx, &x);
+  return st;
+}
+
+/* out = a^-1 mod |m| in [0, |m|); EDIVZERO when m is zero or shares a factor with a */
+static limitless_status limitless__bigint_invmod(limitless_ctx* ctx, limitless_bigint* out, const limitless_bigint* a, const limitless_bigint* m) {
+  limitless_bigint g, s, r;
+  limitless_status st;
+  if (m->used == 0) return LIMITLESS_EDIVZERO;
+  limitless__bigint_init_raw(&g);
+  limitless__bigint_init_raw(&s);
+  limitless__bigint_init_raw(&r);
+  st = limitless__bigint_gcd_cofactor(ctx, &g, &s, a, m); if (st != LIMITLESS_OK) goto cleanup;
+  if (!limitless__bigint_is_one(&g)) {
+    st = LIMITLESS_EDIVZERO;
+    goto cleanup;
+  }
+  if (a->sign < 0) s.sign = -s.sign;
+  st = limitless__bigint_mod(ctx, &r, &s, m); if (st != LIMITLESS_OK) goto cleanup;
+  if (r.sign < 0) {
+    st = limitless__mag_sub(ctx, &s, m, &r); if (st != LIMITLESS_OK) goto cleanup;
+    limitless__bigint_swap(&r, &s);
+  }
+  limitless__bigint_swap(out, &r);
+
+cleanup:
+  limitless__bigint_clear_raw(ctx, &g);
+  limitless__bigint_clear_raw(ctx, &s);
+  limitless__bigint_clear_raw(ctx, &r);
   return st;
 }
 
@@ -1231,7 +3702,13 @@ static void limitless__rational_clear(limitless_ctx* ctx, limitless_rational* r)
 }
 
 static limitless_status limitless__rational_copy(limitless_ctx* ctx, limitless_rational* dst, const limitless_rational* src) {
-  limitless_status st = limitless__bigint_copy(ctx, &dst->num, &src->num);
+  limitless_status st;
+  /* reserve both parts first so a failure leaves dst untouched */
+  st = limitless__bigint_reserve_exact(ctx, &dst->num, src->num.used);
+  if (st != LIMITLESS_OK) return st;
+  st = limitless__bigint_reserve_exact(ctx, &dst->den, src->den.used);
+  if (st != LIMITLESS_OK) return st;
+  st = limitless__bigint_copy(ctx, &dst->num, &src->num);
   if (st != LIMITLESS_OK) return st;
   st = limitless__bigint_copy(ctx, &dst->den, &src->den);
   if (st != LIMITLESS_OK) return st;
@@ -1290,7 +3767,7 @@ cleanup:
 }
 
 static int limitless__rational_den_is_one(const limitless_rational* r) {
-  return r->den.used == 1 && r->den.sign == 1 && r->den.limbs[0] == (limitless_limb)1;
+  return r->den.used == 1 && r->den.sign == 1 && LIMITLESS_BIGINT_LIMBS(&r->den)[0] == (limitless_limb)1;
 }
 
 static void limitless__number_swap(limitless_number* a, limitless_number* b) {
@@ -1299,6 +3776,30 @@ static void limitless__number_swap(limitless_number* a, limitless_number* b) {
   *b = t;
 }
 
+/*
+Move a finished result into out without copying limbs. The source is left
+holding out's previous storage (or nothing), and the caller clears it, so
+these cannot fail and are only used after every fallible step is done.
+*/
+static void limitless__number_take_int(limitless_ctx* ctx, limitless_number* out, limitless_bigint* v) {
+  if (out->kind != LIMITLESS_KIND_INT) limitless_number_clear(ctx, out);
+  limitless__bigint_swap(&out->v.i, v);
+}
+
+static void limitless__number_take_rational(limitless_ctx* ctx, limitless_number* out, limitless_rational* r) {
+  if (limitless__rational_den_is_one(r)) {
+    limitless__number_take_int(ctx, out, &r->num);
+    return;
+  }
+  if (out->kind != LIMITLESS_KIND_RAT) {
+    limitless_number_clear(ctx, out);
+    out->kind = LIMITLESS_KIND_RAT;
+    limitless__rational_init(&out->v.r);
+  }
+  limitless__bigint_swap(&out->v.r.num, &r->num);
+  limitless__bigint_swap(&out->v.r.den, &r->den);
+}
+
 static limitless_status limitless__number_to_rational_copy(limitless_ctx* ctx, limitless_rational* out, const limitless_number* n) {
   if (n->kind == LIMITLESS_KIND_INT) {
     return limitless__rational_set_int(ctx, out, &n->v.i);
@@ -1309,6 +3810,149 @@ static limitless_status limitless__number_to_rational_copy(limitless_ctx* ctx, l
   return LIMITLESS_EINVAL;
 }
 
+/*
+Henrici's reduced rational arithmetic (Knuth, TAOCP vol. 2, 4.5.1). With both
+operands in lowest terms and positive denominators, the only factors that can
+cancel across a product are gcd(n1, d2) and gcd(n2, d1), and the only factor
+that can cancel from a sum is one shared with gcd(d1, d2). Every gcd therefore
+runs on operand-size inputs and the full cross products are never formed.
+*/
+static int limitless__bigint_is_unit(const limitless_bigint* a) {
+  return a->used == 1 && LIMITLESS_BIGINT_LIMBS(a)[0] == (limitless_limb)1;
+}
+
+static limitless_status limitless__rational_cancel(limitless_ctx* ctx, limitless_bigint* xo, limitless_bigint* yo, const limitless_bigint* x, const limitless_bigint* y) {
+  limitless_status st;
+  limitless_bigint g;
+  if (limitless__bigint_is_unit(x) || limitless__bigint_is_unit(y)) {
+    st = limitless__bigint_copy(ctx, xo, x);
+    if (st != LIMITLESS_OK) return st;
+    return limitless__bigint_copy(ctx, yo, y);
+  }
+  limitless__bigint_init_raw(&g);
+  st = limitless__bigint_gcd(ctx, &g, x, y);
+  if (st != LIMITLESS_OK) goto cleanup;
+  if (limitless__bigint_is_one(&g)) {
+    st = limitless__bigint_copy(ctx, xo, x);
+    if (st == LIMITLESS_OK) st = limitless__bigint_copy(ctx, yo, y);
+  } else {
+    st = limitless__bigint_div_exact(ctx, xo, x, &g);
+    if (st == LIMITLESS_OK) st = limitless__bigint_div_exact(ctx, yo, y, &g);
+  }
+cleanup:
+  limitless__bigint_clear_raw(ctx, &g);
+  return st;
+}
+
+/* out = (n1/d1) * (n2/d2); d2 may be negative (division), the sign moves to num. */
+static limitless_status limitless__rational_mul_reduced(limitless_ctx* ctx, limitless_rational* out, const limitless_bigint* n1, const limitless_bigint* d1, const limitless_bigint* n2, const limitless_bigint* d2) {
+  limitless_status st;
+  limitless_bigint a1, a2, e1, e2;
+  if (n1->used == 0 || n2->used == 0) {
+    st = limitless__bigint_set_u64(ctx, &out->den, 1);
+    if (st != LIMITLESS_OK) return st;
+    out->num.used = 0;
+    out->num.sign = 0;
+    return LIMITLESS_OK;
+  }
+  limitless__bigint_init_raw(&a1);
+  limitless__bigint_init_raw(&a2);
+  limitless__bigint_init_raw(&e1);
+  limitless__bigint_init_raw(&e2);
+  st = limitless__rational_cancel(ctx, &a1, &e2, n1, d2);
+  if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__rational_cancel(ctx, &a2, &e1, n2, d1);
+  if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_mul_signed(ctx, &out->num, &a1, &a2);
+  if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_mul_signed(ctx, &out->den, &e1, &e2);
+  if (st != LIMITLESS_OK) goto cleanup;
+  if (out->den.sign < 0) {
+    out->den.sign = 1;
+    out->num.sign = -out->num.sign;
+  }
+cleanup:
+  limitless__bigint_clear_raw(ctx, &a1);
+  limitless__bigint_clear_raw(ctx, &a2);
+  limitless__bigint_clear_raw(ctx, &e1);
+  limitless__bigint_clear_raw(ctx, &e2);
+  return st;
+}
+
+/* out = (n1/d1) + (n2/d2), or the difference when sub is nonzero. */
+static limitless_status limitless__rational_addsub_reduced(limitless_ctx* ctx, limitless_rational* out, const limitless_bigint* n1, const limitless_bigint* d1, const limitless_bigint* n2, const limitless_bigint* d2, int sub) {
+  limitless_status st;
+  limitless_bigint g, e1, e2, t1, t2, t, q;
+  limitless__bigint_init_raw(&g);
+  limitless__bigint_init_raw(&e1);
+  limitless__bigint_init_raw(&e2);
+  limitless__bigint_init_raw(&t1);
+  limitless__bigint_init_raw(&t2);
+  limitless__bigint_init_raw(&t);
+  limitless__bigint_init_raw(&q);
+
+  if (limitless__bigint_is_unit(d1) || limitless__bigint_is_unit(d2)) {
+    st = limitless__bigint_set_u64(ctx, &g, 1);
+  } else {
+    st = limitless__bigint_gcd(ctx, &g, d1, d2);
+  }
+  if (st != LIMITLESS_OK) goto cleanup;
+
+  if (limitless__bigint_is_one(&g)) {
+    /* coprime denominators: n1*d2 +- n2*d1 over d1*d2 is already reduced */
+    st = limitless__bigint_mul_signed(ctx, &t1, n1, d2); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__bigint_mul_signed(ctx, &t2, n2, d1); if (st != LIMITLESS_OK) goto cleanup;
+    st = sub ? limitless__bigint_sub_signed(ctx, &out->num, &t1, &t2) : limitless__bigint_add_signed(ctx, &out->num, &t1, &t2);
+    if (st != LIMITLESS_OK) goto cleanup;
+    if (out->num.used == 0) {
+      st = limitless__bigint_set_u64(ctx, &out->den, 1);
+    } else {
+      st = limitless__bigint_mul_signed(ctx, &out->den, d1, d2);
+    }
+    goto cleanup;
+  }
+
+  st = limitless__bigint_div_exact(ctx, &e1, d1, &g); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_div_exact(ctx, &e2, d2, &g); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_mul_signed(ctx, &t1, n1, &e2); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_mul_signed(ctx, &t2, n2, &e1); if (st != LIMITLESS_OK) goto cleanup;
+  st = sub ? limitless__bigint_sub_signed(ctx, &t, &t1, &t2) : limitless__bigint_add_signed(ctx, &t, &t1, &t2);
+  if (st != LIMITLESS_OK) goto cleanup;
+  if (t.used == 0) {
+    st = limitless__bigint_set_u64(ctx, &out->den, 1);
+    if (st != LIMITLESS_OK) goto cleanup;
+    out->num.used = 0;
+    out->num.sign = 0;
+    goto cleanup;
+  }
+
+  /* gcd(t, d1*d2/g) == gcd(t, g), so den = e1 * e2 * (g / gcd(t, g)) */
+  st = limitless__rational_cancel(ctx, &out->num, &q, &t, &g); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_mul_signed(ctx, &t1, &e2, &q); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__bigint_mul_signed(ctx, &out->den, &e1, &t1);
+
+cleanup:
+  limitless__bigint_clear_raw(ctx, &g);
+  limitless__bigint_clear_raw(ctx, &e1);
+  limitless__bigint_clear_raw(ctx, &e2);
+  limitless__bigint_clear_raw(ctx, &t1);
+  limitless__bigint_clear_raw(ctx, &t2);
+  limitless__bigint_clear_raw(ctx, &t);
+  limitless__bigint_clear_raw(ctx, &q);
+  return st;
+}
+
+/* Borrows the numerator/denominator of an INT or RAT number without copying. */
+static void limitless__number_rational_view(const limitless_number* n, const limitless_bigint** num, const limitless_bigint** den, const limitless_bigint* one) {
+  if (n->kind == LIMITLESS_KIND_INT) {
+    *num = &n->v.i;
+    *den = one;
+  } else {
+    *num = &n->v.r.num;
+    *den = &n->v.r.den;
+  }
+}
+
 static limitless_status limitless__bigint_from_base_digits(limitless_ctx* ctx, limitless_bigint* out, const char* s, int base, const char** endp) {
   const char* p = s;
   int sign = 1;
@@ -1353,6 +3997,21 @@ static limitless_status limitless__bigint_from_base_digits(limitless_ctx* ctx, l
     return st;
   }
 
+  {
+    /* size v once from the digit count instead of doubling it as digits arrive; the extra limb covers the multiply's carry slot */
+    limitless_size nd = 0;
+    int d;
+    while ((d = limitless__digit_val(p[nd])) >= 0 && d < actual_base) ++nd;
+    if (nd < (~(limitless_size)0) / 2048u) {
+      limitless_size bits = (nd * (limitless_size)limitless__digit_bits_q8[actual_base] + 255u) / 256u;
+      st = limitless__bigint_reserve_exact(ctx, &v, bits / (limitless_size)LIMITLESS_LIMB_BITS + 2u);
+      if (st != LIMITLESS_OK) {
+        limitless__bigint_clear_raw(ctx, &v);
+        return st;
+      }
+    }
+  }
+
   while (*p) {
     int d = limitless__digit_val(*p);
     if (d < 0 || d >= actual_base) break;
@@ -1392,23 +4051,31 @@ static limitless_status limitless__bigint_to_base_string(limitless_ctx* ctx, con
   limitless_size bits;
   limitless_size cap = 0;
   limitless_size n = 0;
+  limitless_limb chunk;
+  limitless_size k = 1;
   char* rev = NULL;
   char* s = NULL;
   limitless_status st;
 
   if (base < 2 || base > 36 || !out_s || !out_len) return LIMITLESS_EINVAL;
+  chunk = (limitless_limb)base;
 
-  limitless__bigint_init_raw(&t);
+  /* t is divided down in place, so it only needs a's limbs */
+  st = limitless__scratch_bigint(ctx, &t, a->used);
+  if (st != LIMITLESS_OK) goto cleanup;
   st = limitless__bigint_abs_copy(ctx, &t, a);
   if (st != LIMITLESS_OK) goto cleanup;
 
-  bits = limitless__bigint_bit_length(&t);
-  if (bits == 0) {
-    cap = (limitless_size)1;
-  } else {
-    cap = bits + 1;
+  /* peel off the largest power of base that fits a limb, then split each chunk into k digits */
+  while (chunk <= (limitless_limb)(~(limitless_limb)0) / (limitless_limb)base) {
+    chunk = (limitless_limb)(chunk * (limitless_limb)base);
+    ++k;
   }
 
+  /* at most one digit per bit, plus zero padding in the top chunk */
+  bits = limitless__bigint_bit_length(&t);
+  cap = bits + k;
+
   rev = (char*)limitless__alloc_bytes(ctx, cap);
   if (!rev) {
     st = LIMITLESS_EOOM;
@@ -1418,19 +4085,36 @@ static limitless_status limitless__bigint_to_base_string(limitless_ctx* ctx, con
   if (t.used == 0) {
     rev[n++] = '0';
   } else {
+    limitless__divisor dv;
+    limitless__divisor_init(&dv, chunk);
     while (t.used != 0) {
-      limitless_u32 rem = limitless__bigint_divmod_small_inplace(&t, (limitless_u32)base);
-      if (n >= cap) {
-        char* grown = (char*)limitless__realloc_bytes(ctx, rev, cap, cap * 2);
+      limitless_limb rem = limitless__span_divrem_1(LIMITLESS_BIGINT_LIMBS(&t), LIMITLESS_BIGINT_LIMBS(&t), t.used, &dv);
+      limitless_size j;
+      limitless__bigint_norm(&t);
+      if (n + k > cap) {
+        char* grown = (char*)limitless__realloc_bytes(ctx, rev, cap, cap * 2 + k);
         if (!grown) {
           st = LIMITLESS_EOOM;
           goto cleanup;
         }
         rev = grown;
-        cap *= 2;
+        cap = cap * 2 + k;
+      }
+      if (base == 10) {
+        /* a constant divisor lets the compiler use a multiply for the common case */
+        for (j = 0; j < k; ++j) {
+          rev[n++] = (char)('0' + (int)(rem % 10u));
+          rem = (limitless_limb)(rem / 10u);
+        }
+      } else {
+        for (j = 0; j < k; ++j) {
+          rev[n++] = limitless__digit_chr((int)(rem % (limitless_limb)base));
+          rem = (limitless_limb)(rem / (limitless_limb)base);
+        }
       }
-      rev[n++] = limitless__digit_chr((int)rem);
     }
+    /* the top chunk was zero-padded to k digits */
+    while (n > 1 && rev[n - 1] == '0') --n;
   }
 
   s = (char*)limitless__alloc_bytes(ctx, n + 1);
@@ -1453,7 +4137,7 @@ static limitless_status limitless__bigint_to_base_string(limitless_ctx* ctx, con
 cleanup:
   if (rev) limitless__free_bytes(ctx, rev, cap);
   if (s) limitless__free_bytes(ctx, s, n + 1);
-  limitless__bigint_clear_raw(ctx, &t);
+  limitless__scratch_bigint_release(ctx, &t);
   return st;
 }
 
@@ -1464,13 +4148,13 @@ static limitless_status limitless__bigint_abs_to_u64(const limitless_bigint* a,
   if (a->used == 0) {
     *out = 0;
   } else if (a->used == 1) {
-    *out = (limitless_u64)a->limbs[0];
+    *out = (limitless_u64)LIMITLESS_BIGINT_LIMBS(a)[0];
   } else {
-    *out = ((limitless_u64)a->limbs[1] << 32) | (limitless_u64)a->limbs[0];
+    *out = ((limitless_u64)LIMITLESS_BIGINT_LIMBS(a)[1] << 32) | (limitless_u64)LIMITLESS_BIGINT_LIMBS(a)[0];
   }
 #else
   if (a->used > 1) return LIMITLESS_ERANGE;
-  *out = (a->used == 0) ? (limitless_u64)0 : (limitless_u64)a->limbs[0];
+  *out = (a->used == 0) ? (limitless_u64)0 : (limitless_u64)LIMITLESS_BIGINT_LIMBS(a)[0];
 #endif
   return LIMITLESS_OK;
 }
@@ -1492,7 +4176,17 @@ static limitless_status limitless__number_get_integer_ref(const limitless_number
 LIMITLESS_API limitless_status limitless_ctx_init(limitless_ctx* ctx, const limitless_alloc* alloc) {
   if (!ctx || !limitless__alloc_valid(alloc)) return LIMITLESS_EINVAL;
   ctx->allocator = *alloc;
+  limitless__kernels_detect(&ctx->kernels);
   ctx->karatsuba_threshold = LIMITLESS__DEFAULT_KARATSUBA_THRESHOLD;
+  ctx->toom3_threshold = LIMITLESS__DEFAULT_TOOM3_THRESHOLD;
+  ctx->ntt_threshold = LIMITLESS__DEFAULT_NTT_THRESHOLD;
+  ctx->bz_threshold = LIMITLESS__DEFAULT_BZ_THRESHOLD;
+  ctx->hgcd_threshold = LIMITLESS__DEFAULT_HGCD_THRESHOLD;
+  ctx->scratch = NULL;
+  ctx->scratch_cap = 0;
+  ctx->scratch_top = 0;
+  ctx->scratch_depth = 0;
+  ctx->scratch_high_water = 0;
   return LIMITLESS_OK;
 }
 
@@ -1512,6 +4206,229 @@ LIMITLESS_API void limitless_ctx_set_karatsuba_threshold(limitless_ctx* ctx, lim
   ctx->karatsuba_threshold = limbs;
 }
 
+LIMITLESS_API void limitless_ctx_set_toom3_threshold(limitless_ctx* ctx, limitless_size limbs) {
+  if (!ctx) return;
+  if (limbs < 3) limbs = 3;
+  ctx->toom3_threshold = limbs;
+}
+
+LIMITLESS_API void limitless_ctx_set_ntt_threshold(limitless_ctx* ctx, limitless_size limbs) {
+  if (!ctx) return;
+  if (limbs < 2) limbs = 2;
+  ctx->ntt_threshold = limbs;
+}
+
+LIMITLESS_API void limitless_ctx_set_bz_threshold(limitless_ctx* ctx, limitless_size limbs) {
+  if (!ctx) return;
+  if (limbs < 2) limbs = 2;
+  ctx->bz_threshold = limbs;
+}
+
+LIMITLESS_API void limitless_ctx_set_hgcd_threshold(limitless_ctx* ctx, limitless_size limbs) {
+  if (!ctx) return;
+  if (limbs < 4) limbs = 4;
+  ctx->hgcd_threshold = limbs;
+}
+
+LIMITLESS_API void limitless_ctx_set_scratch(limitless_ctx* ctx, limitless_limb* buf, limitless_size limbs) {
+  if (!ctx) return;
+  ctx->scratch = buf;
+  ctx->scratch_cap = buf ? limbs : 0;
+  ctx->scratch_top = 0;
+  ctx->scratch_depth = 0;
+  ctx->scratch_high_water = 0;
+}
+
+LIMITLESS_API limitless_size limitless_ctx_scratch_high_water(const limitless_ctx* ctx) {
+  return ctx ? ctx->scratch_high_water : 0;
+}
+
+/* NULL selects the portable C kernels; a set with a missing entry is ignored */
+LIMITLESS_API void limitless_ctx_set_kernels(limitless_ctx* ctx, const limitless_kernels* kernels) {
+  if (!ctx) return;
+  if (!kernels) {
+    limitless__kernels_portable(&ctx->kernels);
+    return;
+  }
+  if (!kernels->mul_1 || !kernels->addmul_1 || !kernels->submul_1 || !kernels->add_n || !kernels->sub_n) return;
+  ctx->kernels = *kernels;
+}
+
+#define LIMITLESS__POOL_BLOCK(c) (((limitless_size)16u) << (c))
+
+/* smallest class whose block holds size bytes, or LIMITLESS_POOL_CLASSES if none does */
+static int limitless__pool_class(limitless_size size) {
+  int c = 0;
+  while (c < LIMITLESS_POOL_CLASSES && LIMITLESS__POOL_BLOCK(c) < size) ++c;
+  return c;
+}
+
+static int limitless__pool_in_arena(const limitless_pool* pool, const void* p, limitless_size from) {
+  const unsigned char* b = (const unsigned char*)p;
+  return pool->arena && b >= pool->arena + from && b < pool->arena + pool->arena_cap;
+}
+
+static void* limitless__pool_alloc_fn(void* user, limitless_size size) {
+  limitless_pool* pool = (limitless_pool*)user;
+  int c = limitless__pool_class(size);
+  limitless_size block;
+  void* p;
+  if (c == LIMITLESS_POOL_CLASSES) {
+    ++pool->misses;
+    ++pool->backing_calls;
+    return pool->backing.alloc(pool->backing.user, size);
+  }
+  block = LIMITLESS__POOL_BLOCK(c);
+  p = pool->free_lists[c];
+  if (p) {
+    pool->free_lists[c] = *(void**)p;
+    pool->cached_bytes -= block;
+    ++pool->hits;
+    return p;
+  }
+  ++pool->misses;
+  if (pool->arena_cap - pool->arena_used >= block) {
+    p = pool->arena + pool->arena_used;
+    pool->arena_used += block;
+    return p;
+  }
+  ++pool->backing_calls;
+  return pool->backing.alloc(pool->backing.user, block);
+}
+
+static void limitless__pool_free_fn(void* user, void* ptr, limitless_size size) {
+  limitless_pool* pool = (limitless_pool*)user;
+  int c;
+  if (!ptr) return;
+  c = limitless__pool_class(size);
+  if (c == LIMITLESS_POOL_CLASSES) {
+    ++pool->backing_calls;
+    pool->backing.free(pool->backing.user, ptr, size);
+    return;
+  }
+  *(void**)ptr = pool->free_lists[c];
+  pool->free_lists[c] = ptr;
+  pool->cached_bytes += LIMITLESS__POOL_BLOCK(c);
+}
+
+static void* limitless__pool_realloc_fn(void* user, void* ptr, limitless_size old_size, limitless_size new_size) {
+  limitless_pool* pool = (limitless_pool*)user;
+  int oc;
+  int nc;
+  void* p;
+  if (!ptr) return limitless__pool_alloc_fn(user, new_size);
+  oc = limitless__pool_class(old_size);
+  nc = limitless__pool_class(new_size);
+  if (oc == nc && oc < LIMITLESS_POOL_CLASSES) {
+    /* the block already has room for new_size */
+    ++pool->hits;
+    return ptr;
+  }
+  if (oc == LIMITLESS_POOL_CLASSES && nc == LIMITLESS_POOL_CLASSES) {
+    ++pool->misses;
+    ++pool->backing_calls;
+    return pool->backing.realloc(pool->backing.user, ptr, old_size, new_size);
+  }
+  p = limitless__pool_alloc_fn(user, new_size);
+  if (!p) return NULL;
+  limitless__mem_copy(p, ptr, old_size < new_size ? old_size : new_size);
+  limitless__pool_free_fn(user, ptr, old_size);
+  return p;
+}
+
+/* unlinks cached arena blocks at or past offset keep_below; with free_heap, heap blocks go back to the backing allocator */
+static void limitless__pool_drop_cached(limitless_pool* pool, limitless_size keep_below, int free_heap) {
+  int c;
+  for (c = 0; c < LIMITLESS_POOL_CLASSES; ++c) {
+    void** link = &pool->free_lists[c];
+    while (*link) {
+      void* p = *link;
+      int arena = limitless__pool_in_arena(pool, p, 0);
+      if (arena && !limitless__pool_in_arena(pool, p, keep_below)) {
+        link = (void**)p;
+        continue;
+      }
+      if (!arena && !free_heap) {
+        link = (void**)p;
+        continue;
+      }
+      *link = *(void**)p;
+      pool->cached_bytes -= LIMITLESS__POOL_BLOCK(c);
+      if (!arena) {
+        ++pool->backing_calls;
+        pool->backing.free(pool->backing.user, p, LIMITLESS__POOL_BLOCK(c));
+      }
+    }
+  }
+}
+
+LIMITLESS_API limitless_status limitless_pool_init(limitless_pool* pool, const limitless_alloc* backing, limitless_size arena_bytes) {
+  int c;
+  if (!pool || !limitless__alloc_valid(backing)) return LIMITLESS_EINVAL;
+  pool->backing = *backing;
+  for (c = 0; c < LIMITLESS_POOL_CLASSES; ++c) pool->free_lists[c] = NULL;
+  pool->arena = NULL;
+  pool->arena_cap = 0;
+  pool->arena_used = 0;
+  pool->hits = 0;
+  pool->misses = 0;
+  pool->backing_calls = 0;
+  pool->cached_bytes = 0;
+  arena_bytes -= arena_bytes % 16u;
+  if (arena_bytes > 0) {
+    pool->backing_calls = 1;
+    pool->arena = (unsigned char*)backing->alloc(backing->user, arena_bytes);
+    if (!pool->arena) return LIMITLESS_EOOM;
+    pool->arena_cap = arena_bytes;
+  }
+  return LIMITLESS_OK;
+}
+
+LIMITLESS_API void limitless_pool_destroy(limitless_pool* pool) {
+  int c;
+  if (!pool || !pool->backing.free) return;
+  limitless__pool_drop_cached(pool, 0, 1);
+  if (pool->arena) pool->backing.free(pool->backing.user, pool->arena, pool->arena_cap);
+  for (c = 0; c < LIMITLESS_POOL_CLASSES; ++c) pool->free_lists[c] = NULL;
+  pool->arena = NULL;
+  pool->arena_cap = 0;
+  pool->arena_used = 0;
+  pool->cached_bytes = 0;
+}
+
+LIMITLESS_API void limitless_pool_allocator(limitless_pool* pool, limitless_alloc* out) {
+  if (!out) return;
+  out->alloc = limitless__pool_alloc_fn;
+  out->realloc = limitless__pool_realloc_fn;
+  out->free = limitless__pool_free_fn;
+  out->user = pool;
+}
+
+LIMITLESS_API void limitless_pool_trim(limitless_pool* pool) {
+  if (!pool || !pool->backing.free) return;
+  limitless__pool_drop_cached(pool, pool->arena_cap, 1);
+}
+
+LIMITLESS_API limitless_size limitless_pool_mark(const limitless_pool* pool) {
+  return pool ? pool->arena_used : 0;
+}
+
+LIMITLESS_API void limitless_pool_release(limitless_pool* pool, limitless_size mark) {
+  if (!pool || mark >= pool->arena_used) return;
+  limitless__pool_drop_cached(pool, mark, 0);
+  pool->arena_used = mark;
+}
+
+LIMITLESS_API void limitless_pool_get_stats(const limitless_pool* pool, limitless_pool_stats* out) {
+  if (!pool || !out) return;
+  out->hits = pool->hits;
+  out->misses = pool->misses;
+  out->backing_calls = pool->backing_calls;
+  out->cached_bytes = pool->cached_bytes;
+  out->arena_used = pool->arena_used;
+  out->arena_cap = pool->arena_cap;
+}
+
 LIMITLESS_API limitless_status limitless_number_init(limitless_ctx* ctx, limitless_number* n) {
   (void)ctx;
   if (!n) return LIMITLESS_EINVAL;
@@ -1535,6 +4452,16 @@ LIMITLESS_API limitless_status limitless_number_copy(limitless_ctx* ctx, limitle
   limitless_number tmp;
   limitless_status st;
   if (!ctx || !dst || !src) return LIMITLESS_EINVAL;
+  if (dst == src) return LIMITLESS_OK;
+
+  /* same kind: both copies reserve before writing, so dst's buffers are reused in place */
+  if (src->kind == LIMITLESS_KIND_INT && dst->kind == LIMITLESS_KIND_INT) {
+    return limitless__bigint_copy(ctx, &dst->v.i, &src->v.i);
+  }
+  if (src->kind == LIMITLESS_KIND_RAT && dst->kind == LIMITLESS_KIND_RAT) {
+    return limitless__rational_copy(ctx, &dst->v.r, &src->v.r);
+  }
+
   st = limitless_number_init(ctx, &tmp);
   if (st != LIMITLESS_OK) return st; /* GCOVR_EXCL_BR_LINE */
 
@@ -1557,6 +4484,29 @@ LIMITLESS_API limitless_status limitless_number_copy(limitless_ctx* ctx, limitle
   return LIMITLESS_OK;
 }
 
+LIMITLESS_API limitless_status limitless_number_reserve(limitless_ctx* ctx, limitless_number* n, limitless_size bits) {
+  limitless_status st;
+  limitless_size limbs;
+  if (!ctx || !n) return LIMITLESS_EINVAL;
+  limbs = bits / (limitless_size)LIMITLESS_LIMB_BITS + ((bits % (limitless_size)LIMITLESS_LIMB_BITS) != 0u);
+  if (n->kind == LIMITLESS_KIND_INT) return limitless__bigint_reserve_exact(ctx, &n->v.i, limbs);
+  if (n->kind != LIMITLESS_KIND_RAT) return LIMITLESS_EINVAL;
+  /* both parts get the capacity; either may end up holding the larger value */
+  st = limitless__bigint_reserve_exact(ctx, &n->v.r.num, limbs);
+  if (st != LIMITLESS_OK) return st;
+  return limitless__bigint_reserve_exact(ctx, &n->v.r.den, limbs);
+}
+
+LIMITLESS_API limitless_status limitless_number_shrink_to_fit(limitless_ctx* ctx, limitless_number* n) {
+  limitless_status st;
+  if (!ctx || !n) return LIMITLESS_EINVAL;
+  if (n->kind == LIMITLESS_KIND_INT) return limitless__bigint_shrink(ctx, &n->v.i);
+  if (n->kind != LIMITLESS_KIND_RAT) return LIMITLESS_EINVAL;
+  st = limitless__bigint_shrink(ctx, &n->v.r.num);
+  if (st != LIMITLESS_OK) return st;
+  return limitless__bigint_shrink(ctx, &n->v.r.den);
+}
+
 LIMITLESS_API limitless_status limitless_number_from_i64(limitless_ctx* ctx, limitless_number* out, limitless_i64 v) {
   limitless_number tmp;
   limitless_status st;
@@ -1940,71 +4890,110 @@ LIMITLESS_API limitless_status limitless_number_to_i64(limitless_ctx* ctx, const
   return LIMITLESS_OK;
 }
 
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 5))
+#define LIMITLESS__HAVE_OVERFLOW_BUILTINS 1
+#endif
+
+/*
+Word fast path for integer add/sub/mul. Operands whose magnitude fits in 63
+bits are combined with overflow-checked i64 arithmetic, and the result is
+stored straight into out: a word-sized value fits out's inline limbs (or its
+existing heap block), so the store cannot fail and needs no temporary. On
+overflow, or with a wider operand, the caller takes the limb path.
+*/
+static int limitless__bigint_to_word(const limitless_bigint* a, limitless_i64* v) {
+  const limitless_limb* l = LIMITLESS_BIGINT_LIMBS(a);
+  limitless_u64 mag = 0;
+#if (LIMITLESS_LIMB_BITS == LIMITLESS_LIMB_BITS_32)
+  if (a->used > 2) return 0;
+  if (a->used > 1) mag = (limitless_u64)l[1] << 32;
+  if (a->used > 0) mag |= (limitless_u64)l[0];
+#else
+  if (a->used > 1) return 0;
+  if (a->used > 0) mag = (limitless_u64)l[0];
+#endif
+  if (mag > 0x7fffffffffffffffULL) return 0;
+  *v = (a->sign < 0) ? -(limitless_i64)mag : (limitless_i64)mag;
+  return 1;
+}
+
+static int limitless__word_op(limitless_i64 a, limitless_i64 b, int op, limitless_i64* r) {
+#if defined(LIMITLESS__HAVE_OVERFLOW_BUILTINS)
+  if (op == 0) return !__builtin_add_overflow(a, b, r);
+  if (op == 1) return !__builtin_sub_overflow(a, b, r);
+  return !__builtin_mul_overflow(a, b, r);
+#else
+  /* both operands lie in [-(2^63 - 1), 2^63 - 1], so negating b is safe */
+  const limitless_i64 max = (limitless_i64)0x7fffffffffffffffLL;
+  limitless_u64 ma;
+  limitless_u64 mb;
+  if (op == 1) b = -b;
+  if (op != 2) {
+    if ((b > 0 && a > max - b) || (b < 0 && a < -max - b)) return 0;
+    *r = a + b;
+    return 1;
+  }
+  ma = (a < 0) ? (limitless_u64)(-a) : (limitless_u64)a;
+  mb = (b < 0) ? (limitless_u64)(-b) : (limitless_u64)b;
+  if (ma != 0 && mb > (limitless_u64)max / ma) return 0;
+  *r = (limitless_i64)(ma * mb);
+  if ((a < 0) != (b < 0)) *r = -*r;
+  return 1;
+#endif
+}
+
 /* GCOVR_EXCL_START */
 static limitless_status limitless__number_binop(limitless_ctx* ctx, limitless_number* out, const limitless_number* a, const limitless_number* b, int op) {
   limitless_status st;
-  limitless_number tmp;
   if (!ctx || !out || !a || !b) return LIMITLESS_EINVAL;
-  st = limitless_number_init(ctx, &tmp);
-  if (st != LIMITLESS_OK) return st;
 
   if (a->kind == LIMITLESS_KIND_INT && b->kind == LIMITLESS_KIND_INT) {
-    tmp.kind = LIMITLESS_KIND_INT;
-    if (op == 0) st = limitless__bigint_add_signed(ctx, &tmp.v.i, &a->v.i, &b->v.i);
-    else if (op == 1) st = limitless__bigint_sub_signed(ctx, &tmp.v.i, &a->v.i, &b->v.i);
-    else st = limitless__bigint_mul_signed(ctx, &tmp.v.i, &a->v.i, &b->v.i);
-  } else {
-    limitless_rational ra, rb, rr;
-    limitless_bigint t1, t2;
-    limitless__rational_init(&ra);
-    limitless__rational_init(&rb);
-    limitless__rational_init(&rr);
-    limitless__bigint_init_raw(&t1);
-    limitless__bigint_init_raw(&t2);
-
-    st = limitless__number_to_rational_copy(ctx, &ra, a); if (st != LIMITLESS_OK) goto rat_cleanup;
-    st = limitless__number_to_rational_copy(ctx, &rb, b); if (st != LIMITLESS_OK) goto rat_cleanup;
-
-    if (op == 0 || op == 1) {
-      st = limitless__bigint_mul_signed(ctx, &t1, &ra.num, &rb.den); if (st != LIMITLESS_OK) goto rat_cleanup;
-      st = limitless__bigint_mul_signed(ctx, &t2, &rb.num, &ra.den); if (st != LIMITLESS_OK) goto rat_cleanup;
-      if (op == 0) st = limitless__bigint_add_signed(ctx, &rr.num, &t1, &t2);
-      else st = limitless__bigint_sub_signed(ctx, &rr.num, &t1, &t2);
-      if (st != LIMITLESS_OK) goto rat_cleanup;
-      st = limitless__bigint_mul_signed(ctx, &rr.den, &ra.den, &rb.den); if (st != LIMITLESS_OK) goto rat_cleanup;
-    } else {
-      st = limitless__bigint_mul_signed(ctx, &rr.num, &ra.num, &rb.num); if (st != LIMITLESS_OK) goto rat_cleanup;
-      st = limitless__bigint_mul_signed(ctx, &rr.den, &ra.den, &rb.den); if (st != LIMITLESS_OK) goto rat_cleanup;
+    limitless_i64 x, y, r;
+    limitless_bigint t;
+    if (limitless__bigint_to_word(&a->v.i, &x) && limitless__bigint_to_word(&b->v.i, &y) && limitless__word_op(x, y, op, &r)) {
+      if (out->kind != LIMITLESS_KIND_INT) limitless_number_clear(ctx, out);
+      return limitless__bigint_set_i64(ctx, &out->v.i, r);
     }
-
-    st = limitless__rational_normalize(ctx, &rr);
-    if (st != LIMITLESS_OK) goto rat_cleanup;
-
-    if (limitless__rational_den_is_one(&rr)) {
-      tmp.kind = LIMITLESS_KIND_INT;
-      st = limitless__bigint_copy(ctx, &tmp.v.i, &rr.num);
-    } else {
-      tmp.kind = LIMITLESS_KIND_RAT;
-      limitless__rational_init(&tmp.v.r);
-      st = limitless__rational_copy(ctx, &tmp.v.r, &rr);
+    /*
+    Every kernel reserves before its first write, so an integer out can take
+    the result directly. Add and sub read each limb before writing it and may
+    run in place on an operand; the multiply tiers write the product while
+    still reading, so they need an out distinct from both operands.
+    */
+    if (out->kind == LIMITLESS_KIND_INT && (op != 2 || (out != a && out != b))) {
+      if (op == 0) return limitless__bigint_add_signed(ctx, &out->v.i, &a->v.i, &b->v.i);
+      if (op == 1) return limitless__bigint_sub_signed(ctx, &out->v.i, &a->v.i, &b->v.i);
+      return limitless__bigint_mul_signed(ctx, &out->v.i, &a->v.i, &b->v.i);
     }
+    limitless__bigint_init_raw(&t);
+    if (op == 0) st = limitless__bigint_add_signed(ctx, &t, &a->v.i, &b->v.i);
+    else if (op == 1) st = limitless__bigint_sub_signed(ctx, &t, &a->v.i, &b->v.i);
+    else st = limitless__bigint_mul_signed(ctx, &t, &a->v.i, &b->v.i);
+    if (st == LIMITLESS_OK) limitless__number_take_int(ctx, out, &t);
+    limitless__bigint_clear_raw(ctx, &t);
+    return st;
+  } else {
+    limitless_rational rr;
+    limitless_limb one_limb = 1;
+    limitless_bigint one;
+    const limitless_bigint *an, *ad, *bn, *bd;
+    if ((a->kind != LIMITLESS_KIND_INT && a->kind != LIMITLESS_KIND_RAT) || (b->kind != LIMITLESS_KIND_INT && b->kind != LIMITLESS_KIND_RAT)) {
+      return LIMITLESS_EINVAL;
+    }
+    one.sign = 1;
+    one.used = 1;
+    one.cap = 1;
+    one.limbs = &one_limb;
+    limitless__number_rational_view(a, &an, &ad, &one);
+    limitless__number_rational_view(b, &bn, &bd, &one);
+    limitless__rational_init(&rr);
 
-rat_cleanup:
-    limitless__bigint_clear_raw(ctx, &t1);
-    limitless__bigint_clear_raw(ctx, &t2);
-    limitless__rational_clear(ctx, &ra);
-    limitless__rational_clear(ctx, &rb);
-    limitless__rational_clear(ctx, &rr);
-  }
-
-  if (st != LIMITLESS_OK) {
-    limitless_number_clear(ctx, &tmp);
+    if (op == 0 || op == 1) st = limitless__rational_addsub_reduced(ctx, &rr, an, ad, bn, bd, op == 1);
+    else st = limitless__rational_mul_reduced(ctx, &rr, an, ad, bn, bd);
+    if (st == LIMITLESS_OK) limitless__number_take_rational(ctx, out, &rr);
+    limitless__rational_clear(ctx, &rr);
     return st;
   }
-
-  limitless__number_swap(out, &tmp);
-  limitless_number_clear(ctx, &tmp);
-  return LIMITLESS_OK;
 }
 /* GCOVR_EXCL_STOP */
 
@@ -2022,121 +5011,63 @@ LIMITLESS_API limitless_status limitless_number_mul(limitless_ctx* ctx, limitles
 
 LIMITLESS_API limitless_status limitless_number_div(limitless_ctx* ctx, limitless_number* out, const limitless_number* a, const limitless_number* b) {
   limitless_status st;
-  limitless_number tmp;
+  limitless_rational rr;
+  limitless_limb one_limb = 1;
+  limitless_bigint one;
+  const limitless_bigint *an, *ad, *bn, *bd;
   if (!ctx || !out || !a || !b) return LIMITLESS_EINVAL;
   if (limitless_number_is_zero(b)) return LIMITLESS_EDIVZERO;
-
-  st = limitless_number_init(ctx, &tmp);
-  if (st != LIMITLESS_OK) return st; /* GCOVR_EXCL_BR_LINE */
+  if ((a->kind != LIMITLESS_KIND_INT && a->kind != LIMITLESS_KIND_RAT) || (b->kind != LIMITLESS_KIND_INT && b->kind != LIMITLESS_KIND_RAT)) {
+    return LIMITLESS_EINVAL;
+  }
 
   if (a->kind == LIMITLESS_KIND_INT && b->kind == LIMITLESS_KIND_INT) {
     limitless_bigint q, r;
+    int exact;
     limitless__bigint_init_raw(&q);
     limitless__bigint_init_raw(&r);
     st = limitless__bigint_divmod_signed(ctx, &q, &r, &a->v.i, &b->v.i);
-    if (st != LIMITLESS_OK) {
-      limitless__bigint_clear_raw(ctx, &q);
-      limitless__bigint_clear_raw(ctx, &r);
-      limitless_number_clear(ctx, &tmp);
-      return st;
-    }
-    if (r.used == 0) {
-      tmp.kind = LIMITLESS_KIND_INT;
-      st = limitless__bigint_copy(ctx, &tmp.v.i, &q);
-    } else {
-      limitless_rational rr;
-      limitless__rational_init(&rr);
-      st = limitless__bigint_copy(ctx, &rr.num, &a->v.i);
-      if (st == LIMITLESS_OK) st = limitless__bigint_copy(ctx, &rr.den, &b->v.i);
-      if (st == LIMITLESS_OK) st = limitless__rational_normalize(ctx, &rr);
-      if (st == LIMITLESS_OK) {
-        tmp.kind = LIMITLESS_KIND_RAT;
-        limitless__rational_init(&tmp.v.r);
-        st = limitless__rational_copy(ctx, &tmp.v.r, &rr);
-        limitless__rational_clear(ctx, &rr);
-      } else {
-        limitless__rational_clear(ctx, &rr);
-      }
-    }
+    exact = (st == LIMITLESS_OK && r.used == 0);
+    if (exact) limitless__number_take_int(ctx, out, &q);
     limitless__bigint_clear_raw(ctx, &q);
     limitless__bigint_clear_raw(ctx, &r);
-  } else {
-    limitless_rational ra, rb, rr;
-    limitless__rational_init(&ra);
-    limitless__rational_init(&rb);
-    limitless__rational_init(&rr);
-
-    st = limitless__number_to_rational_copy(ctx, &ra, a); if (st != LIMITLESS_OK) goto rat_done;
-    st = limitless__number_to_rational_copy(ctx, &rb, b); if (st != LIMITLESS_OK) goto rat_done;
-
-    st = limitless__bigint_mul_signed(ctx, &rr.num, &ra.num, &rb.den); if (st != LIMITLESS_OK) goto rat_done;
-    st = limitless__bigint_mul_signed(ctx, &rr.den, &ra.den, &rb.num); if (st != LIMITLESS_OK) goto rat_done;
-    st = limitless__rational_normalize(ctx, &rr); if (st != LIMITLESS_OK) goto rat_done;
-
-    if (limitless__rational_den_is_one(&rr)) {
-      tmp.kind = LIMITLESS_KIND_INT;
-      st = limitless__bigint_copy(ctx, &tmp.v.i, &rr.num);
-    } else {
-      tmp.kind = LIMITLESS_KIND_RAT;
-      limitless__rational_init(&tmp.v.r);
-      st = limitless__rational_copy(ctx, &tmp.v.r, &rr);
-    }
-
-rat_done:
-    limitless__rational_clear(ctx, &ra);
-    limitless__rational_clear(ctx, &rb);
-    limitless__rational_clear(ctx, &rr);
-  }
-
-  if (st != LIMITLESS_OK) {
-    limitless_number_clear(ctx, &tmp);
-    return st;
+    if (st != LIMITLESS_OK || exact) return st;
   }
 
-  limitless__number_swap(out, &tmp);
-  limitless_number_clear(ctx, &tmp);
-  return LIMITLESS_OK;
+  one.sign = 1;
+  one.used = 1;
+  one.cap = 1;
+  one.limbs = &one_limb;
+  limitless__number_rational_view(a, &an, &ad, &one);
+  limitless__number_rational_view(b, &bn, &bd, &one);
+  limitless__rational_init(&rr);
+
+  /* a / b == (an / ad) * (bd / bn); the sign of bn moves to the numerator */
+  st = limitless__rational_mul_reduced(ctx, &rr, an, ad, bd, bn);
+  if (st == LIMITLESS_OK) limitless__number_take_rational(ctx, out, &rr);
+  limitless__rational_clear(ctx, &rr);
+  return st;
 }
 
 LIMITLESS_API limitless_status limitless_number_neg(limitless_ctx* ctx, limitless_number* out, const limitless_number* a) {
-  limitless_number tmp;
-  limitless_status st;
-  if (!ctx || !out || !a) return LIMITLESS_EINVAL;
-  st = limitless_number_init(ctx, &tmp);
-  if (st != LIMITLESS_OK) return st; /* GCOVR_EXCL_BR_LINE */
-  st = limitless_number_copy(ctx, &tmp, a);
-  if (st != LIMITLESS_OK) {
-    limitless_number_clear(ctx, &tmp);
-    return st;
-  }
-  if (tmp.kind == LIMITLESS_KIND_INT) {
-    tmp.v.i.sign = -tmp.v.i.sign;
+  limitless_status st = limitless_number_copy(ctx, out, a);
+  if (st != LIMITLESS_OK) return st;
+  if (out->kind == LIMITLESS_KIND_INT) {
+    out->v.i.sign = -out->v.i.sign;
   } else {
-    tmp.v.r.num.sign = -tmp.v.r.num.sign;
+    out->v.r.num.sign = -out->v.r.num.sign;
   }
-  limitless__number_swap(out, &tmp);
-  limitless_number_clear(ctx, &tmp);
   return LIMITLESS_OK;
 }
 
 LIMITLESS_API limitless_status limitless_number_abs(limitless_ctx* ctx, limitless_number* out, const limitless_number* a) {
-  limitless_number tmp;
-  limitless_status st;
-  if (!ctx || !out || !a) return LIMITLESS_EINVAL;
-  st = limitless_number_init(ctx, &tmp);
-  if (st != LIMITLESS_OK) return st; /* GCOVR_EXCL_BR_LINE */
-  st = limitless_number_copy(ctx, &tmp, a);
-  if (st != LIMITLESS_OK) {
-    limitless_number_clear(ctx, &tmp);
-    return st;
-  }
-  if (tmp.kind == LIMITLESS_KIND_INT) {
-    if (tmp.v.i.sign < 0) tmp.v.i.sign = 1;
+  limitless_status st = limitless_number_copy(ctx, out, a);
+  if (st != LIMITLESS_OK) return st;
+  if (out->kind == LIMITLESS_KIND_INT) {
+    if (out->v.i.sign < 0) out->v.i.sign = 1;
   } else {
-    if (tmp.v.r.num.sign < 0) tmp.v.r.num.sign = 1;
+    if (out->v.r.num.sign < 0) out->v.r.num.sign = 1;
   }
-  limitless__number_swap(out, &tmp);
-  limitless_number_clear(ctx, &tmp);
   return LIMITLESS_OK;
 }
 
@@ -2208,6 +5139,53 @@ LIMITLESS_API limitless_status limitless_number_gcd(limitless_ctx* ctx, limitles
   return LIMITLESS_OK;
 }
 
+/*
+g = gcd(a, b) >= 0 and s a + t b = g, with |s| <= |b| / (2 g) when b != 0
+and s = sign(a), t = 0 when b == 0. s and t may be NULL; the outputs must be
+distinct but may alias a or b, and nothing is written unless all succeed.
+*/
+LIMITLESS_API limitless_status limitless_number_gcdext(limitless_ctx* ctx, limitless_number* g, limitless_number* s, limitless_number* t, const limitless_number* a, const limitless_number* b) {
+  const limitless_bigint* ia;
+  const limitless_bigint* ib;
+  limitless_bigint rg, rs, rt;
+  limitless_status st;
+  if (!ctx || !g || !a || !b) return LIMITLESS_EINVAL;
+  if (g == s || g == t || (s && s == t)) return LIMITLESS_EINVAL;
+  if (limitless__number_get_integer_ref(a, &ia) != LIMITLESS_OK) return LIMITLESS_ETYPE;
+  if (limitless__number_get_integer_ref(b, &ib) != LIMITLESS_OK) return LIMITLESS_ETYPE;
+
+  limitless__bigint_init_raw(&rg);
+  limitless__bigint_init_raw(&rs);
+  limitless__bigint_init_raw(&rt);
+  st = limitless__bigint_gcdext(ctx, &rg, s ? &rs : NULL, t ? &rt : NULL, ia, ib);
+  if (st == LIMITLESS_OK) {
+    limitless__number_take_int(ctx, g, &rg);
+    if (s) limitless__number_take_int(ctx, s, &rs);
+    if (t) limitless__number_take_int(ctx, t, &rt);
+  }
+  limitless__bigint_clear_raw(ctx, &rg);
+  limitless__bigint_clear_raw(ctx, &rs);
+  limitless__bigint_clear_raw(ctx, &rt);
+  return st;
+}
+
+/* out = a^-1 mod |m| in [0, |m|); EDIVZERO when m is zero or shares a factor with a */
+LIMITLESS_API limitless_status limitless_number_invmod(limitless_ctx* ctx, limitless_number* out, const limitless_number* a, const limitless_number* m) {
+  const limitless_bigint* ia;
+  const limitless_bigint* im;
+  limitless_bigint res;
+  limitless_status st;
+  if (!ctx || !out || !a || !m) return LIMITLESS_EINVAL;
+  if (limitless__number_get_integer_ref(a, &ia) != LIMITLESS_OK) return LIMITLESS_ETYPE;
+  if (limitless__number_get_integer_ref(m, &im) != LIMITLESS_OK) return LIMITLESS_ETYPE;
+
+  limitless__bigint_init_raw(&res);
+  st = limitless__bigint_invmod(ctx, &res, ia, im);
+  if (st == LIMITLESS_OK) limitless__number_take_int(ctx, out, &res);
+  limitless__bigint_clear_raw(ctx, &res);
+  return st;
+}
+
 LIMITLESS_API limitless_status limitless_number_pow_u64(limitless_ctx* ctx, limitless_number* out, const limitless_number* a, limitless_u64 exp) {
   const limitless_bigint* ia;
   limitless_bigint base, res, t;
@@ -2232,7 +5210,7 @@ LIMITLESS_API limitless_status limitless_number_pow_u64(limitless_ctx* ctx, limi
     }
     exp >>= 1;
     if (exp == 0ULL) break;
-    st = limitless__bigint_mul_signed(ctx, &t, &base, &base);
+    st = limitless__bigint_sqr_signed(ctx, &t, &base);
     if (st != LIMITLESS_OK) goto cleanup;
     limitless__bigint_swap(&base, &t);
     t.used = 0; t.sign = 0;
@@ -2256,72 +5234,402 @@ cleanup:
   return st;
 }
 
+/* out = a^e mod m in [0, m) for integers a, e >= 0 and m > 0; out is written only on success */
+static limitless_status limitless__number_modexp(limitless_ctx* ctx, limitless_number* out, const limitless_bigint* ia, const limitless_bigint* e, const limitless_bigint* im) {
+  limitless_bigint res;
+  limitless_modctx mc;
+  limitless_status st;
+
+  limitless__bigint_init_raw(&res);
+  limitless__modctx_init_raw(&mc);
+
+  st = limitless__modctx_setup(ctx, &mc, im); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__modctx_reduce_int(ctx, &mc, &res, ia); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__modctx_enter(ctx, &mc, &res, &res); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__modctx_pow(ctx, &mc, &res, &res, e); if (st != LIMITLESS_OK) goto cleanup;
+  st = limitless__modctx_leave(ctx, &mc, &res, &res); if (st != LIMITLESS_OK) goto cleanup;
+  limitless__number_take_int(ctx, out, &res);
+
+cleanup:
+  limitless__bigint_clear_raw(ctx, &res);
+  limitless__modctx_clear(ctx, &mc);
+  return st;
+}
+
 LIMITLESS_API limitless_status limitless_number_modexp_u64(limitless_ctx* ctx, limitless_number* out, const limitless_number* a, limitless_u64 exp, const limitless_number* mod) {
   const limitless_bigint* ia;
   const limitless_bigint* im;
-  limitless_bigint base, res, t, m;
+  limitless_bigint e;
   limitless_status st;
-  limitless_number tmp;
 
   if (!ctx || !out || !a || !mod) return LIMITLESS_EINVAL;
   if (limitless__number_get_integer_ref(a, &ia) != LIMITLESS_OK) return LIMITLESS_ETYPE;
   if (limitless__number_get_integer_ref(mod, &im) != LIMITLESS_OK) return LIMITLESS_ETYPE;
   if (im->sign <= 0 || im->used == 0) return LIMITLESS_EDIVZERO; /* GCOVR_EXCL_BR_LINE */
 
-  limitless__bigint_init_raw(&base);
+  /* a u64 fits the inline limbs, so this never allocates */
+  limitless__bigint_init_raw(&e);
+  st = limitless__bigint_set_u64(ctx, &e, exp);
+  if (st == LIMITLESS_OK) st = limitless__number_modexp(ctx, out, ia, &e, im);
+  limitless__bigint_clear_raw(ctx, &e);
+  return st;
+}
+
+/*
+a^exp mod mod for integers, with the result in [0, mod). The exponent may be
+any nonnegative integer (ERANGE if negative) and is consumed in sliding
+windows over its limbs, sharing the Montgomery/Barrett reduction of
+limitless_number_modexp_u64.
+*/
+LIMITLESS_API limitless_status limitless_number_modexp(limitless_ctx* ctx, limitless_number* out, const limitless_number* a, const limitless_number* exp, const limitless_number* mod) {
+  const limitless_bigint* ia;
+  const limitless_bigint* ie;
+  const limitless_bigint* im;
+
+  if (!ctx || !out || !a || !exp || !mod) return LIMITLESS_EINVAL;
+  if (limitless__number_get_integer_ref(a, &ia) != LIMITLESS_OK) return LIMITLESS_ETYPE;
+  if (limitless__number_get_integer_ref(exp, &ie) != LIMITLESS_OK) return LIMITLESS_ETYPE;
+  if (limitless__number_get_integer_ref(mod, &im) != LIMITLESS_OK) return LIMITLESS_ETYPE;
+  if (im->sign <= 0 || im->used == 0) return LIMITLESS_EDIVZERO;
+  if (ie->sign < 0) return LIMITLESS_ERANGE;
+  return limitless__number_modexp(ctx, out, ia, ie, im);
+}
+
+/*
+Arithmetic under a limitless_modctx. Residue operands must be integers in
+[0, m) (ETYPE for other kinds, ERANGE outside that range) and results are
+residues again; to_residue accepts any integer. Sums, differences and
+inverses are the same in Montgomery form as on plain values, and products
+and powers are reduced without dividing. Outputs may alias any operand and
+are written only on success.
+*/
+static limitless_status limitless__modctx_residue_ref(const limitless_modctx* mc, const limitless_number* x, const limitless_bigint** out) {
+  if (limitless__number_get_integer_ref(x, out) != LIMITLESS_OK) return LIMITLESS_ETYPE;
+  if ((*out)->sign < 0 || limitless__mag_cmp(*out, &mc->m) >= 0) return LIMITLESS_ERANGE;
+  return LIMITLESS_OK;
+}
+
+/* mod must be a positive integer (EDIVZERO otherwise); mc can be cleared whatever this returns */
+LIMITLESS_API limitless_status limitless_modctx_init(limitless_ctx* ctx, limitless_modctx* mc, const limitless_number* mod) {
+  const limitless_bigint* im;
+  limitless_status st;
+
+  if (!ctx || !mc || !mod) return LIMITLESS_EINVAL;
+  limitless__modctx_init_raw(mc);
+  if (limitless__number_get_integer_ref(mod, &im) != LIMITLESS_OK) return LIMITLESS_ETYPE;
+  if (im->sign <= 0 || im->used == 0) return LIMITLESS_EDIVZERO;
+  st = limitless__modctx_setup(ctx, mc, im);
+  if (st != LIMITLESS_OK) limitless__modctx_clear(ctx, mc);
+  return st;
+}
+
+LIMITLESS_API void limitless_modctx_clear(limitless_ctx* ctx, limitless_modctx* mc) {
+  if (!mc) return;
+  limitless__modctx_clear(ctx, mc);
+}
+
+LIMITLESS_API limitless_status limitless_modctx_to_residue(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a) {
+  const limitless_bigint* ia;
+  limitless_bigint res;
+  limitless_status st;
+
+  if (!ctx || !mc || !out || !a || mc->n == 0) return LIMITLESS_EINVAL;
+  if (limitless__number_get_integer_ref(a, &ia) != LIMITLESS_OK) return LIMITLESS_ETYPE;
   limitless__bigint_init_raw(&res);
-  limitless__bigint_init_raw(&t);
-  limitless__bigint_init_raw(&m);
+  st = limitless__modctx_reduce_int(ctx, mc, &res, ia);
+  if (st == LIMITLESS_OK) st = limitless__modctx_enter(ctx, mc, &res, &res);
+  if (st == LIMITLESS_OK) limitless__number_take_int(ctx, out, &res);
+  limitless__bigint_clear_raw(ctx, &res);
+  return st;
+}
 
-  st = limitless__bigint_copy(ctx, &m, im); if (st != LIMITLESS_OK) goto cleanup;
-  if (m.sign < 0) m.sign = 1; /* GCOVR_EXCL_BR_LINE */
+LIMITLESS_API limitless_status limitless_modctx_from_residue(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a) {
+  const limitless_bigint* ia;
+  limitless_bigint res;
+  limitless_status st;
 
-  st = limitless__bigint_mod(ctx, &base, ia, &m); if (st != LIMITLESS_OK) goto cleanup;
-  if (base.sign < 0) {
-    st = limitless__bigint_add_signed(ctx, &base, &base, &m);
-    if (st != LIMITLESS_OK) goto cleanup;
+  if (!ctx || !mc || !out || !a || mc->n == 0) return LIMITLESS_EINVAL;
+  st = limitless__modctx_residue_ref(mc, a, &ia); if (st != LIMITLESS_OK) return st;
+  limitless__bigint_init_raw(&res);
+  st = limitless__modctx_leave(ctx, mc, &res, ia);
+  if (st == LIMITLESS_OK) limitless__number_take_int(ctx, out, &res);
+  limitless__bigint_clear_raw(ctx, &res);
+  return st;
+}
+
+LIMITLESS_API limitless_status limitless_modctx_addmod(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a, const limitless_number* b) {
+  const limitless_bigint* ia;
+  const limitless_bigint* ib;
+  limitless_bigint res;
+  limitless_status st;
+
+  if (!ctx || !mc || !out || !a || !b || mc->n == 0) return LIMITLESS_EINVAL;
+  st = limitless__modctx_residue_ref(mc, a, &ia); if (st != LIMITLESS_OK) return st;
+  st = limitless__modctx_residue_ref(mc, b, &ib); if (st != LIMITLESS_OK) return st;
+  limitless__bigint_init_raw(&res);
+  st = limitless__mag_add(ctx, &res, ia, ib);
+  if (st == LIMITLESS_OK && limitless__mag_cmp(&res, &mc->m) >= 0) limitless__mag_sub_inplace(ctx, &res, &mc->m);
+  if (st == LIMITLESS_OK) limitless__number_take_int(ctx, out, &res);
+  limitless__bigint_clear_raw(ctx, &res);
+  return st;
+}
+
+LIMITLESS_API limitless_status limitless_modctx_submod(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a, const limitless_number* b) {
+  const limitless_bigint* ia;
+  const limitless_bigint* ib;
+  limitless_bigint res;
+  limitless_status st;
+
+  if (!ctx || !mc || !out || !a || !b || mc->n == 0) return LIMITLESS_EINVAL;
+  st = limitless__modctx_residue_ref(mc, a, &ia); if (st != LIMITLESS_OK) return st;
+  st = limitless__modctx_residue_ref(mc, b, &ib); if (st != LIMITLESS_OK) return st;
+  limitless__bigint_init_raw(&res);
+  if (limitless__mag_cmp(ia, ib) >= 0) {
+    st = limitless__mag_sub(ctx, &res, ia, ib);
+  } else {
+    /* a - b + m, as m - (b - a) */
+    st = limitless__mag_sub(ctx, &res, ib, ia);
+    if (st == LIMITLESS_OK) st = limitless__mag_sub(ctx, &res, &mc->m, &res);
   }
+  if (st == LIMITLESS_OK) limitless__number_take_int(ctx, out, &res);
+  limitless__bigint_clear_raw(ctx, &res);
+  return st;
+}
 
-  st = limitless__bigint_set_u64(ctx, &res, 1);
-  if (st != LIMITLESS_OK) goto cleanup;
-  st = limitless__bigint_mod(ctx, &t, &res, &m);
-  if (st != LIMITLESS_OK) goto cleanup;
-  limitless__bigint_swap(&res, &t);
-  t.used = 0; t.sign = 0;
+LIMITLESS_API limitless_status limitless_modctx_mulmod(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a, const limitless_number* b) {
+  const limitless_bigint* ia;
+  const limitless_bigint* ib;
+  limitless_bigint res;
+  limitless_status st;
 
-  while (exp > 0ULL) {
-    if (exp & 1ULL) {
-      st = limitless__bigint_mul_signed(ctx, &t, &res, &base);
-      if (st != LIMITLESS_OK) goto cleanup;
-      st = limitless__bigint_mod(ctx, &res, &t, &m);
+  if (!ctx || !mc || !out || !a || !b || mc->n == 0) return LIMITLESS_EINVAL;
+  st = limitless__modctx_residue_ref(mc, a, &ia); if (st != LIMITLESS_OK) return st;
+  st = limitless__modctx_residue_ref(mc, b, &ib); if (st != LIMITLESS_OK) return st;
+  limitless__bigint_init_raw(&res);
+  st = limitless__modctx_mul(ctx, mc, &res, ia, ib);
+  if (st == LIMITLESS_OK) limitless__number_take_int(ctx, out, &res);
+  limitless__bigint_clear_raw(ctx, &res);
+  return st;
+}
+
+/* exp is a plain integer, not a residue; negative exponents return ERANGE */
+LIMITLESS_API limitless_status limitless_modctx_powmod(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a, const limitless_number* exp) {
+  const limitless_bigint* ia;
+  const limitless_bigint* ie;
+  limitless_bigint res;
+  limitless_status st;
+
+  if (!ctx || !mc || !out || !a || !exp || mc->n == 0) return LIMITLESS_EINVAL;
+  st = limitless__modctx_residue_ref(mc, a, &ia); if (st != LIMITLESS_OK) return st;
+  if (limitless__number_get_integer_ref(exp, &ie) != LIMITLESS_OK) return LIMITLESS_ETYPE;
+  if (ie->sign < 0) return LIMITLESS_ERANGE;
+  limitless__bigint_init_raw(&res);
+  st = limitless__modctx_pow(ctx, mc, &res, ia, ie);
+  if (st == LIMITLESS_OK) limitless__number_take_int(ctx, out, &res);
+  limitless__bigint_clear_raw(ctx, &res);
+  return st;
+}
+
+/* EDIVZERO when a shares a factor with m */
+LIMITLESS_API limitless_status limitless_modctx_invmod(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a) {
+  const limitless_bigint* ia;
+  limitless_bigint res;
+  limitless_status st;
+
+  if (!ctx || !mc || !out || !a || mc->n == 0) return LIMITLESS_EINVAL;
+  st = limitless__modctx_residue_ref(mc, a, &ia); if (st != LIMITLESS_OK) return st;
+  limitless__bigint_init_raw(&res);
+  /* (x R)^-1 R = x^-1 R is leave, invert, enter */
+  st = limitless__modctx_leave(ctx, mc, &res, ia);
+  if (st == LIMITLESS_OK) st = limitless__bigint_invmod(ctx, &res, &res, &mc->m);
+  if (st == LIMITLESS_OK) st = limitless__modctx_enter(ctx, mc, &res, &res);
+  if (st == LIMITLESS_OK) limitless__number_take_int(ctx, out, &res);
+  limitless__bigint_clear_raw(ctx, &res);
+  return st;
+}
+
+/*
+Constant-time multiplication and exponentiation under an odd modulus (EINVAL
+for even ones), for operands that must not leak through timing. Unlike the
+residue functions above they take and return plain values in [0, m), so no
+conversion in or out of Montgomery form runs outside the constant-time code.
+Operands are copied into n-limb buffers (the exponent into
+max(n, exp limbs)), so time depends only on the limb counts of m and the
+exponent, and the returned number reveals only how many limbs it needs.
+limitless_number_modexp and the residue functions stay variable-time.
+*/
+static limitless_status limitless__modctx_ct_operand(const limitless_modctx* mc, const limitless_number* x, limitless_limb* out, limitless_limb* t) {
+  const limitless_bigint* bx;
+  if (limitless__number_get_integer_ref(x, &bx) != LIMITLESS_OK) return LIMITLESS_ETYPE;
+  if (bx->sign < 0 || bx->used > mc->n) return LIMITLESS_ERANGE;
+  limitless__limbs_copy(out, LIMITLESS_BIGINT_LIMBS(bx), bx->used);
+  limitless__limbs_zero(out + bx->used, mc->n - bx->used);
+  /* x < m exactly when x - m borrows */
+  if (!limitless__ct_sub_n(t, out, LIMITLESS_BIGINT_LIMBS(&mc->m), mc->n)) return LIMITLESS_ERANGE;
+  return LIMITLESS_OK;
+}
+
+/* moves the n-limb span v into out; out is written only on success */
+static limitless_status limitless__modctx_ct_emit(limitless_ctx* ctx, const limitless_modctx* mc, limitless_number* out, const limitless_limb* v) {
+  limitless_bigint res;
+  limitless_status st;
+  limitless__bigint_init_raw(&res);
+  st = limitless__bigint_reserve_exact(ctx, &res, mc->n);
+  if (st == LIMITLESS_OK) {
+    limitless__limbs_copy(LIMITLESS_BIGINT_LIMBS(&res), v, mc->n);
+    res.used = mc->n;
+    res.sign = 1;
+    limitless__bigint_norm(&res);
+    limitless__number_take_int(ctx, out, &res);
+  }
+  limitless__bigint_clear_raw(ctx, &res);
+  return st;
+}
+
+LIMITLESS_API limitless_status limitless_modctx_mulmod_ct(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a, const limitless_number* b) {
+  limitless_limb* w;
+  limitless_limb* ap;
+  limitless_limb* bp;
+  limitless_limb* r2;
+  limitless_limb* t;
+  limitless_size n;
+  limitless_size wn;
+  limitless_status st;
+
+  if (!ctx || !mc || !out || !a || !b || mc->n == 0 || !mc->mont) return LIMITLESS_EINVAL;
+  n = mc->n;
+  if (n > ((~(limitless_size)0) - 2u) / 8u) return LIMITLESS_EOOM;
+  wn = 5 * n + 2;
+  w = limitless__scratch_push(ctx, wn);
+  if (!w) return LIMITLESS_EOOM;
+  ap = w;
+  bp = ap + n;
+  r2 = bp + n;
+  t = r2 + n;
+  st = limitless__modctx_ct_operand(mc, a, ap, t);
+  if (st == LIMITLESS_OK) st = limitless__modctx_ct_operand(mc, b, bp, t);
+  if (st == LIMITLESS_OK) {
+    limitless__limbs_copy(r2, LIMITLESS_BIGINT_LIMBS(&mc->r2), mc->r2.used);
+    limitless__limbs_zero(r2 + mc->r2.used, n - mc->r2.used);
+    /* (a b R^-1) R^2 R^-1 = a b */
+    limitless__ct_mont_mul(ctx, mc, ap, ap, bp, t);
+    limitless__ct_mont_mul(ctx, mc, ap, ap, r2, t);
+    st = limitless__modctx_ct_emit(ctx, mc, out, ap);
+  }
+  limitless__limbs_zero(w, wn);
+  limitless__scratch_pop(ctx, w, wn);
+  return st;
+}
+
+/* exp is a nonnegative integer of any size (ERANGE if negative) */
+LIMITLESS_API limitless_status limitless_modctx_powmod_ct(limitless_ctx* ctx, limitless_modctx* mc, limitless_number* out, const limitless_number* a, const limitless_number* exp) {
+  const limitless_bigint* ie;
+  limitless_limb* w;
+  limitless_limb* ap;
+  limitless_limb* ep;
+  limitless_limb* r2;
+  limitless_limb* one;
+  limitless_size n;
+  limitless_size en;
+  limitless_size wn;
+  limitless_status st;
+
+  if (!ctx || !mc || !out || !a || !exp || mc->n == 0 || !mc->mont) return LIMITLESS_EINVAL;
+  if (limitless__number_get_integer_ref(exp, &ie) != LIMITLESS_OK) return LIMITLESS_ETYPE;
+  if (ie->sign < 0) return LIMITLESS_ERANGE;
+  n = mc->n;
+  en = (ie->used > n) ? ie->used : n;
+  if (n > ((~(limitless_size)0) / 2u) / 32u || en > (~(limitless_size)0) / 2u) return LIMITLESS_EOOM;
+  /* a, e, R^2 and 1, then the table, accumulator, selected entry and product workspace */
+  wn = 3 * n + en + ((limitless_size)1 << LIMITLESS__CT_WINDOW) * n + 4 * n + 2;
+  w = limitless__scratch_push(ctx, wn);
+  if (!w) return LIMITLESS_EOOM;
+  ap = w;
+  ep = ap + n;
+  r2 = ep + en;
+  one = r2 + n;
+  st = limitless__modctx_ct_operand(mc, a, ap, one + n);
+  if (st == LIMITLESS_OK) {
+    limitless__limbs_copy(ep, LIMITLESS_BIGINT_LIMBS(ie), ie->used);
+    limitless__limbs_zero(ep + ie->used, en - ie->used);
+    limitless__limbs_copy(r2, LIMITLESS_BIGINT_LIMBS(&mc->r2), mc->r2.used);
+    limitless__limbs_zero(r2 + mc->r2.used, n - mc->r2.used);
+    limitless__limbs_zero(one, n);
+    one[0] = (limitless_limb)1;
+    limitless__ct_pow(ctx, mc, ap, ap, ep, en, r2, one, one + n);
+    st = limitless__modctx_ct_emit(ctx, mc, out, ap);
+  }
+  /* the table and exponent copy are derived from secrets */
+  limitless__limbs_zero(w, wn);
+  limitless__scratch_pop(ctx, w, wn);
+  return st;
+}
+
+/*
+Floor division by a machine word: q = floor(a / d) and *rem = a - q * d, so the
+remainder is always in [0, d). Either output may be NULL; with q == NULL only
+the remainder is computed and nothing is allocated when d fits in one limb.
+*/
+LIMITLESS_API limitless_status limitless_number_divmod_u64(limitless_ctx* ctx, limitless_number* q, const limitless_number* a, limitless_u64 d, limitless_u64* rem) {
+  const limitless_bigint* ia;
+  limitless_bigint qq, rr, dd;
+  limitless_number tmp;
+  limitless_u64 r = 0;
+  limitless_status st = LIMITLESS_OK;
+
+  if (!ctx || !a || (!q && !rem)) return LIMITLESS_EINVAL;
+  if (limitless__number_get_integer_ref(a, &ia) != LIMITLESS_OK) return LIMITLESS_ETYPE;
+  if (d == 0ULL) return LIMITLESS_EDIVZERO;
+
+  limitless__bigint_init_raw(&qq);
+  limitless__bigint_init_raw(&rr);
+  limitless__bigint_init_raw(&dd);
+
+  if (((d >> (LIMITLESS_LIMB_BITS - 1)) >> 1) == 0ULL) {
+    limitless__divisor dv;
+    limitless__divisor_init(&dv, (limitless_limb)d);
+    if (q) {
+      st = limitless__bigint_reserve_exact(ctx, &qq, ia->used);
       if (st != LIMITLESS_OK) goto cleanup;
-      t.used = 0; t.sign = 0;
+      r = (limitless_u64)limitless__span_divrem_1(LIMITLESS_BIGINT_LIMBS(&qq), LIMITLESS_BIGINT_LIMBS(ia), ia->used, &dv);
+      qq.used = ia->used;
+      qq.sign = 1;
+      limitless__bigint_norm(&qq);
+    } else {
+      r = (limitless_u64)limitless__span_divrem_1(NULL, LIMITLESS_BIGINT_LIMBS(ia), ia->used, &dv);
     }
-    exp >>= 1;
-    if (exp == 0ULL) break;
-    st = limitless__bigint_mul_signed(ctx, &t, &base, &base);
-    if (st != LIMITLESS_OK) goto cleanup;
-    st = limitless__bigint_mod(ctx, &base, &t, &m);
-    if (st != LIMITLESS_OK) goto cleanup;
-    t.used = 0; t.sign = 0;
+  } else {
+    /* two-limb divisor with 32-bit limbs */
+    st = limitless__bigint_set_u64(ctx, &dd, d); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__bigint_divmod_abs(ctx, &qq, &rr, ia, &dd); if (st != LIMITLESS_OK) goto cleanup;
+    st = limitless__bigint_abs_to_u64(&rr, &r); if (st != LIMITLESS_OK) goto cleanup; /* GCOVR_EXCL_BR_LINE */
   }
 
-  st = limitless_number_init(ctx, &tmp);
-  if (st != LIMITLESS_OK) goto cleanup; /* GCOVR_EXCL_BR_LINE */
-  tmp.kind = LIMITLESS_KIND_INT;
-  st = limitless__bigint_copy(ctx, &tmp.v.i, &res);
-  if (st != LIMITLESS_OK) {
+  if (ia->sign < 0) {
+    if (r != 0ULL) {
+      r = d - r;
+      if (q) {
+        st = limitless__bigint_add_small_inplace(ctx, &qq, 1u);
+        if (st != LIMITLESS_OK) goto cleanup;
+      }
+    }
+    if (qq.used != 0) qq.sign = -1;
+  }
+
+  if (q) {
+    st = limitless_number_init(ctx, &tmp);
+    if (st != LIMITLESS_OK) goto cleanup; /* GCOVR_EXCL_BR_LINE */
+    tmp.kind = LIMITLESS_KIND_INT;
+    limitless__bigint_swap(&tmp.v.i, &qq);
+    limitless__number_swap(q, &tmp);
     limitless_number_clear(ctx, &tmp);
-    goto cleanup;
   }
-  limitless__number_swap(out, &tmp);
-  limitless_number_clear(ctx, &tmp);
+  if (rem) *rem = r;
 
 cleanup:
-  limitless__bigint_clear_raw(ctx, &base);
-  limitless__bigint_clear_raw(ctx, &res);
-  limitless__bigint_clear_raw(ctx, &t);
-  limitless__bigint_clear_raw(ctx, &m);
+  limitless__bigint_clear_raw(ctx, &qq);
+  limitless__bigint_clear_raw(ctx, &rr);
+  limitless__bigint_clear_raw(ctx, &dd);
   return st;
 }
 
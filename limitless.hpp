@@ -53,11 +53,13 @@ inline void limitless_cpp__set_last_status(limitless_status st) {
 }
 
 inline void limitless_cpp__zero_raw(limitless_c_number* n) {
+  int i;
   n->kind = LIMITLESS_KIND_INT;
   n->v.i.sign = 0;
   n->v.i.used = 0;
   n->v.i.cap = 0;
   n->v.i.limbs = NULL;
+  for (i = 0; i < LIMITLESS_INLINE_LIMBS; ++i) n->v.i.inline_limbs[i] = 0;
 }
 
 inline limitless_ctx*& limitless_cpp__ctx_override_ref(void) {
@@ -71,7 +73,8 @@ inline limitless_ctx* limitless_cpp__builtin_ctx(void) {
     limitless_status st;
     limitless_cpp__ctx_holder() : st(limitless_ctx_init_default(&ctx)) {}
   };
-  static limitless_cpp__ctx_holder holder; /* GCOVR_EXCL_BR_LINE */
+  /* per thread: arithmetic writes the context's scratch counters */
+  static thread_local limitless_cpp__ctx_holder holder; /* GCOVR_EXCL_BR_LINE */
   limitless_cpp__set_last_status(holder.st);
   if (holder.st != LIMITLESS_OK) return NULL; /* GCOVR_EXCL_BR_LINE */
   return &holder.ctx;
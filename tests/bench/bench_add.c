@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: GPL-3.0-only */
+#include <stdio.h>
+#include <time.h>
+
+#define LIMITLESS_IMPLEMENTATION
+#include "../../limitless.h"
+
+/*
+Additions, subtractions and comparisons of 6.4-million-bit integers, the
+size of the cross terms when adding rationals with 100k-limb parts. Each
+operation streams its operands once, so this tracks the add_n/sub_n kernels
+and the blocked compare rather than any of the multiply tiers.
+*/
+
+#define BENCH_REPS 200
+
+static double elapsed_us(clock_t start, clock_t end) {
+  return ((double)(end - start) * 1000000.0) / (double)CLOCKS_PER_SEC;
+}
+
+/* base^exp, a cheap way to get a dense 6.4-million-bit operand */
+static limitless_status dense_power(limitless_ctx* ctx, limitless_number* out, limitless_u64 base, limitless_u64 exp) {
+  limitless_status st = limitless_number_from_u64(ctx, out, base);
+  if (st != LIMITLESS_OK) return st;
+  return limitless_number_pow_u64(ctx, out, out, exp);
+}
+
+int main(void) {
+  limitless_ctx ctx;
+  limitless_number a;
+  limitless_number b;
+  limitless_number sum;
+  limitless_number diff;
+  limitless_status st = LIMITLESS_OK;
+  int i;
+  int order = 0;
+  clock_t t0;
+  clock_t t1;
+
+  if (limitless_ctx_init_default(&ctx) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &a) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &b) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &sum) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &diff) != LIMITLESS_OK) return 1;
+  /* 3^4037000 and 5^2756000 are both just under 6.4 million bits */
+  if (dense_power(&ctx, &a, 3u, 4037000u) != LIMITLESS_OK) return 1;
+  if (dense_power(&ctx, &b, 5u, 2756000u) != LIMITLESS_OK) return 1;
+
+  t0 = clock();
+  for (i = 0; i < BENCH_REPS; ++i) {
+    if (limitless_number_add(&ctx, &sum, &a, &b) != LIMITLESS_OK) return 1;
+    if (limitless_number_sub(&ctx, &diff, &sum, &b) != LIMITLESS_OK) return 1;
+    /* equal operands: the compare has to walk every limb */
+    order += limitless_number_cmp(&ctx, &diff, &a, &st);
+    if (st != LIMITLESS_OK) return 1;
+  }
+  t1 = clock();
+  if (order != 0) return 1;
+
+  printf("%.3f\n", elapsed_us(t0, t1));
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &sum);
+  limitless_number_clear(&ctx, &diff);
+  return 0;
+}
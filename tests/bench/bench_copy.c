@@ -0,0 +1,45 @@
+/* SPDX-License-Identifier: GPL-3.0-only */
+#include <stdio.h>
+#include <time.h>
+
+#define LIMITLESS_IMPLEMENTATION
+#include "../../limitless.h"
+
+/* copies of a 10k-limb integer into a fresh output, a reused output, and through neg */
+
+static double elapsed_us(clock_t start, clock_t end) {
+  return ((double)(end - start) * 1000000.0) / (double)CLOCKS_PER_SEC;
+}
+
+int main(void) {
+  limitless_ctx ctx;
+  limitless_number three;
+  limitless_number src;
+  limitless_number dst;
+  int i;
+  clock_t t0;
+  clock_t t1;
+
+  if (limitless_ctx_init_default(&ctx) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &three) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &src) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &dst) != LIMITLESS_OK) return 1;
+  if (limitless_number_from_i64(&ctx, &three, 3) != LIMITLESS_OK) return 1;
+  /* log2(3) > 1.584, so this exponent gives just under 10000 limbs */
+  if (limitless_number_pow_u64(&ctx, &src, &three, (limitless_u64)10000 * LIMITLESS_LIMB_BITS * 1000u / 1585u) != LIMITLESS_OK) return 1;
+
+  t0 = clock();
+  for (i = 0; i < 4000; ++i) {
+    limitless_number_clear(&ctx, &dst);
+    if (limitless_number_copy(&ctx, &dst, &src) != LIMITLESS_OK) return 1;
+    if (limitless_number_copy(&ctx, &dst, &src) != LIMITLESS_OK) return 1;
+    if (limitless_number_neg(&ctx, &dst, &src) != LIMITLESS_OK) return 1;
+  }
+  t1 = clock();
+
+  printf("%.3f\n", elapsed_us(t0, t1));
+  limitless_number_clear(&ctx, &three);
+  limitless_number_clear(&ctx, &src);
+  limitless_number_clear(&ctx, &dst);
+  return 0;
+}
@@ -0,0 +1,94 @@
+/* SPDX-License-Identifier: GPL-3.0-only */
+#include <stdio.h>
+#include <time.h>
+
+#define LIMITLESS_IMPLEMENTATION
+#include "../../limitless.h"
+
+/*
+gcds of random word-sized pairs, which end in the binary word gcd and lean on
+ctz, followed by gcds of 2048-bit pairs sharing a known factor, which run the
+Lehmer loop and lean on clz, and the extended gcd of each pair, which carries
+the Lehmer matrices over to the cofactor as well.
+*/
+
+#define BENCH_WORDS 256
+#define BENCH_WORD_REPS 400000L
+#define BENCH_BIG_REPS 400
+
+static double elapsed_us(clock_t start, clock_t end) {
+  return ((double)(end - start) * 1000000.0) / (double)CLOCKS_PER_SEC;
+}
+
+static limitless_u64 next_u64(limitless_u64* x) {
+  *x ^= *x << 13;
+  *x ^= *x >> 7;
+  *x ^= *x << 17;
+  return *x;
+}
+
+static limitless_status random_big(limitless_ctx* ctx, limitless_number* out, limitless_number* word, limitless_number* shift, limitless_u64* x) {
+  limitless_status st = limitless_number_from_u64(ctx, out, next_u64(x));
+  int i;
+  for (i = 1; st == LIMITLESS_OK && i < 32; ++i) {
+    st = limitless_number_mul(ctx, out, out, shift);
+    if (st == LIMITLESS_OK) st = limitless_number_from_u64(ctx, word, next_u64(x));
+    if (st == LIMITLESS_OK) st = limitless_number_add(ctx, out, out, word);
+  }
+  return st;
+}
+
+int main(void) {
+  static limitless_number v[BENCH_WORDS];
+  limitless_ctx ctx;
+  limitless_number g;
+  limitless_number a;
+  limitless_number b;
+  limitless_number f;
+  limitless_number word;
+  limitless_number shift;
+  limitless_u64 x = 0x9e3779b97f4a7c15ULL;
+  long i;
+  clock_t t0;
+  clock_t t1;
+
+  if (limitless_ctx_init_default(&ctx) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &g) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &a) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &b) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &f) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &word) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &shift) != LIMITLESS_OK) return 1;
+  if (limitless_number_from_str(&ctx, &shift, "18446744073709551616") != LIMITLESS_OK) return 1;
+  for (i = 0; i < BENCH_WORDS; ++i) {
+    /* shared low zero bits give ctz real work */
+    limitless_u64 w = next_u64(&x) << (i % 24);
+    if (limitless_number_init(&ctx, &v[i]) != LIMITLESS_OK) return 1;
+    if (limitless_number_from_u64(&ctx, &v[i], (LIMITLESS_LIMB_BITS == 32) ? (w >> 32) | 1u << (i % 24) : w) != LIMITLESS_OK) return 1;
+  }
+
+  t0 = clock();
+  for (i = 0; i < BENCH_WORD_REPS; ++i) {
+    if (limitless_number_gcd(&ctx, &g, &v[i & (BENCH_WORDS - 1)], &v[(i * 7 + 3) & (BENCH_WORDS - 1)]) != LIMITLESS_OK) return 1;
+  }
+  for (i = 0; i < BENCH_BIG_REPS; ++i) {
+    if (random_big(&ctx, &f, &word, &shift, &x) != LIMITLESS_OK) return 1;
+    if (random_big(&ctx, &a, &word, &shift, &x) != LIMITLESS_OK) return 1;
+    if (random_big(&ctx, &b, &word, &shift, &x) != LIMITLESS_OK) return 1;
+    if (limitless_number_mul(&ctx, &a, &a, &f) != LIMITLESS_OK) return 1;
+    if (limitless_number_mul(&ctx, &b, &b, &f) != LIMITLESS_OK) return 1;
+    if (limitless_number_gcd(&ctx, &g, &a, &b) != LIMITLESS_OK) return 1;
+    if (limitless_number_gcdext(&ctx, &g, &a, NULL, &a, &b) != LIMITLESS_OK) return 1;
+  }
+  t1 = clock();
+
+  printf("%.3f\n", elapsed_us(t0, t1));
+  for (i = 0; i < BENCH_WORDS; ++i) limitless_number_clear(&ctx, &v[i]);
+  limitless_number_clear(&ctx, &g);
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &f);
+  limitless_number_clear(&ctx, &word);
+  limitless_number_clear(&ctx, &shift);
+  return 0;
+}
@@ -0,0 +1,127 @@
+/* SPDX-License-Identifier: GPL-3.0-only */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define LIMITLESS_IMPLEMENTATION
+#include "../../limitless.h"
+
+/*
+Prints one row per operand size: the time of a balanced multiply with toom-3
+disabled (karatsuba recursion only), with toom-3 forced at the top level and
+with the ntt tier forced. The crossover is the first size where a column wins
+consistently; compile with -DLIMITLESS_LIMB_BITS=32 and =64 to tune both limb
+widths. The allocs column counts allocator calls per karatsuba multiply.
+*/
+
+#define BENCH_HEX_CAP 262200
+
+static unsigned long alloc_calls;
+
+static void* counting_alloc(void* user, limitless_size size) {
+  (void)user;
+  ++alloc_calls;
+  return malloc((size_t)size);
+}
+
+static void* counting_realloc(void* user, void* ptr, limitless_size old_size, limitless_size new_size) {
+  (void)user;
+  (void)old_size;
+  ++alloc_calls;
+  return realloc(ptr, (size_t)new_size);
+}
+
+static void counting_free(void* user, void* ptr, limitless_size size) {
+  (void)user;
+  (void)size;
+  free(ptr);
+}
+
+static double elapsed_us(clock_t start, clock_t end) {
+  return ((double)(end - start) * 1000000.0) / (double)CLOCKS_PER_SEC;
+}
+
+static limitless_u64 rng_next(limitless_u64* state) {
+  limitless_u64 x = *state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  *state = x;
+  return x;
+}
+
+static int fill_random(limitless_ctx* ctx, limitless_number* n, int limbs, limitless_u64* state) {
+  static char hex[BENCH_HEX_CAP];
+  int digits = limbs * (LIMITLESS_LIMB_BITS / 4);
+  int i;
+  if (digits + 1 > BENCH_HEX_CAP) return 0;
+  for (i = 0; i < digits; ++i) {
+    hex[i] = "0123456789abcdef"[rng_next(state) & 15u];
+  }
+  hex[0] = 'f';
+  hex[digits] = '\0';
+  return limitless_number_from_cstr(ctx, n, hex, 16) == LIMITLESS_OK;
+}
+
+static double time_mul(limitless_ctx* ctx, limitless_number* out, const limitless_number* a, const limitless_number* b, int reps) {
+  int i;
+  clock_t t0;
+  clock_t t1;
+  t0 = clock();
+  for (i = 0; i < reps; ++i) {
+    if (limitless_number_mul(ctx, out, a, b) != LIMITLESS_OK) return -1.0;
+  }
+  t1 = clock();
+  return elapsed_us(t0, t1) / (double)reps;
+}
+
+int main(void) {
+  static const int sizes[] = {48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096, 6144, 8192};
+  limitless_ctx ctx;
+  limitless_alloc alloc;
+  limitless_number a;
+  limitless_number b;
+  limitless_number out;
+  limitless_u64 state = 0x9e3779b97f4a7c15ULL;
+  size_t i;
+
+  alloc.alloc = counting_alloc;
+  alloc.realloc = counting_realloc;
+  alloc.free = counting_free;
+  alloc.user = NULL;
+  if (limitless_ctx_init(&ctx, &alloc) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &a) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &b) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &out) != LIMITLESS_OK) return 1;
+
+  printf("limb_bits=%d karatsuba_threshold=%lu\n", LIMITLESS_LIMB_BITS, (unsigned long)ctx.karatsuba_threshold);
+  printf("%8s %14s %14s %14s %8s\n", "limbs", "karatsuba_us", "toom3_us", "ntt_us", "allocs");
+  for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+    int limbs = sizes[i];
+    int reps = (int)(40000000L / ((long)limbs * (long)limbs)) + 1;
+    double tk;
+    double tt;
+    double tn;
+    unsigned long allocs;
+    if (!fill_random(&ctx, &a, limbs, &state)) return 1;
+    if (!fill_random(&ctx, &b, limbs, &state)) return 1;
+
+    limitless_ctx_set_ntt_threshold(&ctx, ~(limitless_size)0);
+    limitless_ctx_set_toom3_threshold(&ctx, ~(limitless_size)0);
+    alloc_calls = 0;
+    tk = time_mul(&ctx, &out, &a, &b, 1);
+    allocs = alloc_calls;
+    tk = time_mul(&ctx, &out, &a, &b, reps);
+    limitless_ctx_set_toom3_threshold(&ctx, (limitless_size)limbs);
+    tt = time_mul(&ctx, &out, &a, &b, reps);
+    limitless_ctx_set_ntt_threshold(&ctx, (limitless_size)limbs);
+    tn = time_mul(&ctx, &out, &a, &b, reps);
+    if (tk < 0.0 || tt < 0.0 || tn < 0.0) return 1;
+    printf("%8d %14.3f %14.3f %14.3f %8lu\n", limbs, tk, tt, tn, allocs);
+  }
+
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &out);
+  return 0;
+}
@@ -9,12 +9,23 @@ static double elapsed_us(clock_t start, clock_t end) {
   return ((double)(end - start) * 1000000.0) / (double)CLOCKS_PER_SEC;
 }
 
+/*
+pow_u64 and modexp_u64 on word-sized values, then modexp_u64 with a 64-bit
+exponent under an odd and an even 2048-bit modulus, which run the Montgomery
+and Barrett reductions, then RSA-sized modexp calls whose exponent is as long
+as the 1024-, 2048- or 4096-bit modulus, then a chain of products and sums
+of residues under one limitless_modctx.
+*/
 int main(void) {
   limitless_ctx ctx;
   limitless_number base;
   limitless_number mod;
   limitless_number out;
+  limitless_number big;
+  limitless_number exp;
+  limitless_modctx mc;
   int i;
+  int k;
   clock_t t0;
   clock_t t1;
 
@@ -22,6 +33,8 @@ int main(void) {
   if (limitless_number_init(&ctx, &base) != LIMITLESS_OK) return 1;
   if (limitless_number_init(&ctx, &mod) != LIMITLESS_OK) return 1;
   if (limitless_number_init(&ctx, &out) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &big) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &exp) != LIMITLESS_OK) return 1;
 
   if (limitless_number_from_str(&ctx, &base, "123456789") != LIMITLESS_OK) return 1;
   if (limitless_number_from_str(&ctx, &mod, "1000000007") != LIMITLESS_OK) return 1;
@@ -31,11 +44,51 @@ int main(void) {
     if (limitless_number_pow_u64(&ctx, &out, &base, 17) != LIMITLESS_OK) return 1;
     if (limitless_number_modexp_u64(&ctx, &out, &base, 29, &mod) != LIMITLESS_OK) return 1;
   }
+  /* 2^2048 - 159 is odd, 2^2048 - 160 even; the base is 3^1200, about 1900 bits */
+  if (limitless_number_from_u64(&ctx, &big, 3) != LIMITLESS_OK) return 1;
+  if (limitless_number_pow_u64(&ctx, &big, &big, 1200) != LIMITLESS_OK) return 1;
+  for (k = 0; k < 2; ++k) {
+    if (limitless_number_from_u64(&ctx, &mod, 2) != LIMITLESS_OK) return 1;
+    if (limitless_number_pow_u64(&ctx, &mod, &mod, 2048) != LIMITLESS_OK) return 1;
+    if (limitless_number_from_i64(&ctx, &out, k == 0 ? -159 : -160) != LIMITLESS_OK) return 1;
+    if (limitless_number_add(&ctx, &mod, &mod, &out) != LIMITLESS_OK) return 1;
+    for (i = 0; i < 20; ++i) {
+      if (limitless_number_modexp_u64(&ctx, &out, &big, 0xfedcba9876543211ULL, &mod) != LIMITLESS_OK) return 1;
+    }
+  }
+  /* modulus 2^bits - 159 and an exponent 3^(bits * 0.63), just under bits long; four calls at 1024 bits, two at 2048, one at 4096 */
+  for (k = 0; k < 3; ++k) {
+    limitless_u64 bits = 1024u << k;
+    if (limitless_number_from_u64(&ctx, &mod, 2) != LIMITLESS_OK) return 1;
+    if (limitless_number_pow_u64(&ctx, &mod, &mod, bits) != LIMITLESS_OK) return 1;
+    if (limitless_number_from_i64(&ctx, &out, -159) != LIMITLESS_OK) return 1;
+    if (limitless_number_add(&ctx, &mod, &mod, &out) != LIMITLESS_OK) return 1;
+    if (limitless_number_from_u64(&ctx, &exp, 3) != LIMITLESS_OK) return 1;
+    if (limitless_number_pow_u64(&ctx, &exp, &exp, bits * 630u / 1000u) != LIMITLESS_OK) return 1;
+    for (i = 0; i < (4 >> k); ++i) {
+      if (limitless_number_modexp(&ctx, &out, &big, &exp, &mod) != LIMITLESS_OK) return 1;
+    }
+  }
+  /* 2000 mulmod + addmod steps under 2^2048 - 159, built once */
+  if (limitless_number_from_u64(&ctx, &mod, 2) != LIMITLESS_OK) return 1;
+  if (limitless_number_pow_u64(&ctx, &mod, &mod, 2048) != LIMITLESS_OK) return 1;
+  if (limitless_number_from_i64(&ctx, &out, -159) != LIMITLESS_OK) return 1;
+  if (limitless_number_add(&ctx, &mod, &mod, &out) != LIMITLESS_OK) return 1;
+  if (limitless_modctx_init(&ctx, &mc, &mod) != LIMITLESS_OK) return 1;
+  if (limitless_modctx_to_residue(&ctx, &mc, &big, &big) != LIMITLESS_OK) return 1;
+  if (limitless_number_copy(&ctx, &out, &big) != LIMITLESS_OK) return 1;
+  for (i = 0; i < 2000; ++i) {
+    if (limitless_modctx_mulmod(&ctx, &mc, &out, &out, &big) != LIMITLESS_OK) return 1;
+    if (limitless_modctx_addmod(&ctx, &mc, &out, &out, &big) != LIMITLESS_OK) return 1;
+  }
+  limitless_modctx_clear(&ctx, &mc);
   t1 = clock();
 
   printf("%.3f\n", elapsed_us(t0, t1));
   limitless_number_clear(&ctx, &base);
   limitless_number_clear(&ctx, &mod);
   limitless_number_clear(&ctx, &out);
+  limitless_number_clear(&ctx, &big);
+  limitless_number_clear(&ctx, &exp);
   return 0;
 }
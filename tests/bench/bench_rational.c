@@ -0,0 +1,49 @@
+/* SPDX-License-Identifier: GPL-3.0-only */
+#include <stdio.h>
+#include <time.h>
+
+#define LIMITLESS_IMPLEMENTATION
+#include "../../limitless.h"
+
+static double elapsed_us(clock_t start, clock_t end) {
+  return ((double)(end - start) * 1000000.0) / (double)CLOCKS_PER_SEC;
+}
+
+/*
+Rational-heavy workload: the harmonic sum 1 + 1/2 + ... + 1/n, whose reduced
+numerator and denominator grow to roughly n * log2(e) bits. Each addition
+runs a gcd between the running denominator and k, so this tracks the reduced
+rational add/mul paths rather than the large-operand gcd tiers.
+*/
+int main(void) {
+  limitless_ctx ctx;
+  limitless_number sum;
+  limitless_number one;
+  limitless_number k;
+  limitless_number term;
+  int i;
+  clock_t t0;
+  clock_t t1;
+
+  if (limitless_ctx_init_default(&ctx) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &sum) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &one) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &k) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &term) != LIMITLESS_OK) return 1;
+  if (limitless_number_from_u64(&ctx, &one, 1) != LIMITLESS_OK) return 1;
+
+  t0 = clock();
+  for (i = 1; i <= 3000; ++i) {
+    if (limitless_number_from_u64(&ctx, &k, (limitless_u64)i) != LIMITLESS_OK) return 1;
+    if (limitless_number_div(&ctx, &term, &one, &k) != LIMITLESS_OK) return 1;
+    if (limitless_number_add(&ctx, &sum, &sum, &term) != LIMITLESS_OK) return 1;
+  }
+  t1 = clock();
+
+  printf("%.3f\n", elapsed_us(t0, t1));
+  limitless_number_clear(&ctx, &sum);
+  limitless_number_clear(&ctx, &one);
+  limitless_number_clear(&ctx, &k);
+  limitless_number_clear(&ctx, &term);
+  return 0;
+}
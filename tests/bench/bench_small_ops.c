@@ -0,0 +1,92 @@
+/* SPDX-License-Identifier: GPL-3.0-only */
+#include <stdio.h>
+#include <time.h>
+
+#define LIMITLESS_IMPLEMENTATION
+#include "../../limitless.h"
+
+/*
+Prints ns/op for add, sub and mul loops over small integers to stderr. The
+word row uses operands below 2^31, so every result stays on the i64 fast
+path; the limb row widens the same operands past 2^64 (still within the
+inline limbs), which forces the limb path, so the gap between rows is what
+the word path saves. stdout gets the total microseconds of the word row,
+which is what the benchmark regression gate tracks.
+*/
+
+#define BENCH_VALUES 256
+#define BENCH_REPS 2000000L
+
+static double elapsed_ns(clock_t start, clock_t end) {
+  return ((double)(end - start) * 1000000000.0) / (double)CLOCKS_PER_SEC;
+}
+
+static double time_op(limitless_ctx* ctx, limitless_number* out, const limitless_number* v, int op) {
+  long i;
+  clock_t t0;
+  clock_t t1;
+  limitless_status st = LIMITLESS_OK;
+  t0 = clock();
+  for (i = 0; i < BENCH_REPS; ++i) {
+    const limitless_number* a = &v[i & (BENCH_VALUES - 1)];
+    const limitless_number* b = &v[(i * 7 + 3) & (BENCH_VALUES - 1)];
+    if (op == 0) st = limitless_number_add(ctx, out, a, b);
+    else if (op == 1) st = limitless_number_sub(ctx, out, a, b);
+    else st = limitless_number_mul(ctx, out, a, b);
+    if (st != LIMITLESS_OK) return -1.0;
+  }
+  t1 = clock();
+  return elapsed_ns(t0, t1) / (double)BENCH_REPS;
+}
+
+int main(void) {
+  static limitless_number v[BENCH_VALUES];
+  limitless_ctx ctx;
+  limitless_number out;
+  limitless_number shift;
+  limitless_u64 x = 0x9e3779b97f4a7c15ULL;
+  double word_us = 0.0;
+  int row;
+  int i;
+
+  if (limitless_ctx_init_default(&ctx) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &out) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &shift) != LIMITLESS_OK) return 1;
+  if (limitless_number_from_str(&ctx, &shift, "18446744073709551616") != LIMITLESS_OK) return 1;
+  for (i = 0; i < BENCH_VALUES; ++i) {
+    limitless_i64 s;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    s = (limitless_i64)(x >> 33);
+    if (x & 1u) s = -s;
+    if (limitless_number_init(&ctx, &v[i]) != LIMITLESS_OK) return 1;
+    if (limitless_number_from_i64(&ctx, &v[i], s) != LIMITLESS_OK) return 1;
+  }
+
+  fprintf(stderr, "%6s %10s %10s %10s\n", "path", "add_ns", "sub_ns", "mul_ns");
+  for (row = 0; row < 2; ++row) {
+    double ta;
+    double ts;
+    double tm;
+    if (row == 1) {
+      /* v * 2^64 + v: same low word, but too wide for the word path */
+      for (i = 0; i < BENCH_VALUES; ++i) {
+        if (limitless_number_mul(&ctx, &out, &v[i], &shift) != LIMITLESS_OK) return 1;
+        if (limitless_number_add(&ctx, &v[i], &v[i], &out) != LIMITLESS_OK) return 1;
+      }
+    }
+    ta = time_op(&ctx, &out, v, 0);
+    ts = time_op(&ctx, &out, v, 1);
+    tm = time_op(&ctx, &out, v, 2);
+    if (ta < 0.0 || ts < 0.0 || tm < 0.0) return 1;
+    fprintf(stderr, "%6s %10.2f %10.2f %10.2f\n", row == 0 ? "word" : "limb", ta, ts, tm);
+    if (row == 0) word_us = (ta + ts + tm) * (double)BENCH_REPS / 1000.0;
+  }
+  printf("%.3f\n", word_us);
+
+  for (i = 0; i < BENCH_VALUES; ++i) limitless_number_clear(&ctx, &v[i]);
+  limitless_number_clear(&ctx, &out);
+  limitless_number_clear(&ctx, &shift);
+  return 0;
+}
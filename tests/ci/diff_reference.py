@@ -57,6 +57,20 @@ def random_int(rng: random.Random, max_digits: int, positive_only: bool = False)
     return n
 
 
+def random_hex_int(rng: random.Random, max_digits: int) -> int:
+    if rng.randrange(9) == 0:
+        return 0
+    digits = rng.randrange(1, max_digits + 1)
+    if rng.randrange(4) == 0:
+        # all-ones operands push every convolution coefficient to its maximum
+        n = (1 << (4 * digits)) - 1
+    else:
+        n = rng.getrandbits(4 * digits) | (1 << (4 * digits - 1))
+    if rng.randrange(2) == 0:
+        n = -n
+    return n
+
+
 def random_fraction_literal(rng: random.Random) -> str:
     num = random_int(rng, 70, positive_only=False)
     if rng.randrange(3) != 0:
@@ -67,6 +81,29 @@ def random_fraction_literal(rng: random.Random) -> str:
     return f"{num}/{den}"
 
 
+def gcdext_ref(a: int, b: int) -> str:
+    # the Bezout cofactor of a nearest zero, |s| <= |b| / (2g), and t from s a + t b = g
+    g = math.gcd(a, b)
+    if b == 0:
+        s = (a > 0) - (a < 0)
+        t = 0
+    else:
+        period = abs(b) // g
+        s = pow(a // g, -1, period) if period > 1 else 0
+        if 2 * s > period:
+            s -= period
+        t = (g - s * a) // b
+    return f"{int_to_base(g, 10)} {int_to_base(s, 10)} {int_to_base(t, 10)}"
+
+
+def expect_invmod(cli: str, a: int, m: int) -> None:
+    args = [int_to_base(a, 10), int_to_base(m, 10)]
+    if m == 0 or math.gcd(a, m) != 1:
+        expect_err(cli, "invmod", args, LIMITLESS_EDIVZERO)
+    else:
+        expect_ok(cli, "invmod", args, int_to_base(pow(a, -1, abs(m)), 10))
+
+
 def run_cli(cli: str, *args: str) -> tuple[bool, str | int]:
     cp = subprocess.run([cli, *args], check=False, capture_output=True, text=True)
     out = cp.stdout.strip()
@@ -134,8 +171,12 @@ def main() -> int:
                 ai = a.numerator
                 bi = b.numerator
                 expect_ok(args.cli, "gcd", [a_s, b_s], str(math.gcd(abs(ai), abs(bi))))
+                expect_ok(args.cli, "gcdext", [a_s, b_s], gcdext_ref(ai, bi))
+                expect_invmod(args.cli, ai, bi)
             else:
                 expect_err(args.cli, "gcd", [a_s, b_s], LIMITLESS_ETYPE)
+                expect_err(args.cli, "gcdext", [a_s, b_s], LIMITLESS_ETYPE)
+                expect_err(args.cli, "invmod", [a_s, b_s], LIMITLESS_ETYPE)
 
             if a.denominator == 1 and abs(a.numerator) <= 10**6:
                 ai = a.numerator
@@ -159,6 +200,7 @@ def main() -> int:
                     pass
                 else:
                     expect_ok(args.cli, "modexp", [a_s, str(exp), b_s], str(pow(a.numerator, exp, bi)))
+                    expect_ok(args.cli, "modexp_big", [a_s, str(exp), b_s], str(pow(a.numerator, exp, bi)))
 
             if a.denominator != 1:
                 expect_err(args.cli, "to_i64", [a_s], LIMITLESS_ETYPE)
@@ -175,6 +217,34 @@ def main() -> int:
                 else:
                     expect_err(args.cli, "to_u64", [a_s], LIMITLESS_ERANGE)
 
+            # Large products through every multiplication tier; a subset keeps runtime bounded.
+            if rng.randrange(4) == 0:
+                x = random_hex_int(rng, 3000)
+                y = x if rng.randrange(3) == 0 else random_hex_int(rng, 3000)
+                expect_ok(args.cli, "mul_tiers", [int_to_base(x, 16), int_to_base(y, 16)], int_to_base(x * y, 16))
+                g = random_hex_int(rng, 800)
+                # int_to_base sidesteps the interpreter's decimal conversion digit limit
+                expect_ok(args.cli, "gcd", [int_to_base(x * g, 10), int_to_base(y * g, 10)], int_to_base(math.gcd(x * g, y * g), 10))
+                m = abs(random_hex_int(rng, 1500))
+                if m > 0:
+                    expect_ok(args.cli, "mod_tiers", [int_to_base(x * y, 16), int_to_base(m, 16)], int_to_base(x * y % m, 16))
+                # Montgomery (odd) and Barrett (even) reduction over a few dozen limbs
+                m = abs(random_hex_int(rng, 160)) | 1
+                if rng.randrange(2) == 0:
+                    m += 1
+                e = rng.getrandbits(64)
+                expect_ok(args.cli, "modexp", [int_to_base(x, 10), str(e), int_to_base(m, 10)], int_to_base(pow(x, e, m), 10))
+                e = rng.getrandbits(rng.choice([65, 300, 1100]))
+                expect_ok(args.cli, "modexp_big", [int_to_base(x, 10), int_to_base(e, 10), int_to_base(m, 10)], int_to_base(pow(x, e, m), 10))
+                # Modular division through a reusable modulus context
+                if math.gcd(y, m) == 1:
+                    expect_ok(args.cli, "moddiv", [int_to_base(x, 10), int_to_base(y, 10), int_to_base(m, 10)], int_to_base(x * pow(y, -1, m) % m, 10))
+                else:
+                    expect_err(args.cli, "moddiv", [int_to_base(x, 10), int_to_base(y, 10), int_to_base(m, 10)], LIMITLESS_EDIVZERO)
+                # Extended gcd through the Lehmer and half-gcd tiers, with a shared factor and without
+                expect_ok(args.cli, "gcdext", [int_to_base(x * g, 10), int_to_base(y * g, 10)], gcdext_ref(x * g, y * g))
+                expect_invmod(args.cli, x, y)
+
             fmt_expected = frac_to_base_str(a, base)
             expect_ok(args.cli, "fmt", [a_s, str(base)], fmt_expected)
             expect_ok(args.cli, "parse_base", [fmt_expected, str(base)], frac_to_str(a))
@@ -35,22 +35,29 @@ static int parse_base_arg(const char* s, int* out) {
   return 1;
 }
 
-static int print_number_base(limitless_ctx* ctx, const limitless_number* n, int base) {
+/* the digits of n in a malloc'd string, or NULL with *st set */
+static char* format_number(limitless_ctx* ctx, const limitless_number* n, int base, limitless_status* st) {
   limitless_size need = 0;
   char* out;
-  limitless_status st = limitless_number_to_cstr(ctx, n, base, NULL, 0, &need);
-  if (st != LIMITLESS_EBUF && st != LIMITLESS_OK) {
-    print_err(st);
-    return 1;
-  }
+  *st = limitless_number_to_cstr(ctx, n, base, NULL, 0, &need);
+  if (*st != LIMITLESS_EBUF && *st != LIMITLESS_OK) return NULL;
   out = (char*)malloc((size_t)need + 1u);
   if (!out) {
-    print_err(LIMITLESS_EOOM);
-    return 1;
+    *st = LIMITLESS_EOOM;
+    return NULL;
   }
-  st = limitless_number_to_cstr(ctx, n, base, out, need + 1u, NULL);
-  if (st != LIMITLESS_OK) {
+  *st = limitless_number_to_cstr(ctx, n, base, out, need + 1u, NULL);
+  if (*st != LIMITLESS_OK) {
     free(out);
+    return NULL;
+  }
+  return out;
+}
+
+static int print_number_base(limitless_ctx* ctx, const limitless_number* n, int base) {
+  limitless_status st;
+  char* out = format_number(ctx, n, base, &st);
+  if (!out) {
     print_err(st);
     return 1;
   }
@@ -59,10 +66,32 @@ static int print_number_base(limitless_ctx* ctx, const limitless_number* n, int
   return 0;
 }
 
+/* OK:<x> <y> <z> for ops with three results */
+static int print_number3(limitless_ctx* ctx, const limitless_number* x, const limitless_number* y, const limitless_number* z) {
+  limitless_status st = LIMITLESS_OK;
+  char* sx = format_number(ctx, x, 10, &st);
+  char* sy = sx ? format_number(ctx, y, 10, &st) : NULL;
+  char* sz = sy ? format_number(ctx, z, 10, &st) : NULL;
+  if (sz) printf("OK:%s %s %s\n", sx, sy, sz);
+  else print_err(st);
+  free(sx);
+  free(sy);
+  free(sz);
+  return sz ? 0 : 1;
+}
+
 static int print_number(limitless_ctx* ctx, const limitless_number* n) {
   return print_number_base(ctx, n, 10);
 }
 
+static limitless_status mul_with_tiers(limitless_ctx* ctx, limitless_number* out, const limitless_number* a, const limitless_number* b,
+                                       limitless_size karatsuba, limitless_size toom3, limitless_size ntt) {
+  limitless_ctx_set_karatsuba_threshold(ctx, karatsuba);
+  limitless_ctx_set_toom3_threshold(ctx, toom3);
+  limitless_ctx_set_ntt_threshold(ctx, ntt);
+  return limitless_number_mul(ctx, out, a, b);
+}
+
 int main(int argc, char** argv) {
   const char* op;
   limitless_ctx ctx;
@@ -76,8 +105,10 @@ int main(int argc, char** argv) {
             "usage: %s <op> <a> [b] [c]\n"
             "  unary: neg|abs|parse|to_i64|to_u64\n"
             "  unary+arg: parse_base <a> <base>, fmt <a> <base>, pow <a> <exp>\n"
-            "  binary: add|sub|mul|div|gcd|cmp <a> <b>\n"
-            "  ternary: modexp <a> <exp> <mod>\n",
+            "  binary: add|sub|mul|div|gcd|invmod|cmp <a> <b>, gcdext <a> <b> (prints g s t)\n"
+            "  binary (base 16): mul_tiers <a> <b>, mod_tiers <a> <mod>\n"
+            "  ternary: modexp <a> <exp> <mod> (u64 exp), modexp_big <a> <exp> <mod>,\n"
+            "           moddiv <a> <b> <mod> (a * b^-1 through a limitless_modctx)\n",
             argv[0]);
     return 2;
   }
@@ -191,6 +222,156 @@ int main(int argc, char** argv) {
     goto done;
   }
 
+  if (strcmp(op, "mul_tiers") == 0) {
+    static const char* const tier_names[4] = {"schoolbook", "karatsuba", "toom3", "ntt"};
+    static const limitless_size never = ~(limitless_size)0;
+    const limitless_size tiers[4][3] = {{never, never, never}, {2, never, never}, {2, 3, never}, {2, never, 2}};
+    limitless_ctx base_ctx;
+    limitless_number ref;
+    const limitless_number* pb = &b;
+    int t;
+    if (argc < 4) {
+      fprintf(stderr, "mul_tiers requires two operands\n");
+      return 2;
+    }
+    st = limitless_number_from_cstr(&ctx, &a, argv[2], 16);
+    if (st == LIMITLESS_OK) st = limitless_number_from_cstr(&ctx, &b, argv[3], 16);
+    if (st != LIMITLESS_OK) {
+      print_err(st);
+      goto done;
+    }
+    /* equal operands are passed as one object so the squaring kernels run */
+    if (strcmp(argv[2], argv[3]) == 0) pb = &a;
+    /* the default thresholds pick the tier; every forced tier must agree with it bit for bit */
+    base_ctx = ctx;
+    st = limitless_number_mul(&ctx, &out, &a, pb);
+    if (st != LIMITLESS_OK) {
+      print_err(st);
+      goto done;
+    }
+    if (limitless_number_init(&ctx, &ref) != LIMITLESS_OK) {
+      print_err(LIMITLESS_EOOM);
+      goto done;
+    }
+    for (t = 0; t < 4; ++t) {
+      st = mul_with_tiers(&ctx, &ref, &a, pb, tiers[t][0], tiers[t][1], tiers[t][2]);
+      if (st != LIMITLESS_OK) {
+        print_err(st);
+        break;
+      }
+      if (limitless_number_cmp(&ctx, &ref, &out, NULL) != 0) {
+        printf("MISMATCH:%s\n", tier_names[t]);
+        st = LIMITLESS_EINVAL;
+        break;
+      }
+    }
+    limitless_number_clear(&ctx, &ref);
+    ctx = base_ctx;
+    if (st == LIMITLESS_OK) (void)print_number_base(&ctx, &out, 16);
+    goto done;
+  }
+
+  if (strcmp(op, "mod_tiers") == 0) {
+    static const char* const tier_names[2] = {"knuth", "bz"};
+    const limitless_size tiers[2] = {~(limitless_size)0, 2};
+    limitless_ctx base_ctx;
+    limitless_number ref;
+    int t;
+    if (argc < 4) {
+      fprintf(stderr, "mod_tiers requires two operands\n");
+      return 2;
+    }
+    st = limitless_number_from_cstr(&ctx, &a, argv[2], 16);
+    if (st == LIMITLESS_OK) st = limitless_number_from_cstr(&ctx, &b, argv[3], 16);
+    if (st != LIMITLESS_OK) {
+      print_err(st);
+      goto done;
+    }
+    /* a^1 mod m is a single reduction, so it isolates the division tiers */
+    base_ctx = ctx;
+    st = limitless_number_modexp_u64(&ctx, &out, &a, 1, &b);
+    if (st != LIMITLESS_OK) {
+      print_err(st);
+      goto done;
+    }
+    if (limitless_number_init(&ctx, &ref) != LIMITLESS_OK) {
+      print_err(LIMITLESS_EOOM);
+      goto done;
+    }
+    for (t = 0; t < 2; ++t) {
+      limitless_ctx_set_bz_threshold(&ctx, tiers[t]);
+      st = limitless_number_modexp_u64(&ctx, &ref, &a, 1, &b);
+      if (st != LIMITLESS_OK) {
+        print_err(st);
+        break;
+      }
+      if (limitless_number_cmp(&ctx, &ref, &out, NULL) != 0) {
+        printf("MISMATCH:%s\n", tier_names[t]);
+        st = LIMITLESS_EINVAL;
+        break;
+      }
+    }
+    limitless_number_clear(&ctx, &ref);
+    ctx = base_ctx;
+    if (st == LIMITLESS_OK) (void)print_number_base(&ctx, &out, 16);
+    goto done;
+  }
+
+  if (strcmp(op, "modexp_big") == 0) {
+    limitless_number e;
+    if (argc < 5) {
+      fprintf(stderr, "modexp_big requires three operands\n");
+      return 2;
+    }
+    if (limitless_number_init(&ctx, &e) != LIMITLESS_OK) {
+      print_err(LIMITLESS_EOOM);
+      goto done;
+    }
+    st = limitless_number_from_str(&ctx, &a, argv[2]);
+    if (st == LIMITLESS_OK) st = limitless_number_from_str(&ctx, &e, argv[3]);
+    if (st == LIMITLESS_OK) st = limitless_number_from_str(&ctx, &b, argv[4]);
+    if (st == LIMITLESS_OK) st = limitless_number_modexp(&ctx, &out, &a, &e, &b);
+    limitless_number_clear(&ctx, &e);
+    if (st != LIMITLESS_OK) {
+      print_err(st);
+      goto done;
+    }
+    (void)print_number(&ctx, &out);
+    goto done;
+  }
+
+  if (strcmp(op, "moddiv") == 0) {
+    limitless_number m;
+    limitless_modctx mc;
+    if (argc < 5) {
+      fprintf(stderr, "moddiv requires three operands\n");
+      return 2;
+    }
+    if (limitless_number_init(&ctx, &m) != LIMITLESS_OK) {
+      print_err(LIMITLESS_EOOM);
+      goto done;
+    }
+    st = limitless_number_from_str(&ctx, &a, argv[2]);
+    if (st == LIMITLESS_OK) st = limitless_number_from_str(&ctx, &b, argv[3]);
+    if (st == LIMITLESS_OK) st = limitless_number_from_str(&ctx, &m, argv[4]);
+    if (st == LIMITLESS_OK) st = limitless_modctx_init(&ctx, &mc, &m);
+    if (st == LIMITLESS_OK) {
+      st = limitless_modctx_to_residue(&ctx, &mc, &a, &a);
+      if (st == LIMITLESS_OK) st = limitless_modctx_to_residue(&ctx, &mc, &b, &b);
+      if (st == LIMITLESS_OK) st = limitless_modctx_invmod(&ctx, &mc, &b, &b);
+      if (st == LIMITLESS_OK) st = limitless_modctx_mulmod(&ctx, &mc, &out, &a, &b);
+      if (st == LIMITLESS_OK) st = limitless_modctx_from_residue(&ctx, &mc, &out, &out);
+      limitless_modctx_clear(&ctx, &mc);
+    }
+    limitless_number_clear(&ctx, &m);
+    if (st != LIMITLESS_OK) {
+      print_err(st);
+      goto done;
+    }
+    (void)print_number(&ctx, &out);
+    goto done;
+  }
+
   if (strcmp(op, "modexp") == 0) {
     limitless_u64 exp = 0;
     if (argc < 5) {
@@ -243,6 +424,17 @@ int main(int argc, char** argv) {
   else if (strcmp(op, "mul") == 0) st = limitless_number_mul(&ctx, &out, &a, &b);
   else if (strcmp(op, "div") == 0) st = limitless_number_div(&ctx, &out, &a, &b);
   else if (strcmp(op, "gcd") == 0) st = limitless_number_gcd(&ctx, &out, &a, &b);
+  else if (strcmp(op, "invmod") == 0) st = limitless_number_invmod(&ctx, &out, &a, &b);
+  else if (strcmp(op, "gcdext") == 0) {
+    /* the cofactors overwrite the operands */
+    st = limitless_number_gcdext(&ctx, &out, &a, &b, &a, &b);
+    if (st != LIMITLESS_OK) {
+      print_err(st);
+      goto done;
+    }
+    (void)print_number3(&ctx, &out, &a, &b);
+    goto done;
+  }
   else if (strcmp(op, "cmp") == 0) {
     limitless_status cst = LIMITLESS_OK;
     int cmp = limitless_number_cmp(&ctx, &a, &b, &cst);
@@ -0,0 +1,16 @@
+#!/usr/bin/env bash
+# SPDX-License-Identifier: GPL-3.0-only
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/../.." && pwd)"
+cd "$ROOT_DIR"
+
+CC_BIN="${CC_BIN:-gcc}"
+BUILD_DIR="$ROOT_DIR/build/bench"
+mkdir -p "$BUILD_DIR"
+
+for bits in 32 64; do
+  "$CC_BIN" -std=c99 -O2 -Wall -Wextra -Werror -pedantic -DLIMITLESS_LIMB_BITS="$bits" \
+    tests/bench/bench_mul_crossover.c -o "$BUILD_DIR/bench_mul_crossover_limb$bits"
+  "$BUILD_DIR/bench_mul_crossover_limb$bits"
+done
@@ -13,7 +13,8 @@ mkdir -p "$BUILD_DIR"
 compile_bench() {
   local out="$1"
   local src="$2"
-  "$CC_BIN" -std=c99 -O2 -Wall -Wextra -Werror -pedantic "$src" -o "$out"
+  local bits="$3"
+  "$CC_BIN" -std=c99 -O2 -Wall -Wextra -Werror -pedantic -DLIMITLESS_LIMB_BITS="$bits" "$src" -o "$out"
 }
 
 median_of_three() {
@@ -30,20 +31,38 @@ print(f"{statistics.median(vals):.3f}")
 PY
 }
 
-compile_bench "$BUILD_DIR/bench_bigint_mul" tests/bench/bench_bigint_mul.c
-compile_bench "$BUILD_DIR/bench_div" tests/bench/bench_div.c
-compile_bench "$BUILD_DIR/bench_parse_format" tests/bench/bench_parse_format.c
-compile_bench "$BUILD_DIR/bench_pow_modexp" tests/bench/bench_pow_modexp.c
+BENCHES=(
+  bench_add
+  bench_bigint_mul
+  bench_copy
+  bench_div
+  bench_gcd
+  bench_parse_format
+  bench_pow_modexp
+  bench_rational
+  bench_small_ops
+)
+# every benchmark is recorded at both limb widths, keyed <name>_limb<bits>
+LIMB_WIDTHS=(32 64)
+
+for bits in "${LIMB_WIDTHS[@]}"; do
+  for bench in "${BENCHES[@]}"; do
+    compile_bench "$BUILD_DIR/${bench}_limb${bits}" "tests/bench/${bench}.c" "$bits"
+  done
+done
 
 current_json="$BUILD_DIR/current.json"
-cat > "$current_json" <<EOF_JSON
 {
-  "bench_bigint_mul": $(median_of_three "$BUILD_DIR/bench_bigint_mul"),
-  "bench_div": $(median_of_three "$BUILD_DIR/bench_div"),
-  "bench_parse_format": $(median_of_three "$BUILD_DIR/bench_parse_format"),
-  "bench_pow_modexp": $(median_of_three "$BUILD_DIR/bench_pow_modexp")
-}
-EOF_JSON
+  echo "{"
+  sep=""
+  for bits in "${LIMB_WIDTHS[@]}"; do
+    for bench in "${BENCHES[@]}"; do
+      printf '%s  "%s_limb%s": %s' "$sep" "$bench" "$bits" "$(median_of_three "$BUILD_DIR/${bench}_limb${bits}")"
+      sep=$',\n'
+    done
+  done
+  printf '\n}\n'
+} > "$current_json"
 
 python3 - "$BASELINE_FILE" "$current_json" <<'PY'
 import json
@@ -35,6 +35,9 @@ SKIP_CPP="${LIMITLESS_SKIP_CPP:-0}"
 case "$MODE" in
   default)
     ;;
+  limb32)
+    DEF_EXTRA+=(-DLIMITLESS_LIMB_BITS=32)
+    ;;
   limb64)
     DEF_EXTRA+=(-DLIMITLESS_LIMB_BITS=64)
     ;;
@@ -17,6 +17,9 @@ $cFlags = @("/nologo", "/W4", "/WX", "/std:c11")
 $cxxFlags = @("/nologo", "/W4", "/WX", "/std:c++14", "/permissive-")
 $defs = @()
 
+if ($Mode -eq "limb32") {
+  $defs += "/DLIMITLESS_LIMB_BITS=32"
+}
 if ($Mode -eq "limb64") {
   $defs += "/DLIMITLESS_LIMB_BITS=64"
 }
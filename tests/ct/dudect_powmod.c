@@ -0,0 +1,181 @@
+/* SPDX-License-Identifier: GPL-3.0-only */
+#define _POSIX_C_SOURCE 199309L
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LIMITLESS_IMPLEMENTATION
+#include "../../limitless.h"
+
+/*
+dudect-style leakage check (Reparaz, Balasch and Verbauwhede, "Dude, is my
+code constant time?", 2017) for limitless_modctx_powmod_ct under a 512-bit
+odd modulus. Each measurement times one call with an exponent drawn at
+random from one of two classes: a fixed exponent with only its top bit set,
+which a sliding-window scan would finish with the fewest multiplies, and a
+fresh random exponent of the same length. Welch's t statistic between the
+two timing distributions is computed over all samples and over samples
+below a few percentile cut-offs, which drop interrupts and other outliers.
+The run fails if any |t| exceeds CT_T_LIMIT.
+
+  dudect_powmod [samples] [ct|vartime]
+
+vartime times limitless_modctx_powmod instead, as a check that the harness
+sees a leak when there is one.
+*/
+
+#define CT_BITS 512
+#define CT_T_LIMIT 10.0
+#define CT_CROPS 4
+
+static const double ct_crop_percentiles[CT_CROPS] = {1.0, 0.9, 0.75, 0.5};
+
+static limitless_u64 rng_state = 0x9e3779b97f4a7c15ULL;
+
+static limitless_u64 rng_next(void) {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 7;
+  rng_state ^= rng_state << 17;
+  return rng_state;
+}
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int cmp_double(const void* a, const void* b) {
+  double x = *(const double*)a;
+  double y = *(const double*)b;
+  return (x > y) - (x < y);
+}
+
+/* a CT_BITS-bit value from hex digits; top forces the top bit on */
+static limitless_status random_value(limitless_ctx* ctx, limitless_number* out, int top_only) {
+  char hex[CT_BITS / 4 + 1];
+  int i;
+  for (i = 0; i < CT_BITS / 4; ++i) hex[i] = top_only ? '0' : "0123456789abcdef"[rng_next() & 15u];
+  hex[0] = top_only ? '8' : "89abcdef"[rng_next() & 7u];
+  hex[CT_BITS / 4] = '\0';
+  return limitless_number_from_cstr(ctx, out, hex, 16);
+}
+
+/* Welch's t for the samples of each class below limit */
+static double welch_t(const double* times, const int* classes, int n, double limit) {
+  double sum[2] = {0.0, 0.0};
+  double sq[2] = {0.0, 0.0};
+  double cnt[2] = {0.0, 0.0};
+  double mean[2];
+  double var[2];
+  int i;
+  int k;
+  for (i = 0; i < n; ++i) {
+    if (times[i] > limit) continue;
+    sum[classes[i]] += times[i];
+    cnt[classes[i]] += 1.0;
+  }
+  if (cnt[0] < 2.0 || cnt[1] < 2.0) return 0.0;
+  for (k = 0; k < 2; ++k) mean[k] = sum[k] / cnt[k];
+  for (i = 0; i < n; ++i) {
+    double d;
+    if (times[i] > limit) continue;
+    d = times[i] - mean[classes[i]];
+    sq[classes[i]] += d * d;
+  }
+  for (k = 0; k < 2; ++k) var[k] = sq[k] / (cnt[k] - 1.0);
+  if (var[0] / cnt[0] + var[1] / cnt[1] <= 0.0) return 0.0;
+  return (mean[0] - mean[1]) / sqrt(var[0] / cnt[0] + var[1] / cnt[1]);
+}
+
+int main(int argc, char** argv) {
+  limitless_ctx ctx;
+  limitless_modctx mc;
+  limitless_number mod;
+  limitless_number base;
+  limitless_number fixed;
+  limitless_number exps[2];
+  limitless_number out;
+  double* times;
+  double* sorted;
+  int* classes;
+  int samples = (argc > 1) ? atoi(argv[1]) : 20000;
+  int vartime = (argc > 2) && strcmp(argv[2], "vartime") == 0;
+  double worst = 0.0;
+  int i;
+  int c;
+
+  if (samples < 100) samples = 100;
+  times = (double*)malloc((size_t)samples * sizeof(double));
+  sorted = (double*)malloc((size_t)samples * sizeof(double));
+  classes = (int*)malloc((size_t)samples * sizeof(int));
+  if (!times || !sorted || !classes) return 1;
+
+  if (limitless_ctx_init_default(&ctx) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &mod) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &base) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &fixed) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &exps[0]) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &exps[1]) != LIMITLESS_OK) return 1;
+  if (limitless_number_init(&ctx, &out) != LIMITLESS_OK) return 1;
+
+  /* 2^512 - 569 is odd; the base is a public random value below it */
+  if (limitless_number_from_u64(&ctx, &mod, 2) != LIMITLESS_OK) return 1;
+  if (limitless_number_pow_u64(&ctx, &mod, &mod, CT_BITS) != LIMITLESS_OK) return 1;
+  if (limitless_number_from_i64(&ctx, &out, -569) != LIMITLESS_OK) return 1;
+  if (limitless_number_add(&ctx, &mod, &mod, &out) != LIMITLESS_OK) return 1;
+  if (limitless_modctx_init(&ctx, &mc, &mod) != LIMITLESS_OK) return 1;
+  if (random_value(&ctx, &base, 0) != LIMITLESS_OK) return 1;
+  if (limitless_number_sub(&ctx, &base, &base, &mod) != LIMITLESS_OK) return 1;
+  if (limitless_number_abs(&ctx, &base, &base) != LIMITLESS_OK) return 1;
+  if (vartime && limitless_modctx_to_residue(&ctx, &mc, &base, &base) != LIMITLESS_OK) return 1;
+  if (random_value(&ctx, &fixed, 1) != LIMITLESS_OK) return 1;
+
+  for (i = 0; i < samples; ++i) {
+    limitless_status st;
+    double t0;
+    double t1;
+    c = (int)(rng_next() & 1u);
+    /* both classes prepare their exponent outside the timed call */
+    if (c == 0) {
+      st = limitless_number_copy(&ctx, &exps[0], &fixed);
+    } else {
+      st = random_value(&ctx, &exps[1], 0);
+    }
+    if (st != LIMITLESS_OK) return 1;
+    t0 = now_ns();
+    if (vartime) {
+      st = limitless_modctx_powmod(&ctx, &mc, &out, &base, &exps[c]);
+    } else {
+      st = limitless_modctx_powmod_ct(&ctx, &mc, &out, &base, &exps[c]);
+    }
+    t1 = now_ns();
+    if (st != LIMITLESS_OK) return 1;
+    times[i] = t1 - t0;
+    classes[i] = c;
+  }
+
+  memcpy(sorted, times, (size_t)samples * sizeof(double));
+  qsort(sorted, (size_t)samples, sizeof(double), cmp_double);
+  for (c = 0; c < CT_CROPS; ++c) {
+    double limit = sorted[(int)((double)(samples - 1) * ct_crop_percentiles[c])];
+    double t = welch_t(times, classes, samples, limit);
+    printf("crop %.2f: t = %.2f\n", ct_crop_percentiles[c], t);
+    if (fabs(t) > worst) worst = fabs(t);
+  }
+  printf("max |t| = %.2f over %d samples (%s)\n", worst, samples, vartime ? "vartime" : "ct");
+
+  limitless_modctx_clear(&ctx, &mc);
+  limitless_number_clear(&ctx, &mod);
+  limitless_number_clear(&ctx, &base);
+  limitless_number_clear(&ctx, &fixed);
+  limitless_number_clear(&ctx, &exps[0]);
+  limitless_number_clear(&ctx, &exps[1]);
+  limitless_number_clear(&ctx, &out);
+  free(times);
+  free(sorted);
+  free(classes);
+  return worst > CT_T_LIMIT ? 2 : 0;
+}
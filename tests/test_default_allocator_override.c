@@ -26,13 +26,29 @@ static void test_default_free(void* p) {
 #define LIMITLESS_DEFAULT_ALLOC(size) test_default_alloc((size_t)(size))
 #define LIMITLESS_DEFAULT_REALLOC(ptr, old_size, new_size) test_default_realloc((ptr), (size_t)(new_size))
 #define LIMITLESS_DEFAULT_FREE(ptr, size) test_default_free((ptr))
+/* also covers the limb-loop memory primitives that replace the compiler builtins */
+#define LIMITLESS_FREESTANDING
+/* and the binary-search bit scans that stand in for clz/ctz builtins */
+#define LIMITLESS_PORTABLE_BITSCAN
 #define LIMITLESS_IMPLEMENTATION
 #include "../limitless.h"
 
 int main(void) {
   limitless_ctx ctx;
   limitless_number n;
+  limitless_number big;
+  limitless_number copy;
+  limitless_number two;
+  limitless_number a;
+  limitless_number b;
+  limitless_number g;
+  limitless_number want;
   char buf[64];
+  char src[64];
+  char out[80];
+  limitless_u64 k;
+  limitless_size off;
+  limitless_size len;
 
   assert(limitless_ctx_init_default(&ctx) == LIMITLESS_OK);
   assert(limitless_number_init(&ctx, &n) == LIMITLESS_OK);
@@ -40,7 +56,66 @@ int main(void) {
   assert(limitless_number_to_str(&ctx, &n, buf, (limitless_size)sizeof(buf), NULL) == LIMITLESS_OK);
   assert(strcmp(buf, "41152263") == 0);
 
+  assert(limitless_number_init(&ctx, &big) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &copy) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(&ctx, &n, -7) == LIMITLESS_OK);
+  assert(limitless_number_pow_u64(&ctx, &big, &n, 4001) == LIMITLESS_OK);
+  assert(limitless_number_copy(&ctx, &copy, &big) == LIMITLESS_OK);
+  assert(limitless_number_cmp(&ctx, &copy, &big, NULL) == 0);
+  assert(limitless_number_neg(&ctx, &copy, &copy) == LIMITLESS_OK);
+  assert(limitless_number_add(&ctx, &copy, &copy, &big) == LIMITLESS_OK);
+  assert(limitless_number_is_zero(&copy));
+
+  /* gcd(3 * 2^k, 9 * 2^(k/2 + 1)) and (3 * 2^k) / 2^k walk every bit position through ctz and clz */
+  assert(limitless_number_init(&ctx, &two) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &b) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &g) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &want) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(&ctx, &two, 2) == LIMITLESS_OK);
+  for (k = 0; k < 200u; ++k) {
+    limitless_u64 j = k / 2u + 1u;
+    /* a = 3 * 2^k, b = 9 * 2^j, want = 3 * 2^min(k, j) */
+    assert(limitless_number_pow_u64(&ctx, &big, &two, k) == LIMITLESS_OK);
+    assert(limitless_number_from_i64(&ctx, &n, 3) == LIMITLESS_OK);
+    assert(limitless_number_mul(&ctx, &a, &big, &n) == LIMITLESS_OK);
+    assert(limitless_number_div(&ctx, &copy, &a, &big) == LIMITLESS_OK);
+    assert(limitless_number_cmp(&ctx, &copy, &n, NULL) == 0);
+    assert(limitless_number_pow_u64(&ctx, &want, &two, (k < j) ? k : j) == LIMITLESS_OK);
+    assert(limitless_number_mul(&ctx, &want, &want, &n) == LIMITLESS_OK);
+    assert(limitless_number_pow_u64(&ctx, &big, &two, j) == LIMITLESS_OK);
+    assert(limitless_number_from_i64(&ctx, &n, 9) == LIMITLESS_OK);
+    assert(limitless_number_mul(&ctx, &b, &big, &n) == LIMITLESS_OK);
+    assert(limitless_number_gcd(&ctx, &g, &a, &b) == LIMITLESS_OK);
+    assert(limitless_number_cmp(&ctx, &g, &want, NULL) == 0);
+  }
+
+  /* -77..7/100..0 into every byte offset walks the head, word and tail copies and the misaligned byte path */
+  for (len = 1; len < 30u; ++len) {
+    limitless_size i;
+    src[0] = '-';
+    for (i = 0; i < len; ++i) src[1 + i] = '7';
+    src[1 + len] = '/';
+    src[2 + len] = '1';
+    for (i = 0; i < len; ++i) src[3 + len + i] = '0';
+    src[3 + 2 * len] = '\0';
+    assert(limitless_number_from_str(&ctx, &n, src) == LIMITLESS_OK);
+    for (off = 0; off < 9u; ++off) {
+      limitless_size w = 0;
+      assert(limitless_number_to_str(&ctx, &n, out + off, (limitless_size)sizeof(out) - off, &w) == LIMITLESS_OK);
+      assert(w == 3 + 2 * len);
+      assert(strcmp(out + off, src) == 0);
+    }
+  }
+
   limitless_number_clear(&ctx, &n);
+  limitless_number_clear(&ctx, &big);
+  limitless_number_clear(&ctx, &copy);
+  limitless_number_clear(&ctx, &two);
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &g);
+  limitless_number_clear(&ctx, &want);
 
   assert(g_alloc_calls > 0 || g_realloc_calls > 0);
   assert(g_free_calls >= 0);
@@ -70,6 +70,47 @@ static void test_basic_arithmetic(void) {
   limitless_number_clear(&ctx, &c);
 }
 
+static void test_word_fast_path(void) {
+  limitless_ctx ctx = make_ctx();
+  limitless_number a, b, c;
+  assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &b) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &c) == LIMITLESS_OK);
+
+  /* overflow at the i64 boundary promotes to limb arithmetic */
+  assert(limitless_number_from_i64(&ctx, &a, 9223372036854775807LL) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(&ctx, &b, 1) == LIMITLESS_OK);
+  assert(limitless_number_add(&ctx, &c, &a, &b) == LIMITLESS_OK);
+  check_str(&ctx, &c, 10, "9223372036854775808");
+  assert(limitless_number_neg(&ctx, &a, &a) == LIMITLESS_OK);
+  assert(limitless_number_sub(&ctx, &c, &a, &b) == LIMITLESS_OK);
+  check_str(&ctx, &c, 10, "-9223372036854775808");
+  assert(limitless_number_sub(&ctx, &c, &c, &b) == LIMITLESS_OK);
+  check_str(&ctx, &c, 10, "-9223372036854775809");
+  assert(limitless_number_mul(&ctx, &c, &a, &a) == LIMITLESS_OK);
+  check_str(&ctx, &c, 10, "85070591730234615847396907784232501249");
+  assert(limitless_number_from_i64(&ctx, &a, -3037000500LL) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &c, &a, &a) == LIMITLESS_OK);
+  check_str(&ctx, &c, 10, "9223372037000250000");
+  assert(limitless_number_from_i64(&ctx, &b, 3037000499LL) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &c, &a, &b) == LIMITLESS_OK);
+  check_str(&ctx, &c, 10, "-9223372033963249500");
+
+  /* word results replace a rational output and honour aliasing */
+  assert(limitless_number_from_cstr(&ctx, &c, "5/7", 10) == LIMITLESS_OK);
+  assert(limitless_number_add(&ctx, &c, &b, &a) == LIMITLESS_OK);
+  assert(limitless_number_is_integer(&c));
+  check_str(&ctx, &c, 10, "-1");
+  assert(limitless_number_mul(&ctx, &b, &b, &b) == LIMITLESS_OK);
+  check_str(&ctx, &b, 10, "9223372030926249001");
+  assert(limitless_number_sub(&ctx, &a, &a, &a) == LIMITLESS_OK);
+  assert(limitless_number_is_zero(&a));
+
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &c);
+}
+
 static void test_rational_normalization(void) {
   limitless_ctx ctx = make_ctx();
   limitless_number n;
@@ -82,15 +123,92 @@ static void test_rational_normalization(void) {
   limitless_number_clear(&ctx, &n);
 }
 
+static void test_rational_arithmetic(void) {
+  limitless_ctx ctx = make_ctx();
+  limitless_number a, b, c, k;
+  int i;
+  assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &b) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &c) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &k) == LIMITLESS_OK);
+
+  /* shared denominator factor that cancels again from the numerator */
+  assert(limitless_number_from_cstr(&ctx, &a, "5/6", 10) == LIMITLESS_OK);
+  assert(limitless_number_from_cstr(&ctx, &b, "1/10", 10) == LIMITLESS_OK);
+  assert(limitless_number_add(&ctx, &c, &a, &b) == LIMITLESS_OK);
+  check_str(&ctx, &c, 10, "14/15");
+  assert(limitless_number_from_cstr(&ctx, &a, "3/4", 10) == LIMITLESS_OK);
+  assert(limitless_number_from_cstr(&ctx, &b, "1/4", 10) == LIMITLESS_OK);
+  assert(limitless_number_sub(&ctx, &c, &a, &b) == LIMITLESS_OK);
+  check_str(&ctx, &c, 10, "1/2");
+  assert(limitless_number_add(&ctx, &c, &a, &b) == LIMITLESS_OK);
+  assert(limitless_number_is_integer(&c));
+  check_str(&ctx, &c, 10, "1");
+  assert(limitless_number_sub(&ctx, &c, &a, &a) == LIMITLESS_OK);
+  check_str(&ctx, &c, 10, "0");
+  assert(limitless_number_from_cstr(&ctx, &a, "-1/6", 10) == LIMITLESS_OK);
+  assert(limitless_number_from_cstr(&ctx, &b, "-5/6", 10) == LIMITLESS_OK);
+  assert(limitless_number_sub(&ctx, &c, &a, &b) == LIMITLESS_OK);
+  check_str(&ctx, &c, 10, "2/3");
+
+  /* cross cancellation in products and quotients */
+  assert(limitless_number_from_cstr(&ctx, &a, "7/15", 10) == LIMITLESS_OK);
+  assert(limitless_number_from_cstr(&ctx, &b, "10/21", 10) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &c, &a, &b) == LIMITLESS_OK);
+  check_str(&ctx, &c, 10, "2/9");
+  assert(limitless_number_from_cstr(&ctx, &a, "2/3", 10) == LIMITLESS_OK);
+  assert(limitless_number_from_cstr(&ctx, &b, "-4/9", 10) == LIMITLESS_OK);
+  assert(limitless_number_div(&ctx, &c, &a, &b) == LIMITLESS_OK);
+  check_str(&ctx, &c, 10, "-3/2");
+  assert(limitless_number_from_cstr(&ctx, &a, "-3/4", 10) == LIMITLESS_OK);
+  assert(limitless_number_from_cstr(&ctx, &b, "4/3", 10) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &c, &a, &b) == LIMITLESS_OK);
+  assert(limitless_number_is_integer(&c));
+  check_str(&ctx, &c, 10, "-1");
+  assert(limitless_number_from_i64(&ctx, &a, 5) == LIMITLESS_OK);
+  assert(limitless_number_from_cstr(&ctx, &b, "10/3", 10) == LIMITLESS_OK);
+  assert(limitless_number_div(&ctx, &c, &a, &b) == LIMITLESS_OK);
+  check_str(&ctx, &c, 10, "3/2");
+  assert(limitless_number_from_i64(&ctx, &a, 0) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &c, &b, &a) == LIMITLESS_OK);
+  check_str(&ctx, &c, 10, "0");
+
+  /* chained accumulation: harmonic number H(30) */
+  assert(limitless_number_from_i64(&ctx, &a, 0) == LIMITLESS_OK);
+  for (i = 1; i <= 30; ++i) {
+    assert(limitless_number_from_i64(&ctx, &k, i) == LIMITLESS_OK);
+    assert(limitless_number_from_i64(&ctx, &b, 1) == LIMITLESS_OK);
+    assert(limitless_number_div(&ctx, &b, &b, &k) == LIMITLESS_OK);
+    assert(limitless_number_add(&ctx, &a, &a, &b) == LIMITLESS_OK);
+  }
+  check_str(&ctx, &a, 10, "9304682830147/2329089562800");
+
+  /* telescoping product (1/2)(2/3)...(200/201) */
+  assert(limitless_number_from_i64(&ctx, &a, 1) == LIMITLESS_OK);
+  for (i = 1; i <= 200; ++i) {
+    assert(limitless_number_from_i64(&ctx, &b, i) == LIMITLESS_OK);
+    assert(limitless_number_from_i64(&ctx, &k, i + 1) == LIMITLESS_OK);
+    assert(limitless_number_div(&ctx, &b, &b, &k) == LIMITLESS_OK);
+    assert(limitless_number_mul(&ctx, &a, &a, &b) == LIMITLESS_OK);
+  }
+  check_str(&ctx, &a, 10, "1/201");
+
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &c);
+  limitless_number_clear(&ctx, &k);
+}
+
 static void test_large_and_karatsuba_path(void) {
   limitless_ctx ctx = make_ctx();
-  limitless_number a, b, c;
+  limitless_number a, b, c, ref;
   char big1[2200];
   char big2[2200];
   int i;
   assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
   assert(limitless_number_init(&ctx, &b) == LIMITLESS_OK);
   assert(limitless_number_init(&ctx, &c) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &ref) == LIMITLESS_OK);
 
   for (i = 0; i < 2000; ++i) {
     big1[i] = (char)('1' + (i % 9));
@@ -101,13 +219,375 @@ static void test_large_and_karatsuba_path(void) {
 
   assert(limitless_number_from_cstr(&ctx, &a, big1, 10) == LIMITLESS_OK);
   assert(limitless_number_from_cstr(&ctx, &b, big2, 10) == LIMITLESS_OK);
+  limitless_ctx_set_karatsuba_threshold(&ctx, (limitless_size)-1);
+  limitless_ctx_set_toom3_threshold(&ctx, (limitless_size)-1);
+  assert(limitless_number_mul(&ctx, &ref, &a, &b) == LIMITLESS_OK);
   limitless_ctx_set_karatsuba_threshold(&ctx, 8);
   assert(limitless_number_mul(&ctx, &c, &a, &b) == LIMITLESS_OK);
   assert(!limitless_number_is_zero(&c));
+  assert(limitless_number_cmp(&ctx, &c, &ref, NULL) == 0);
+
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &c);
+  limitless_number_clear(&ctx, &ref);
+}
+
+static void test_toom3_path(void) {
+  limitless_ctx ctx = make_ctx();
+  limitless_number a, b, c, ref;
+  char big1[1300];
+  char big2[1300];
+  int i;
+  int len;
+  assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &b) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &c) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &ref) == LIMITLESS_OK);
+
+  for (len = 250; len <= 1250; len += 333) {
+    for (i = 0; i < len; ++i) {
+      big1[i] = (char)('0' + ((i * 7 + 3) % 10));
+      big2[i] = (char)('9' - ((i * 3 + len) % 10));
+    }
+    big1[0] = '-';
+    big2[0] = '8';
+    big1[len] = '\0';
+    big2[len - len / 5] = '\0';
+
+    assert(limitless_number_from_cstr(&ctx, &a, big1, 10) == LIMITLESS_OK);
+    assert(limitless_number_from_cstr(&ctx, &b, big2, 10) == LIMITLESS_OK);
+
+    limitless_ctx_set_karatsuba_threshold(&ctx, (limitless_size)-1);
+    limitless_ctx_set_toom3_threshold(&ctx, (limitless_size)-1);
+    assert(limitless_number_mul(&ctx, &ref, &a, &b) == LIMITLESS_OK);
+
+    /* force toom-3 all the way down to tiny pieces */
+    limitless_ctx_set_karatsuba_threshold(&ctx, 2);
+    limitless_ctx_set_toom3_threshold(&ctx, 3);
+    assert(limitless_number_mul(&ctx, &c, &a, &b) == LIMITLESS_OK);
+    assert(limitless_number_cmp(&ctx, &c, &ref, NULL) == 0);
+    assert(limitless_number_mul(&ctx, &c, &a, &a) == LIMITLESS_OK);
+    assert(limitless_number_sign(&c) == 1);
+
+    limitless_ctx_set_toom3_threshold(&ctx, 24);
+    assert(limitless_number_mul(&ctx, &c, &b, &a) == LIMITLESS_OK);
+    assert(limitless_number_cmp(&ctx, &c, &ref, NULL) == 0);
+  }
 
   limitless_number_clear(&ctx, &a);
   limitless_number_clear(&ctx, &b);
   limitless_number_clear(&ctx, &c);
+  limitless_number_clear(&ctx, &ref);
+}
+
+static void test_ntt_path(void) {
+  limitless_ctx ctx = make_ctx();
+  limitless_number a, b, c, ref;
+  char big1[2100];
+  char big2[2100];
+  int i;
+  int len;
+  assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &b) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &c) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &ref) == LIMITLESS_OK);
+
+  for (len = 30; len <= 2030; len += 400) {
+    for (i = 0; i < len; ++i) {
+      big1[i] = 'f';
+      big2[i] = "0123456789abcdef"[(i * 11 + len) % 16];
+    }
+    big1[0] = '-';
+    big2[0] = '1';
+    big1[len] = '\0';
+    big2[len - len / 3] = '\0';
+
+    assert(limitless_number_from_cstr(&ctx, &a, big1, 16) == LIMITLESS_OK);
+    assert(limitless_number_from_cstr(&ctx, &b, big2, 16) == LIMITLESS_OK);
+
+    limitless_ctx_set_karatsuba_threshold(&ctx, (limitless_size)-1);
+    limitless_ctx_set_toom3_threshold(&ctx, (limitless_size)-1);
+    limitless_ctx_set_ntt_threshold(&ctx, (limitless_size)-1);
+    assert(limitless_number_mul(&ctx, &ref, &a, &b) == LIMITLESS_OK);
+
+    /* all-ones limbs drive every convolution coefficient to its maximum */
+    limitless_ctx_set_karatsuba_threshold(&ctx, 2);
+    limitless_ctx_set_ntt_threshold(&ctx, 2);
+    assert(limitless_number_mul(&ctx, &c, &a, &b) == LIMITLESS_OK);
+    assert(limitless_number_cmp(&ctx, &c, &ref, NULL) == 0);
+    assert(limitless_number_mul(&ctx, &ref, &a, &a) == LIMITLESS_OK);
+    limitless_ctx_set_karatsuba_threshold(&ctx, (limitless_size)-1);
+    assert(limitless_number_mul(&ctx, &c, &a, &a) == LIMITLESS_OK);
+    assert(limitless_number_cmp(&ctx, &c, &ref, NULL) == 0);
+    assert(limitless_number_sign(&c) == 1);
+  }
+
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &c);
+  limitless_number_clear(&ctx, &ref);
+}
+
+static void test_square_paths(void) {
+  limitless_ctx ctx = make_ctx();
+  limitless_number a, b, c, ref;
+  char hex[1100];
+  int i;
+  int len;
+  int tier;
+  assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &b) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &c) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &ref) == LIMITLESS_OK);
+
+  for (len = 1; len <= 1000; len += 111) {
+    for (i = 0; i < len; ++i) hex[i] = "0123456789abcdef"[(i * 5 + len) % 16];
+    hex[0] = 'f';
+    hex[len] = '\0';
+    assert(limitless_number_from_cstr(&ctx, &a, hex, 16) == LIMITLESS_OK);
+    assert(limitless_number_neg(&ctx, &a, &a) == LIMITLESS_OK);
+    /* a distinct copy keeps the reference on the general multiply path */
+    assert(limitless_number_copy(&ctx, &b, &a) == LIMITLESS_OK);
+    limitless_ctx_set_karatsuba_threshold(&ctx, (limitless_size)-1);
+    assert(limitless_number_mul(&ctx, &ref, &a, &b) == LIMITLESS_OK);
+
+    for (tier = 0; tier < 4; ++tier) {
+      limitless_ctx_set_karatsuba_threshold(&ctx, (tier == 0) ? (limitless_size)-1 : 2);
+      limitless_ctx_set_toom3_threshold(&ctx, (tier == 2) ? 3 : (limitless_size)-1);
+      limitless_ctx_set_ntt_threshold(&ctx, (tier == 3) ? 2 : (limitless_size)-1);
+      assert(limitless_number_mul(&ctx, &c, &a, &a) == LIMITLESS_OK);
+      assert(limitless_number_cmp(&ctx, &c, &ref, NULL) == 0);
+    }
+    limitless_ctx_set_toom3_threshold(&ctx, (limitless_size)-1);
+    limitless_ctx_set_ntt_threshold(&ctx, (limitless_size)-1);
+  }
+
+  assert(limitless_number_pow_u64(&ctx, &c, &a, 5) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &ref, &a, &b) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &ref, &ref, &b) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &ref, &ref, &b) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &ref, &ref, &b) == LIMITLESS_OK);
+  assert(limitless_number_cmp(&ctx, &c, &ref, NULL) == 0);
+
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &c);
+  limitless_number_clear(&ctx, &ref);
+}
+
+static void test_unbalanced_mul(void) {
+  limitless_ctx ctx = make_ctx();
+  limitless_number a, b, c, ref;
+  char big1[3001];
+  char big2[400];
+  int i;
+  int len;
+  assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &b) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &c) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &ref) == LIMITLESS_OK);
+
+  for (i = 0; i < 3000; ++i) big1[i] = "0123456789abcdef"[(i * 7 + 1) % 16];
+  big1[0] = 'f';
+  big1[3000] = '\0';
+  assert(limitless_number_from_cstr(&ctx, &a, big1, 16) == LIMITLESS_OK);
+
+  for (len = 9; len < 400; len += 65) {
+    for (i = 0; i < len; ++i) big2[i] = "0123456789abcdef"[(i * 3 + len) % 16];
+    big2[0] = '-';
+    big2[1] = 'e';
+    big2[len] = '\0';
+    assert(limitless_number_from_cstr(&ctx, &b, big2, 16) == LIMITLESS_OK);
+
+    limitless_ctx_set_karatsuba_threshold(&ctx, (limitless_size)-1);
+    limitless_ctx_set_toom3_threshold(&ctx, (limitless_size)-1);
+    limitless_ctx_set_ntt_threshold(&ctx, (limitless_size)-1);
+    assert(limitless_number_mul(&ctx, &ref, &a, &b) == LIMITLESS_OK);
+
+    /* short side cut into karatsuba blocks, then into toom-3 sized blocks */
+    limitless_ctx_set_karatsuba_threshold(&ctx, 4);
+    assert(limitless_number_mul(&ctx, &c, &a, &b) == LIMITLESS_OK);
+    assert(limitless_number_cmp(&ctx, &c, &ref, NULL) == 0);
+    limitless_ctx_set_toom3_threshold(&ctx, 6);
+    assert(limitless_number_mul(&ctx, &c, &b, &a) == LIMITLESS_OK);
+    assert(limitless_number_cmp(&ctx, &c, &ref, NULL) == 0);
+  }
+
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &c);
+  limitless_number_clear(&ctx, &ref);
+}
+
+static void test_division_paths(void) {
+  limitless_ctx ctx = make_ctx();
+  limitless_number a, b, n, q, back;
+  char big1[1300];
+  char big2[700];
+  int i;
+  int tier;
+  assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &b) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &n) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &q) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &back) == LIMITLESS_OK);
+
+  for (i = 0; i < 1299; ++i) big1[i] = "0123456789abcdef"[(i * 11 + 7) % 16];
+  big1[0] = 'f';
+  big1[1299] = '\0';
+  /* a divisor just above a power of two stresses the quotient estimate corrections */
+  for (i = 0; i < 699; ++i) big2[i] = (i > 680) ? "0123456789abcdef"[i % 16] : '0';
+  big2[0] = '8';
+  big2[699] = '\0';
+  assert(limitless_number_from_cstr(&ctx, &a, big1, 16) == LIMITLESS_OK);
+  assert(limitless_number_from_cstr(&ctx, &b, big2, 16) == LIMITLESS_OK);
+  assert(limitless_number_neg(&ctx, &b, &b) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &n, &a, &b) == LIMITLESS_OK);
+
+  for (tier = 0; tier < 3; ++tier) {
+    /* algorithm D only, burnikel-ziegler down to two limbs, and the default split */
+    if (tier == 0) limitless_ctx_set_bz_threshold(&ctx, (limitless_size)-1);
+    if (tier == 1) limitless_ctx_set_bz_threshold(&ctx, 2);
+    if (tier == 2) limitless_ctx_set_bz_threshold(&ctx, 16);
+    assert(limitless_number_div(&ctx, &q, &n, &b) == LIMITLESS_OK);
+    assert(limitless_number_cmp(&ctx, &q, &a, NULL) == 0);
+    assert(limitless_number_add(&ctx, &back, &n, &a) == LIMITLESS_OK);
+    assert(limitless_number_div(&ctx, &q, &back, &b) == LIMITLESS_OK);
+    assert(limitless_number_mul(&ctx, &q, &q, &b) == LIMITLESS_OK);
+    assert(limitless_number_cmp(&ctx, &q, &back, NULL) == 0);
+    assert(limitless_number_modexp_u64(&ctx, &q, &a, 3, &b) == LIMITLESS_EDIVZERO);
+    assert(limitless_number_neg(&ctx, &back, &b) == LIMITLESS_OK);
+    assert(limitless_number_modexp_u64(&ctx, &q, &n, 1, &back) == LIMITLESS_OK);
+    assert(limitless_number_sign(&q) == 0);
+  }
+
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &n);
+  limitless_number_clear(&ctx, &q);
+  limitless_number_clear(&ctx, &back);
+}
+
+static void test_divmod_u64(void) {
+  limitless_ctx ctx = make_ctx();
+  limitless_number a, q, back;
+  limitless_u64 rem = 0;
+  char buf[256];
+  assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &q) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &back) == LIMITLESS_OK);
+
+  assert(limitless_number_from_str(&ctx, &a, "123456789012345678901234567890123456789") == LIMITLESS_OK);
+  assert(limitless_number_divmod_u64(&ctx, &q, &a, 10000000000ULL, &rem) == LIMITLESS_OK);
+  assert(rem == 123456789ULL);
+  assert(limitless_number_to_str(&ctx, &q, buf, (limitless_size)sizeof(buf), NULL) == LIMITLESS_OK);
+  assert(strcmp(buf, "12345678901234567890123456789") == 0);
+
+  /* floor semantics: the remainder stays in [0, d) for negative dividends */
+  assert(limitless_number_from_i64(&ctx, &a, -7) == LIMITLESS_OK);
+  assert(limitless_number_divmod_u64(&ctx, &q, &a, 2, &rem) == LIMITLESS_OK);
+  assert(rem == 1ULL);
+  assert(limitless_number_to_str(&ctx, &q, buf, (limitless_size)sizeof(buf), NULL) == LIMITLESS_OK);
+  assert(strcmp(buf, "-4") == 0);
+  assert(limitless_number_from_i64(&ctx, &a, -8) == LIMITLESS_OK);
+  assert(limitless_number_divmod_u64(&ctx, &a, &a, 2, &rem) == LIMITLESS_OK);
+  assert(rem == 0ULL);
+  assert(limitless_number_to_str(&ctx, &a, buf, (limitless_size)sizeof(buf), NULL) == LIMITLESS_OK);
+  assert(strcmp(buf, "-4") == 0);
+
+  /* full-width divisors, remainder only, and q * d + r round trips */
+  assert(limitless_number_from_str(&ctx, &a, "-340282366920938463463374607431768211457") == LIMITLESS_OK);
+  assert(limitless_number_divmod_u64(&ctx, NULL, &a, 18446744073709551615ULL, &rem) == LIMITLESS_OK);
+  assert(rem == 18446744073709551613ULL);
+  assert(limitless_number_divmod_u64(&ctx, &q, &a, 18446744073709551615ULL, &rem) == LIMITLESS_OK);
+  assert(limitless_number_from_u64(&ctx, &back, 18446744073709551615ULL) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &back, &back, &q) == LIMITLESS_OK);
+  assert(limitless_number_from_u64(&ctx, &q, rem) == LIMITLESS_OK);
+  assert(limitless_number_add(&ctx, &back, &back, &q) == LIMITLESS_OK);
+  assert(limitless_number_cmp(&ctx, &back, &a, NULL) == 0);
+  assert(limitless_number_from_u64(&ctx, &a, 0) == LIMITLESS_OK);
+  assert(limitless_number_divmod_u64(&ctx, &q, &a, 3, &rem) == LIMITLESS_OK);
+  assert(rem == 0ULL && limitless_number_is_zero(&q));
+
+  assert(limitless_number_divmod_u64(&ctx, &q, &a, 0, &rem) == LIMITLESS_EDIVZERO);
+  assert(limitless_number_from_str(&ctx, &a, "1/3") == LIMITLESS_OK);
+  assert(limitless_number_divmod_u64(&ctx, &q, &a, 3, &rem) == LIMITLESS_ETYPE);
+
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &q);
+  limitless_number_clear(&ctx, &back);
+}
+
+static void test_gcd_paths(void) {
+  limitless_ctx ctx = make_ctx();
+  limitless_number f0, f1, t, f1000, f2000, f2999, f3000, g, s, c;
+  int i;
+  int tier;
+  assert(limitless_number_init(&ctx, &f0) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &f1) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &t) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &f1000) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &f2000) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &f2999) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &f3000) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &g) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &s) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &c) == LIMITLESS_OK);
+
+  /* fibonacci pairs have all-ones quotients, the slowest case for euclid-style reduction */
+  assert(limitless_number_from_u64(&ctx, &f0, 0) == LIMITLESS_OK);
+  assert(limitless_number_from_u64(&ctx, &f1, 1) == LIMITLESS_OK);
+  for (i = 1; i <= 3000; ++i) {
+    assert(limitless_number_add(&ctx, &t, &f0, &f1) == LIMITLESS_OK);
+    assert(limitless_number_copy(&ctx, &f0, &f1) == LIMITLESS_OK);
+    assert(limitless_number_copy(&ctx, &f1, &t) == LIMITLESS_OK);
+    if (i == 1000) assert(limitless_number_copy(&ctx, &f1000, &f0) == LIMITLESS_OK);
+    if (i == 2000) assert(limitless_number_copy(&ctx, &f2000, &f0) == LIMITLESS_OK);
+    if (i == 2999) assert(limitless_number_copy(&ctx, &f2999, &f0) == LIMITLESS_OK);
+  }
+  assert(limitless_number_copy(&ctx, &f3000, &f0) == LIMITLESS_OK);
+
+  for (tier = 0; tier < 3; ++tier) {
+    /* lehmer only, half-gcd recursing down to four limbs, and the default split */
+    if (tier == 0) limitless_ctx_set_hgcd_threshold(&ctx, (limitless_size)-1);
+    if (tier == 1) limitless_ctx_set_hgcd_threshold(&ctx, 4);
+    if (tier == 2) limitless_ctx_set_hgcd_threshold(&ctx, 32);
+    /* gcd(F(m), F(n)) = F(gcd(m, n)) */
+    assert(limitless_number_gcd(&ctx, &g, &f3000, &f2000) == LIMITLESS_OK);
+    assert(limitless_number_cmp(&ctx, &g, &f1000, NULL) == 0);
+    /* consecutive fibonacci numbers are coprime, so the common factor comes back exactly */
+    assert(limitless_number_mul(&ctx, &f0, &f3000, &f1000) == LIMITLESS_OK);
+    assert(limitless_number_mul(&ctx, &f1, &f2999, &f1000) == LIMITLESS_OK);
+    assert(limitless_number_neg(&ctx, &f1, &f1) == LIMITLESS_OK);
+    assert(limitless_number_gcd(&ctx, &g, &f0, &f1) == LIMITLESS_OK);
+    assert(limitless_number_cmp(&ctx, &g, &f1000, NULL) == 0);
+    assert(limitless_number_gcd(&ctx, &g, &f1, &f3000) == LIMITLESS_OK);
+    assert(limitless_number_cmp(&ctx, &g, &f1000, NULL) == 0);
+    /* the cofactors come through every tier's matrices: s f0 + c f1 == F(1000) */
+    assert(limitless_number_gcdext(&ctx, &g, &s, &c, &f0, &f1) == LIMITLESS_OK);
+    assert(limitless_number_cmp(&ctx, &g, &f1000, NULL) == 0);
+    assert(limitless_number_mul(&ctx, &s, &s, &f0) == LIMITLESS_OK);
+    assert(limitless_number_mul(&ctx, &c, &c, &f1) == LIMITLESS_OK);
+    assert(limitless_number_add(&ctx, &s, &s, &c) == LIMITLESS_OK);
+    assert(limitless_number_cmp(&ctx, &s, &f1000, NULL) == 0);
+    assert(limitless_number_invmod(&ctx, &s, &f0, &f1) == LIMITLESS_EDIVZERO);
+    assert(limitless_number_invmod(&ctx, &s, &f2999, &f3000) == LIMITLESS_OK);
+    assert(limitless_number_mul(&ctx, &s, &s, &f2999) == LIMITLESS_OK);
+    assert(limitless_number_modexp_u64(&ctx, &s, &s, 1, &f3000) == LIMITLESS_OK);
+    check_str(&ctx, &s, 10, "1");
+  }
+
+  limitless_number_clear(&ctx, &f0);
+  limitless_number_clear(&ctx, &f1);
+  limitless_number_clear(&ctx, &t);
+  limitless_number_clear(&ctx, &f1000);
+  limitless_number_clear(&ctx, &f2000);
+  limitless_number_clear(&ctx, &f2999);
+  limitless_number_clear(&ctx, &f3000);
+  limitless_number_clear(&ctx, &g);
+  limitless_number_clear(&ctx, &s);
+  limitless_number_clear(&ctx, &c);
 }
 
 static void test_gcd_pow_modexp(void) {
@@ -123,6 +603,49 @@ static void test_gcd_pow_modexp(void) {
   assert(limitless_number_gcd(&ctx, &out, &a, &b) == LIMITLESS_OK);
   check_str(&ctx, &out, 10, "6");
 
+  /* cofactors land in the operands' own storage; s is the one nearest zero */
+  assert(limitless_number_gcdext(&ctx, &out, &a, &b, &a, &b) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, "6");
+  check_str(&ctx, &a, 10, "1");
+  check_str(&ctx, &b, 10, "3");
+  assert(limitless_number_from_i64(&ctx, &a, 240) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(&ctx, &b, 46) == LIMITLESS_OK);
+  assert(limitless_number_gcdext(&ctx, &out, &a, &b, &a, &b) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, "2");
+  check_str(&ctx, &a, 10, "-9");
+  check_str(&ctx, &b, 10, "47");
+  assert(limitless_number_from_i64(&ctx, &a, -5) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(&ctx, &b, 0) == LIMITLESS_OK);
+  assert(limitless_number_gcdext(&ctx, &out, &a, &b, &a, &b) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, "5");
+  check_str(&ctx, &a, 10, "-1");
+  check_str(&ctx, &b, 10, "0");
+  assert(limitless_number_from_i64(&ctx, &b, -7) == LIMITLESS_OK);
+  assert(limitless_number_gcdext(&ctx, &out, &a, NULL, &b, &b) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, "7");
+  check_str(&ctx, &a, 10, "0");
+  assert(limitless_number_gcdext(&ctx, &out, &out, NULL, &a, &b) == LIMITLESS_EINVAL);
+
+  assert(limitless_number_from_i64(&ctx, &a, 3) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(&ctx, &mod, 7) == LIMITLESS_OK);
+  assert(limitless_number_invmod(&ctx, &out, &a, &mod) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, "5");
+  assert(limitless_number_neg(&ctx, &a, &a) == LIMITLESS_OK);
+  assert(limitless_number_invmod(&ctx, &out, &a, &mod) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, "2");
+  assert(limitless_number_neg(&ctx, &mod, &mod) == LIMITLESS_OK);
+  assert(limitless_number_invmod(&ctx, &out, &a, &mod) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, "2");
+  assert(limitless_number_from_i64(&ctx, &a, 4) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(&ctx, &mod, 8) == LIMITLESS_OK);
+  assert(limitless_number_invmod(&ctx, &out, &a, &mod) == LIMITLESS_EDIVZERO);
+  check_str(&ctx, &out, 10, "2");
+  assert(limitless_number_from_i64(&ctx, &mod, 0) == LIMITLESS_OK);
+  assert(limitless_number_invmod(&ctx, &out, &a, &mod) == LIMITLESS_EDIVZERO);
+  assert(limitless_number_from_str(&ctx, &mod, "1/2") == LIMITLESS_OK);
+  assert(limitless_number_invmod(&ctx, &out, &a, &mod) == LIMITLESS_ETYPE);
+  assert(limitless_number_gcdext(&ctx, &out, NULL, NULL, &mod, &a) == LIMITLESS_ETYPE);
+
   assert(limitless_number_from_i64(&ctx, &a, -2) == LIMITLESS_OK);
   assert(limitless_number_pow_u64(&ctx, &out, &a, 5) == LIMITLESS_OK);
   check_str(&ctx, &out, 10, "-32");
@@ -132,8 +655,176 @@ static void test_gcd_pow_modexp(void) {
   assert(limitless_number_modexp_u64(&ctx, &out, &a, 13, &mod) == LIMITLESS_OK);
   check_str(&ctx, &out, 10, "445");
 
+  /* multi-limb moduli: odd ones reduce by Montgomery, even ones by Barrett */
+  assert(limitless_number_from_i64(&ctx, &b, 3) == LIMITLESS_OK);
+  assert(limitless_number_pow_u64(&ctx, &a, &b, 100) == LIMITLESS_OK);
+  assert(limitless_number_from_str(&ctx, &mod, "115792089237316195423570985008687907853269984665640564039457584007913129639747") == LIMITLESS_OK);
+  assert(limitless_number_modexp_u64(&ctx, &out, &a, 0xfedcba9876543211ULL, &mod) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, "91823275308537721492371257206808554373724927657892849721003000631590925314621");
+  assert(limitless_number_neg(&ctx, &b, &a) == LIMITLESS_OK);
+  assert(limitless_number_modexp_u64(&ctx, &out, &b, 0xfedcba9876543211ULL, &mod) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, "23968813928778473931199727801879353479545057007747714318454583376322204325126");
+  assert(limitless_number_from_str(&ctx, &mod, "115792089237316195423570985008687907853269984665640564039457584007913129639748") == LIMITLESS_OK);
+  assert(limitless_number_modexp_u64(&ctx, &out, &a, 0xfedcba9876543211ULL, &mod) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, "14540881203560634071400241970867559557311766345462159306390900557048140247541");
+  assert(limitless_number_modexp_u64(&ctx, &out, &a, 0, &mod) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, "1");
+  assert(limitless_number_from_i64(&ctx, &mod, 1) == LIMITLESS_OK);
+  assert(limitless_number_modexp_u64(&ctx, &out, &a, 0, &mod) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, "0");
+
+  /* exponents past 64 bits; the result may land in the exponent's own storage */
+  assert(limitless_number_from_str(&ctx, &mod, "115792089237316195423570985008687907853269984665640564039457584007913129639747") == LIMITLESS_OK);
+  assert(limitless_number_from_str(&ctx, &b, "2037035976334486086268445688409378161051468393665936250636140449354381299763336706183409721") == LIMITLESS_OK);
+  assert(limitless_number_modexp(&ctx, &b, &a, &b, &mod) == LIMITLESS_OK);
+  check_str(&ctx, &b, 10, "54014321520201821040792189169670609540305465499975355671400441805238431348775");
+  assert(limitless_number_from_str(&ctx, &b, "2037035976334486086268445688409378161051468393665936250636140449354381299763336706183409721") == LIMITLESS_OK);
+  assert(limitless_number_from_str(&ctx, &mod, "115792089237316195423570985008687907853269984665640564039457584007913129639748") == LIMITLESS_OK);
+  assert(limitless_number_modexp(&ctx, &out, &a, &b, &mod) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, "105438125713271887977995124238376840158074034425019113241901047445071431404589");
+  assert(limitless_number_neg(&ctx, &b, &b) == LIMITLESS_OK);
+  assert(limitless_number_modexp(&ctx, &out, &a, &b, &mod) == LIMITLESS_ERANGE);
+  check_str(&ctx, &out, 10, "105438125713271887977995124238376840158074034425019113241901047445071431404589");
+  assert(limitless_number_from_str(&ctx, &b, "1/2") == LIMITLESS_OK);
+  assert(limitless_number_modexp(&ctx, &out, &a, &b, &mod) == LIMITLESS_ETYPE);
+
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &out);
+  limitless_number_clear(&ctx, &mod);
+}
+
+static void check_residue(limitless_ctx* ctx, limitless_modctx* mc, const limitless_number* r, const char* expected) {
+  limitless_number v;
+  assert(limitless_number_init(ctx, &v) == LIMITLESS_OK);
+  assert(limitless_modctx_from_residue(ctx, mc, &v, r) == LIMITLESS_OK);
+  check_str(ctx, &v, 10, expected);
+  limitless_number_clear(ctx, &v);
+}
+
+static void test_modctx(void) {
+  static const char* mods[2] = {
+    "115792089237316195423570985008687907853269984665640564039457584007913129639747",
+    "115792089237316195423570985008687907853269984665640564039457584007913129639748"};
+  /* add, sub, mul, pow and inv of 3^100 and -7^90 under each modulus */
+  static const char* expect[2][5] = {
+    {"104341611642995151064230858295658139296947991173392046311008638908494997134499",
+     "11450477594321044359340126714060523597786016154321439987980187644822347549250",
+     "103155258635199181010774216282275095950012449567691001444738706279765537374382",
+     "84442433127162482540441188051592955021093788521547923334404154309333377577778",
+     "18083838152137079506573073141303281480949017038133269753626459563120413628475"},
+    {"104341611642995151064230858295658139296947991173392046311008638908494997134500",
+     "11450477594321044359340126714060523597786016154321439987980187644822347549250",
+     "103155258635199181010774216282326060733467248943151527773208139126527885956755",
+     "50092439081275088424292225225796407011195665363351706896125297132827827989109",
+     "77227516805435384724449444644823576622642971133346547686503090077145962086041"}};
+  limitless_ctx ctx = make_ctx();
+  limitless_modctx mc;
+  limitless_number a, b, e, out, mod;
+  int i;
+  assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &b) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &e) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &out) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &mod) == LIMITLESS_OK);
+
+  /* odd moduli keep residues in Montgomery form, even ones plain */
+  for (i = 0; i < 2; ++i) {
+    assert(limitless_number_from_str(&ctx, &mod, mods[i]) == LIMITLESS_OK);
+    assert(limitless_modctx_init(&ctx, &mc, &mod) == LIMITLESS_OK);
+    assert(limitless_number_from_i64(&ctx, &a, 3) == LIMITLESS_OK);
+    assert(limitless_number_pow_u64(&ctx, &a, &a, 100) == LIMITLESS_OK);
+    assert(limitless_number_from_i64(&ctx, &b, -7) == LIMITLESS_OK);
+    assert(limitless_number_pow_u64(&ctx, &b, &b, 90) == LIMITLESS_OK);
+    assert(limitless_number_neg(&ctx, &b, &b) == LIMITLESS_OK);
+    assert(limitless_modctx_to_residue(&ctx, &mc, &a, &a) == LIMITLESS_OK);
+    assert(limitless_modctx_to_residue(&ctx, &mc, &b, &b) == LIMITLESS_OK);
+    check_residue(&ctx, &mc, &a, "515377520732011331036461129765621272702107522001");
+
+    assert(limitless_modctx_addmod(&ctx, &mc, &out, &a, &b) == LIMITLESS_OK);
+    check_residue(&ctx, &mc, &out, expect[i][0]);
+    assert(limitless_modctx_submod(&ctx, &mc, &out, &a, &b) == LIMITLESS_OK);
+    check_residue(&ctx, &mc, &out, expect[i][1]);
+    assert(limitless_modctx_mulmod(&ctx, &mc, &out, &a, &b) == LIMITLESS_OK);
+    check_residue(&ctx, &mc, &out, expect[i][2]);
+    assert(limitless_number_from_str(&ctx, &e, "1267650600228229401496703205377") == LIMITLESS_OK);
+    assert(limitless_modctx_powmod(&ctx, &mc, &out, &a, &e) == LIMITLESS_OK);
+    check_residue(&ctx, &mc, &out, expect[i][3]);
+    assert(limitless_modctx_invmod(&ctx, &mc, &out, &a) == LIMITLESS_OK);
+    check_residue(&ctx, &mc, &out, expect[i][4]);
+    assert(limitless_modctx_mulmod(&ctx, &mc, &out, &out, &a) == LIMITLESS_OK);
+    check_residue(&ctx, &mc, &out, "1");
+    assert(limitless_number_from_i64(&ctx, &e, 0) == LIMITLESS_OK);
+    assert(limitless_modctx_powmod(&ctx, &mc, &out, &b, &e) == LIMITLESS_OK);
+    check_residue(&ctx, &mc, &out, "1");
+    assert(limitless_modctx_submod(&ctx, &mc, &out, &b, &b) == LIMITLESS_OK);
+    assert(limitless_number_is_zero(&out));
+
+    /* operands outside [0, m) are rejected and leave out alone */
+    assert(limitless_modctx_mulmod(&ctx, &mc, &out, &a, &mod) == LIMITLESS_ERANGE);
+    assert(limitless_number_from_i64(&ctx, &e, -1) == LIMITLESS_OK);
+    assert(limitless_modctx_addmod(&ctx, &mc, &out, &e, &a) == LIMITLESS_ERANGE);
+    assert(limitless_modctx_powmod(&ctx, &mc, &out, &a, &e) == LIMITLESS_ERANGE);
+    assert(limitless_number_from_str(&ctx, &e, "1/2") == LIMITLESS_OK);
+    assert(limitless_modctx_to_residue(&ctx, &mc, &out, &e) == LIMITLESS_ETYPE);
+    assert(limitless_number_is_zero(&out));
+    limitless_modctx_clear(&ctx, &mc);
+  }
+
+  /* 2 shares a factor with the even modulus */
+  assert(limitless_modctx_init(&ctx, &mc, &mod) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(&ctx, &a, 2) == LIMITLESS_OK);
+  assert(limitless_modctx_invmod(&ctx, &mc, &out, &a) == LIMITLESS_EDIVZERO);
+  assert(limitless_modctx_mulmod_ct(&ctx, &mc, &out, &a, &a) == LIMITLESS_EINVAL);
+  assert(limitless_number_is_zero(&out));
+  limitless_modctx_clear(&ctx, &mc);
+
+  /* the constant-time path takes plain values and agrees with the residue path */
+  assert(limitless_number_from_str(&ctx, &mod, mods[0]) == LIMITLESS_OK);
+  assert(limitless_modctx_init(&ctx, &mc, &mod) == LIMITLESS_OK);
+  assert(limitless_number_from_str(&ctx, &a, "515377520732011331036461129765621272702107522001") == LIMITLESS_OK);
+  assert(limitless_number_from_str(&ctx, &b, "104341611642995151064230858295142761776215979842355585181243017635792889612498") == LIMITLESS_OK);
+  assert(limitless_modctx_mulmod_ct(&ctx, &mc, &out, &a, &b) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, expect[0][2]);
+  assert(limitless_number_from_str(&ctx, &e, "1267650600228229401496703205377") == LIMITLESS_OK);
+  assert(limitless_modctx_powmod_ct(&ctx, &mc, &out, &a, &e) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, expect[0][3]);
+  assert(limitless_modctx_mulmod_ct(&ctx, &mc, &out, &a, &mod) == LIMITLESS_ERANGE);
+  assert(limitless_modctx_powmod_ct(&ctx, &mc, &out, &mod, &e) == LIMITLESS_ERANGE);
+  check_str(&ctx, &out, 10, expect[0][3]);
+  assert(limitless_number_from_i64(&ctx, &e, 0) == LIMITLESS_OK);
+  assert(limitless_modctx_powmod_ct(&ctx, &mc, &b, &b, &e) == LIMITLESS_OK);
+  check_str(&ctx, &b, 10, "1");
+  limitless_modctx_clear(&ctx, &mc);
+
+  /* single-limb and unit moduli */
+  assert(limitless_number_from_i64(&ctx, &mod, 497) == LIMITLESS_OK);
+  assert(limitless_modctx_init(&ctx, &mc, &mod) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(&ctx, &a, -4) == LIMITLESS_OK);
+  assert(limitless_modctx_to_residue(&ctx, &mc, &a, &a) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(&ctx, &e, 13) == LIMITLESS_OK);
+  assert(limitless_modctx_powmod(&ctx, &mc, &out, &a, &e) == LIMITLESS_OK);
+  check_residue(&ctx, &mc, &out, "52");
+  limitless_modctx_clear(&ctx, &mc);
+  assert(limitless_number_from_i64(&ctx, &mod, 1) == LIMITLESS_OK);
+  assert(limitless_modctx_init(&ctx, &mc, &mod) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(&ctx, &e, 0) == LIMITLESS_OK);
+  assert(limitless_modctx_powmod(&ctx, &mc, &out, &e, &e) == LIMITLESS_OK);
+  check_residue(&ctx, &mc, &out, "0");
+  limitless_modctx_clear(&ctx, &mc);
+  assert(limitless_number_from_i64(&ctx, &mod, 0) == LIMITLESS_OK);
+  assert(limitless_modctx_init(&ctx, &mc, &mod) == LIMITLESS_EDIVZERO);
+  limitless_modctx_clear(&ctx, &mc);
+  /* negative moduli are rejected exactly as modexp rejects them, not taken as |m| */
+  assert(limitless_number_from_i64(&ctx, &mod, -497) == LIMITLESS_OK);
+  assert(limitless_modctx_init(&ctx, &mc, &mod) == LIMITLESS_EDIVZERO);
+  limitless_modctx_clear(&ctx, &mc);
+  assert(limitless_number_from_i64(&ctx, &a, 4) == LIMITLESS_OK);
+  assert(limitless_number_modexp_u64(&ctx, &out, &a, 13, &mod) == LIMITLESS_EDIVZERO);
+
   limitless_number_clear(&ctx, &a);
   limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &e);
   limitless_number_clear(&ctx, &out);
   limitless_number_clear(&ctx, &mod);
 }
@@ -260,9 +951,19 @@ static void test_integer_exports(void) {
 
 int main(void) {
   test_basic_arithmetic();
+  test_word_fast_path();
   test_rational_normalization();
+  test_rational_arithmetic();
   test_large_and_karatsuba_path();
+  test_toom3_path();
+  test_ntt_path();
+  test_square_paths();
+  test_unbalanced_mul();
+  test_division_paths();
+  test_divmod_u64();
+  test_gcd_paths();
   test_gcd_pow_modexp();
+  test_modctx();
   test_float_exact();
   test_parse_format_bases();
   test_default_aliases();
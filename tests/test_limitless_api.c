@@ -306,10 +306,15 @@ static void test_failure_atomicity_matrix(void) {
 
   set_marker(&ctx, &out);
   state.fail_after = state.calls;
-  assert(limitless_number_from_double_exact(&ctx, &out, 0.1) == LIMITLESS_EOOM);
+  assert(limitless_number_from_double_exact(&ctx, &out, 1e-300) == LIMITLESS_EOOM);
   state.fail_after = 1000000;
   expect_marker(&ctx, &out);
 
+  /* 0.1 == 3602879701896397/2^55 fits the inline limbs and never allocates */
+  state.fail_after = state.calls;
+  assert(limitless_number_from_double_exact(&ctx, &out, 0.1) == LIMITLESS_OK);
+  state.fail_after = 1000000;
+
   set_marker(&ctx, &out);
   state.fail_after = state.calls;
   assert(limitless_number_add(&ctx, &out, &lhs, &rhs) == LIMITLESS_EOOM);
@@ -400,6 +405,582 @@ static void test_invalid_kind_and_guard_paths(void) {
   limitless_number_clear(&ctx, &weird);
 }
 
+static void test_karatsuba_allocations(void) {
+  fail_alloc_state state;
+  limitless_alloc alloc;
+  limitless_ctx ctx;
+  limitless_number a;
+  limitless_number b;
+  limitless_number out;
+  char hex[1601];
+  int i;
+  int calls;
+  int step;
+
+  state.fail_after = 1000000;
+  state.calls = 0;
+  alloc.alloc = fail_alloc;
+  alloc.realloc = fail_realloc;
+  alloc.free = fail_free;
+  alloc.user = &state;
+  assert(limitless_ctx_init(&ctx, &alloc) == LIMITLESS_OK);
+  limitless_ctx_set_karatsuba_threshold(&ctx, 4);
+  limitless_ctx_set_toom3_threshold(&ctx, (limitless_size)-1);
+  limitless_ctx_set_ntt_threshold(&ctx, (limitless_size)-1);
+
+  assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &b) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &out) == LIMITLESS_OK);
+  for (i = 0; i < 1600; ++i) hex[i] = "0123456789abcdef"[(i * 13 + 5) % 16];
+  hex[0] = 'f';
+  hex[1600] = '\0';
+  assert(limitless_number_from_cstr(&ctx, &a, hex, 16) == LIMITLESS_OK);
+  hex[1100] = '\0';
+  assert(limitless_number_from_cstr(&ctx, &b, hex, 16) == LIMITLESS_OK);
+
+  /* the whole recursion shares one scratch area: allocations do not grow with depth */
+  state.calls = 0;
+  assert(limitless_number_mul(&ctx, &out, &a, &b) == LIMITLESS_OK);
+  calls = state.calls;
+  assert(calls <= 4);
+  state.calls = 0;
+  assert(limitless_number_mul(&ctx, &out, &a, &a) == LIMITLESS_OK);
+  assert(state.calls <= 4);
+
+  for (step = 0; step < calls; ++step) {
+    set_marker(&ctx, &out);
+    state.calls = 0;
+    state.fail_after = step;
+    assert(limitless_number_mul(&ctx, &out, &a, &b) == LIMITLESS_EOOM);
+    state.fail_after = 1000000;
+    expect_marker(&ctx, &out);
+  }
+
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &out);
+}
+
+static void test_inplace_buffer_reuse(void) {
+  fail_alloc_state state;
+  limitless_alloc alloc;
+  limitless_ctx ctx;
+  limitless_number a;
+  limitless_number b;
+  limitless_number x;
+  limitless_number acc;
+  limitless_number out;
+  char hex[401];
+  int i;
+  int calls;
+  int step;
+
+  state.fail_after = 1000000;
+  state.calls = 0;
+  alloc.alloc = fail_alloc;
+  alloc.realloc = fail_realloc;
+  alloc.free = fail_free;
+  alloc.user = &state;
+  assert(limitless_ctx_init(&ctx, &alloc) == LIMITLESS_OK);
+  limitless_ctx_set_karatsuba_threshold(&ctx, 4);
+  limitless_ctx_set_toom3_threshold(&ctx, 8);
+
+  assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &b) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &x) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &acc) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &out) == LIMITLESS_OK);
+  for (i = 0; i < 400; ++i) hex[i] = "0123456789abcdef"[(i * 7 + 3) % 16];
+  hex[0] = 'f';
+  hex[400] = '\0';
+  assert(limitless_number_from_cstr(&ctx, &a, hex, 16) == LIMITLESS_OK);
+  hex[300] = '\0';
+  assert(limitless_number_from_cstr(&ctx, &b, hex, 16) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(&ctx, &x, -987654321) == LIMITLESS_OK);
+
+  /* once out has the capacity, integer results are written straight into it */
+  assert(limitless_number_copy(&ctx, &acc, &a) == LIMITLESS_OK);
+  assert(limitless_number_add(&ctx, &acc, &acc, &x) == LIMITLESS_OK);
+  assert(limitless_number_sub(&ctx, &acc, &acc, &x) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &out, &a, &b) == LIMITLESS_OK);
+  state.calls = 0;
+  for (i = 0; i < 1000; ++i) {
+    assert(limitless_number_add(&ctx, &acc, &acc, &x) == LIMITLESS_OK);
+    assert(limitless_number_sub(&ctx, &acc, &acc, &x) == LIMITLESS_OK);
+    assert(limitless_number_sub(&ctx, &acc, &x, &acc) == LIMITLESS_OK);
+    assert(limitless_number_neg(&ctx, &acc, &acc) == LIMITLESS_OK);
+    assert(limitless_number_add(&ctx, &acc, &acc, &x) == LIMITLESS_OK);
+  }
+  assert(limitless_number_copy(&ctx, &out, &b) == LIMITLESS_OK);
+  assert(limitless_number_abs(&ctx, &out, &x) == LIMITLESS_OK);
+  assert(state.calls == 0);
+  check_str(&ctx, &out, 10, "987654321");
+  assert(limitless_number_cmp(&ctx, &acc, &a, NULL) == 0);
+
+  /* a direct write that needs to grow out fails before touching it */
+  state.calls = 0;
+  assert(limitless_number_from_i64(&ctx, &out, 4242) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &out, &a, &b) == LIMITLESS_OK);
+  calls = state.calls;
+  for (step = 0; step < calls; ++step) {
+    state.fail_after = 1000000;
+    limitless_number_clear(&ctx, &out);
+    assert(limitless_number_from_i64(&ctx, &out, 4242) == LIMITLESS_OK);
+    state.calls = 0;
+    state.fail_after = step;
+    assert(limitless_number_mul(&ctx, &out, &a, &b) == LIMITLESS_EOOM);
+    state.fail_after = 1000000;
+    check_str(&ctx, &out, 10, "4242");
+  }
+  state.calls = 0;
+  state.fail_after = 0;
+  assert(limitless_number_add(&ctx, &out, &a, &x) == LIMITLESS_EOOM);
+  assert(limitless_number_copy(&ctx, &out, &a) == LIMITLESS_EOOM);
+  assert(limitless_number_neg(&ctx, &out, &b) == LIMITLESS_EOOM);
+  state.fail_after = 1000000;
+  check_str(&ctx, &out, 10, "4242");
+  assert(limitless_number_sub(&ctx, &out, &out, &out) == LIMITLESS_OK);
+  check_str(&ctx, &out, 10, "0");
+
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &x);
+  limitless_number_clear(&ctx, &acc);
+  limitless_number_clear(&ctx, &out);
+}
+
+static void pool_workload(limitless_ctx* ctx, const limitless_number* a, const limitless_number* b) {
+  limitless_number t;
+  limitless_number u;
+  char buf[1024];
+  assert(limitless_number_init(ctx, &t) == LIMITLESS_OK);
+  assert(limitless_number_init(ctx, &u) == LIMITLESS_OK);
+  assert(limitless_number_mul(ctx, &t, a, b) == LIMITLESS_OK);
+  assert(limitless_number_div(ctx, &u, &t, a) == LIMITLESS_OK);
+  assert(limitless_number_cmp(ctx, &u, b, NULL) == 0);
+  assert(limitless_number_div(ctx, &u, a, b) == LIMITLESS_OK);
+  assert(limitless_number_add(ctx, &u, &u, &t) == LIMITLESS_OK);
+  assert(limitless_number_gcd(ctx, &u, &t, b) == LIMITLESS_OK);
+  assert(limitless_number_to_cstr(ctx, &t, 10, buf, sizeof(buf), NULL) == LIMITLESS_OK);
+  assert(limitless_number_from_cstr(ctx, &u, buf, 10) == LIMITLESS_OK);
+  assert(limitless_number_cmp(ctx, &u, &t, NULL) == 0);
+  limitless_number_clear(ctx, &t);
+  limitless_number_clear(ctx, &u);
+}
+
+static void test_pool_allocator(void) {
+  fail_alloc_state state;
+  limitless_alloc backing;
+  limitless_alloc alloc;
+  limitless_pool pool;
+  limitless_pool_stats stats;
+  limitless_ctx ctx;
+  limitless_number a;
+  limitless_number b;
+  limitless_number out;
+  limitless_size mark;
+  limitless_size cached;
+  int calls;
+
+  state.fail_after = 1000000;
+  state.calls = 0;
+  backing.alloc = fail_alloc;
+  backing.realloc = fail_realloc;
+  backing.free = fail_free;
+  backing.user = &state;
+  assert(limitless_pool_init(NULL, &backing, 0) == LIMITLESS_EINVAL);
+  alloc = backing;
+  alloc.free = NULL;
+  assert(limitless_pool_init(&pool, &alloc, 0) == LIMITLESS_EINVAL);
+  state.fail_after = 0;
+  assert(limitless_pool_init(&pool, &backing, 4096) == LIMITLESS_EOOM);
+  state.fail_after = 1000000;
+  state.calls = 0;
+
+  /* a warm pool serves a repeated workload without touching the backing allocator */
+  assert(limitless_pool_init(&pool, &backing, 0) == LIMITLESS_OK);
+  limitless_pool_allocator(&pool, &alloc);
+  assert(limitless_ctx_init(&ctx, &alloc) == LIMITLESS_OK);
+  limitless_ctx_set_karatsuba_threshold(&ctx, 4);
+  assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &b) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &out) == LIMITLESS_OK);
+  assert(limitless_number_from_str(&ctx, &a, "-98765432109876543210987654321098765432109876543210987654321098765432109876543211") == LIMITLESS_OK);
+  assert(limitless_number_from_str(&ctx, &b, "1234567890123456789012345678901234567890123456789012345678901234567") == LIMITLESS_OK);
+  pool_workload(&ctx, &a, &b);
+  calls = state.calls;
+  pool_workload(&ctx, &a, &b);
+  pool_workload(&ctx, &a, &b);
+  assert(state.calls == calls);
+  limitless_pool_get_stats(&pool, &stats);
+  assert(stats.hits > stats.misses);
+  assert(stats.backing_calls >= (limitless_size)calls);
+  assert(stats.cached_bytes > 0 && stats.arena_cap == 0);
+
+  /* a miss the backing allocator refuses surfaces as EOOM and leaves out alone */
+  limitless_pool_trim(&pool);
+  limitless_pool_get_stats(&pool, &stats);
+  assert(stats.cached_bytes == 0);
+  state.fail_after = state.calls;
+  assert(limitless_number_from_i64(&ctx, &out, 4242) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &out, &a, &b) == LIMITLESS_EOOM);
+  state.fail_after = 1000000;
+  check_str(&ctx, &out, 10, "4242");
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_number_clear(&ctx, &out);
+  limitless_pool_destroy(&pool);
+
+  /* misses are carved from the arena, and release rewinds it to the mark */
+  state.calls = 0;
+  assert(limitless_pool_init(&pool, &backing, 1u << 16) == LIMITLESS_OK);
+  limitless_pool_allocator(&pool, &alloc);
+  assert(limitless_ctx_init(&ctx, &alloc) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &b) == LIMITLESS_OK);
+  assert(limitless_number_from_str(&ctx, &a, "340282366920938463463374607431768211457") == LIMITLESS_OK);
+  assert(limitless_number_from_str(&ctx, &b, "-1208925819614629174706177") == LIMITLESS_OK);
+  mark = limitless_pool_mark(&pool);
+  assert(mark > 0);
+  limitless_pool_get_stats(&pool, &stats);
+  cached = stats.cached_bytes;
+  pool_workload(&ctx, &a, &b);
+  limitless_pool_get_stats(&pool, &stats);
+  assert(stats.arena_used > mark && stats.cached_bytes > 0);
+  assert(stats.backing_calls == 1 && state.calls == 1);
+  limitless_pool_release(&pool, mark);
+  limitless_pool_get_stats(&pool, &stats);
+  assert(stats.arena_used == mark && stats.cached_bytes == cached);
+  check_str(&ctx, &a, 10, "340282366920938463463374607431768211457");
+  pool_workload(&ctx, &a, &b);
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  limitless_pool_destroy(&pool);
+  limitless_pool_destroy(&pool);
+  limitless_pool_destroy(NULL);
+}
+
+static int scratch_workload(limitless_ctx* ctx, const limitless_number* a, const limitless_number* b, char* buf, limitless_size cap) {
+  limitless_number t;
+  limitless_number q;
+  fail_alloc_state* state = (fail_alloc_state*)ctx->allocator.user;
+  int calls = state->calls;
+  assert(limitless_number_init(ctx, &t) == LIMITLESS_OK);
+  assert(limitless_number_init(ctx, &q) == LIMITLESS_OK);
+  assert(limitless_number_mul(ctx, &t, a, b) == LIMITLESS_OK);
+  assert(limitless_number_div(ctx, &q, &t, b) == LIMITLESS_OK);
+  assert(limitless_number_cmp(ctx, &q, a, NULL) == 0);
+  assert(limitless_number_to_cstr(ctx, &t, 10, buf, cap, NULL) == LIMITLESS_OK);
+  limitless_number_clear(ctx, &t);
+  limitless_number_clear(ctx, &q);
+  return state->calls - calls;
+}
+
+static void test_scratch_stack(void) {
+  fail_alloc_state state;
+  limitless_alloc alloc;
+  limitless_ctx ctx;
+  limitless_number a;
+  limitless_number b;
+  limitless_limb* stack;
+  limitless_size high;
+  char hex[601];
+  char ref[2048];
+  char buf[2048];
+  int heap_calls;
+  int i;
+
+  state.fail_after = 1000000;
+  state.calls = 0;
+  alloc.alloc = fail_alloc;
+  alloc.realloc = fail_realloc;
+  alloc.free = fail_free;
+  alloc.user = &state;
+  assert(limitless_ctx_init(&ctx, &alloc) == LIMITLESS_OK);
+  limitless_ctx_set_karatsuba_threshold(&ctx, 4);
+  assert(limitless_ctx_scratch_high_water(&ctx) == 0);
+  assert(limitless_ctx_scratch_high_water(NULL) == 0);
+  limitless_ctx_set_scratch(NULL, NULL, 0);
+
+  assert(limitless_number_init(&ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &b) == LIMITLESS_OK);
+  for (i = 0; i < 600; ++i) hex[i] = "0123456789abcdef"[(i * 5 + 1) % 16];
+  hex[0] = '9';
+  hex[600] = '\0';
+  assert(limitless_number_from_cstr(&ctx, &a, hex, 16) == LIMITLESS_OK);
+  hex[240] = '\0';
+  assert(limitless_number_from_cstr(&ctx, &b, hex, 16) == LIMITLESS_OK);
+
+  /* without a buffer every temporary comes from the allocator, but the demand is still recorded */
+  heap_calls = scratch_workload(&ctx, &a, &b, ref, sizeof(ref));
+  high = limitless_ctx_scratch_high_water(&ctx);
+  assert(high > 0);
+
+  /* a buffer of the high-water size serves all of it */
+  stack = (limitless_limb*)malloc((size_t)high * sizeof(limitless_limb));
+  assert(stack != NULL);
+  limitless_ctx_set_scratch(&ctx, stack, high);
+  assert(limitless_ctx_scratch_high_water(&ctx) == 0);
+  assert(scratch_workload(&ctx, &a, &b, buf, sizeof(buf)) < heap_calls);
+  assert(strcmp(buf, ref) == 0);
+  assert(limitless_ctx_scratch_high_water(&ctx) == high);
+  assert(ctx.scratch_top == 0 && ctx.scratch_depth == 0);
+
+  /* a short buffer spills the requests that do not fit */
+  limitless_ctx_set_scratch(&ctx, stack, 3);
+  assert(scratch_workload(&ctx, &a, &b, buf, sizeof(buf)) <= heap_calls);
+  assert(strcmp(buf, ref) == 0);
+  assert(ctx.scratch_top == 0 && ctx.scratch_depth == 0);
+
+  /* spilled requests that fail report EOOM and leave the stack balanced */
+  limitless_ctx_set_scratch(&ctx, NULL, 0);
+  for (i = 0; i < heap_calls; ++i) {
+    limitless_number t;
+    limitless_status st;
+    assert(limitless_number_init(&ctx, &t) == LIMITLESS_OK);
+    state.calls = 0;
+    state.fail_after = i;
+    st = limitless_number_mul(&ctx, &t, &a, &b);
+    if (st == LIMITLESS_OK) st = limitless_number_to_cstr(&ctx, &t, 10, buf, sizeof(buf), NULL);
+    assert(st == LIMITLESS_OK || st == LIMITLESS_EOOM);
+    state.fail_after = 1000000;
+    assert(ctx.scratch_top == 0 && ctx.scratch_depth == 0);
+    limitless_number_clear(&ctx, &t);
+  }
+
+  limitless_number_clear(&ctx, &a);
+  limitless_number_clear(&ctx, &b);
+  free(stack);
+}
+
+static void test_reserve_and_shrink(void) {
+  fail_alloc_state state;
+  limitless_alloc alloc;
+  limitless_ctx ctx;
+  limitless_number n;
+  limitless_number r;
+  limitless_number two;
+  limitless_number expect;
+  char digits[2001];
+  int i;
+
+  state.fail_after = 1000000;
+  state.calls = 0;
+  alloc.alloc = fail_alloc;
+  alloc.realloc = fail_realloc;
+  alloc.free = fail_free;
+  alloc.user = &state;
+  assert(limitless_ctx_init(&ctx, &alloc) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &n) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &r) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &two) == LIMITLESS_OK);
+  assert(limitless_number_init(&ctx, &expect) == LIMITLESS_OK);
+  assert(limitless_number_reserve(NULL, &n, 64) == LIMITLESS_EINVAL);
+  assert(limitless_number_reserve(&ctx, NULL, 64) == LIMITLESS_EINVAL);
+  assert(limitless_number_shrink_to_fit(&ctx, NULL) == LIMITLESS_EINVAL);
+
+  /* a reserved value grows to that size with no further allocator calls */
+  assert(limitless_number_from_i64(&ctx, &n, -3) == LIMITLESS_OK);
+  state.fail_after = 0;
+  assert(limitless_number_reserve(&ctx, &n, 4096) == LIMITLESS_EOOM);
+  state.fail_after = 1000000;
+  check_str(&ctx, &n, 10, "-3");
+  state.calls = 0;
+  assert(limitless_number_reserve(&ctx, &n, 4096) == LIMITLESS_OK);
+  assert(limitless_number_reserve(&ctx, &n, 100) == LIMITLESS_OK);
+  for (i = 0; i < 4000; ++i) assert(limitless_number_add(&ctx, &n, &n, &n) == LIMITLESS_OK);
+  assert(state.calls == 1);
+  assert(limitless_number_from_i64(&ctx, &two, 2) == LIMITLESS_OK);
+  assert(limitless_number_pow_u64(&ctx, &expect, &two, 4000) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(&ctx, &two, -3) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &expect, &expect, &two) == LIMITLESS_OK);
+  assert(limitless_number_cmp(&ctx, &n, &expect, NULL) == 0);
+
+  /* shrinking trims the block to the value, or returns small values to inline storage */
+  assert(n.v.i.cap > n.v.i.used);
+  assert(limitless_number_shrink_to_fit(&ctx, &n) == LIMITLESS_OK);
+  assert(n.v.i.cap == n.v.i.used);
+  assert(limitless_number_cmp(&ctx, &n, &expect, NULL) == 0);
+  assert(limitless_number_from_i64(&ctx, &two, 77) == LIMITLESS_OK);
+  assert(limitless_number_sub(&ctx, &n, &n, &expect) == LIMITLESS_OK);
+  assert(limitless_number_add(&ctx, &n, &n, &two) == LIMITLESS_OK);
+  assert(n.v.i.limbs != NULL);
+  assert(limitless_number_shrink_to_fit(&ctx, &n) == LIMITLESS_OK);
+  assert(n.v.i.limbs == NULL && n.v.i.cap == 0);
+  check_str(&ctx, &n, 10, "77");
+  assert(limitless_number_shrink_to_fit(&ctx, &n) == LIMITLESS_OK);
+
+  /* rationals size and trim both parts */
+  assert(limitless_number_from_str(&ctx, &r, "-5/7") == LIMITLESS_OK);
+  assert(limitless_number_reserve(&ctx, &r, 1000) == LIMITLESS_OK);
+  assert(r.v.r.num.cap * LIMITLESS_LIMB_BITS >= 1000 && r.v.r.den.cap * LIMITLESS_LIMB_BITS >= 1000);
+  assert(limitless_number_shrink_to_fit(&ctx, &r) == LIMITLESS_OK);
+  assert(r.v.r.num.limbs == NULL && r.v.r.den.limbs == NULL);
+  check_str(&ctx, &r, 10, "-5/7");
+
+  /* the parser sizes its result from the digit count */
+  for (i = 0; i < 2000; ++i) digits[i] = (char)('1' + i % 9);
+  digits[2000] = '\0';
+  state.calls = 0;
+  assert(limitless_number_from_str(&ctx, &n, digits) == LIMITLESS_OK);
+  assert(state.calls <= 2);
+  check_str(&ctx, &n, 10, digits);
+
+  limitless_number_clear(&ctx, &n);
+  limitless_number_clear(&ctx, &r);
+  limitless_number_clear(&ctx, &two);
+  limitless_number_clear(&ctx, &expect);
+}
+
+static limitless_kernels g_detected_kernels;
+static int g_kernel_calls = 0;
+
+static limitless_limb counting_mul_1(limitless_limb* r, const limitless_limb* a, limitless_size n, limitless_limb m) {
+  ++g_kernel_calls;
+  return g_detected_kernels.mul_1(r, a, n, m);
+}
+
+static limitless_limb counting_addmul_1(limitless_limb* r, const limitless_limb* a, limitless_size n, limitless_limb m) {
+  ++g_kernel_calls;
+  return g_detected_kernels.addmul_1(r, a, n, m);
+}
+
+static limitless_limb counting_submul_1(limitless_limb* r, const limitless_limb* a, limitless_size n, limitless_limb m) {
+  ++g_kernel_calls;
+  return g_detected_kernels.submul_1(r, a, n, m);
+}
+
+static limitless_limb counting_add_n(limitless_limb* r, const limitless_limb* a, const limitless_limb* b, limitless_size n) {
+  ++g_kernel_calls;
+  return g_detected_kernels.add_n(r, a, b, n);
+}
+
+static limitless_limb counting_sub_n(limitless_limb* r, const limitless_limb* a, const limitless_limb* b, limitless_size n) {
+  ++g_kernel_calls;
+  return g_detected_kernels.sub_n(r, a, b, n);
+}
+
+/*
+add_n and sub_n against the portable set on spans built from 0, 1, all-ones
+and pseudo-random limbs, so carries and borrows ripple across whole blocks
+*/
+static void check_addsub_kernels(const limitless_kernels* fast, const limitless_kernels* ref) {
+  limitless_limb a[40];
+  limitless_limb b[40];
+  limitless_limb r0[40];
+  limitless_limb r1[40];
+  limitless_u64 x = 0x243f6a8885a308d3ULL;
+  limitless_size n;
+  limitless_size i;
+  int round;
+  for (round = 0; round < 64; ++round) {
+    for (i = 0; i < 40; ++i) {
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+      switch ((x >> 60) & 3u) {
+        case 0: a[i] = (limitless_limb)0; break;
+        case 1: a[i] = ~(limitless_limb)0; break;
+        case 2: a[i] = (limitless_limb)1; break;
+        default: a[i] = (limitless_limb)x; break;
+      }
+      b[i] = ((x >> 58) & 1u) ? (limitless_limb)(x >> 5) : (limitless_limb)(((x >> 57) & 1u) ? 0u : 1u);
+    }
+    for (n = 0; n <= 40; ++n) {
+      limitless_limb c0 = ref->add_n(r0, a, b, n);
+      limitless_limb c1 = fast->add_n(r1, a, b, n);
+      assert(c0 == c1);
+      for (i = 0; i < n; ++i) assert(r0[i] == r1[i]);
+      c0 = ref->sub_n(r0, a, b, n);
+      c1 = fast->sub_n(r1, a, b, n);
+      assert(c0 == c1);
+      for (i = 0; i < n; ++i) assert(r0[i] == r1[i]);
+    }
+  }
+}
+
+/* products and remainders of 1..40-limb operands under one kernel set */
+static void kernel_workload(limitless_ctx* ctx, limitless_number* prod, limitless_number* rem, limitless_size limbs) {
+  limitless_number a;
+  limitless_number b;
+  assert(limitless_number_init(ctx, &a) == LIMITLESS_OK);
+  assert(limitless_number_init(ctx, &b) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(ctx, &a, -3) == LIMITLESS_OK);
+  assert(limitless_number_pow_u64(ctx, &a, &a, (limitless_u64)limbs * LIMITLESS_LIMB_BITS * 1000u / 1585u) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(ctx, &b, 7) == LIMITLESS_OK);
+  assert(limitless_number_pow_u64(ctx, &b, &b, (limitless_u64)limbs * LIMITLESS_LIMB_BITS * 1000u / 2808u + 1u) == LIMITLESS_OK);
+  assert(limitless_number_sub(ctx, &b, &b, &a) == LIMITLESS_OK);
+  assert(limitless_number_mul(ctx, prod, &a, &b) == LIMITLESS_OK);
+  /* (prod + b) - prod == b, through add_n, sub_n and the blocked compare */
+  assert(limitless_number_add(ctx, &a, prod, &b) == LIMITLESS_OK);
+  assert(limitless_number_sub(ctx, &a, &a, prod) == LIMITLESS_OK);
+  check_cmp_eq(ctx, &a, &b);
+  /* 2^k - 1 + 1 in place: the borrow and then the carry ripple through every limb */
+  assert(limitless_number_from_i64(ctx, &a, 1) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(ctx, rem, 2) == LIMITLESS_OK);
+  assert(limitless_number_pow_u64(ctx, rem, rem, (limitless_u64)limbs * LIMITLESS_LIMB_BITS * 2u) == LIMITLESS_OK);
+  assert(limitless_number_sub(ctx, rem, rem, &a) == LIMITLESS_OK);
+  assert(limitless_number_add(ctx, rem, rem, &a) == LIMITLESS_OK);
+  assert(limitless_number_from_i64(ctx, &a, 2) == LIMITLESS_OK);
+  assert(limitless_number_pow_u64(ctx, &a, &a, (limitless_u64)limbs * LIMITLESS_LIMB_BITS * 2u) == LIMITLESS_OK);
+  check_cmp_eq(ctx, rem, &a);
+  assert(limitless_number_mul(ctx, &a, prod, prod) == LIMITLESS_OK);
+  assert(limitless_number_modexp_u64(ctx, rem, &a, 3, &b) == LIMITLESS_OK);
+  limitless_number_clear(ctx, &a);
+  limitless_number_clear(ctx, &b);
+}
+
+static void test_kernel_dispatch(void) {
+  limitless_ctx ctx = make_ctx();
+  limitless_kernels partial;
+  limitless_kernels counting;
+  limitless_kernels portable;
+  limitless_number p[3];
+  limitless_number r[3];
+  limitless_size limbs;
+  int k;
+
+  g_detected_kernels = ctx.kernels;
+  assert(g_detected_kernels.mul_1 && g_detected_kernels.addmul_1 && g_detected_kernels.submul_1);
+  assert(g_detected_kernels.add_n && g_detected_kernels.sub_n);
+  counting.mul_1 = counting_mul_1;
+  counting.addmul_1 = counting_addmul_1;
+  counting.submul_1 = counting_submul_1;
+  counting.add_n = counting_add_n;
+  counting.sub_n = counting_sub_n;
+  partial = counting;
+  partial.sub_n = NULL;
+  limitless_ctx_set_kernels(NULL, &counting);
+  limitless_ctx_set_kernels(&ctx, &partial);
+  assert(ctx.kernels.mul_1 == g_detected_kernels.mul_1);
+  limitless_ctx_set_kernels(&ctx, NULL);
+  portable = ctx.kernels;
+  check_addsub_kernels(&g_detected_kernels, &portable);
+
+  for (k = 0; k < 3; ++k) {
+    assert(limitless_number_init(&ctx, &p[k]) == LIMITLESS_OK);
+    assert(limitless_number_init(&ctx, &r[k]) == LIMITLESS_OK);
+  }
+  /* detected kernels, the portable C kernels, and counting wrappers around the detected ones */
+  for (limbs = 1; limbs <= 40; ++limbs) {
+    limitless_ctx_set_kernels(&ctx, &g_detected_kernels);
+    kernel_workload(&ctx, &p[0], &r[0], limbs);
+    limitless_ctx_set_kernels(&ctx, NULL);
+    kernel_workload(&ctx, &p[1], &r[1], limbs);
+    limitless_ctx_set_kernels(&ctx, &counting);
+    kernel_workload(&ctx, &p[2], &r[2], limbs);
+    for (k = 1; k < 3; ++k) {
+      check_cmp_eq(&ctx, &p[0], &p[k]);
+      check_cmp_eq(&ctx, &r[0], &r[k]);
+    }
+  }
+  assert(g_kernel_calls > 0);
+  for (k = 0; k < 3; ++k) {
+    limitless_number_clear(&ctx, &p[k]);
+    limitless_number_clear(&ctx, &r[k]);
+  }
+}
+
 static void test_deep_oom_sweeps(void) {
   fail_alloc_state state;
   limitless_alloc alloc;
@@ -413,6 +994,8 @@ static void test_deep_oom_sweeps(void) {
   limitless_number cmp_b;
   limitless_number pow_base;
   limitless_number mod;
+  limitless_number residue;
+  limitless_modctx mc;
   int step;
   int saw_oom;
   char buf[1024];
@@ -437,26 +1020,30 @@ static void test_deep_oom_sweeps(void) {
   assert(limitless_number_init(&ctx, &pow_base) == LIMITLESS_OK);
   assert(limitless_number_init(&ctx, &mod) == LIMITLESS_OK);
 
-  assert(limitless_number_from_i64(&ctx, &neg_int, -123456789) == LIMITLESS_OK);
+  assert(limitless_number_from_str(&ctx, &neg_int, "-123456789012345678901234567890123456789012345") == LIMITLESS_OK);
   assert(limitless_number_from_str(&ctx, &neg_rat, "-9876543210123456789/97") == LIMITLESS_OK);
-  assert(limitless_number_from_str(&ctx, &div_a, "123456789012345678901234567890123456789") == LIMITLESS_OK);
+  assert(limitless_number_from_str(&ctx, &div_a, "123456789012345678901234567890123456789012345678901234567890") == LIMITLESS_OK);
   assert(limitless_number_from_str(&ctx, &div_b, "97") == LIMITLESS_OK);
   assert(limitless_number_from_str(&ctx, &cmp_a, "12345678901234567890123456789/97") == LIMITLESS_OK);
   assert(limitless_number_from_str(&ctx, &cmp_b, "-998877665544332211009988776655/89") == LIMITLESS_OK);
   assert(limitless_number_from_str(&ctx, &pow_base, "11223344556677889900112233445566778899") == LIMITLESS_OK);
   assert(limitless_number_from_str(&ctx, &mod, "100000000000000000000000000000000000003") == LIMITLESS_OK);
 
-  set_marker(&ctx, &out);
+  /* word-sized values live in the inline limbs: no allocator call can fail them */
   state.calls = 0;
   state.fail_after = 0;
-  assert(limitless_number_from_i64(&ctx, &out, 1) == LIMITLESS_EOOM);
+  assert(limitless_number_from_i64(&ctx, &out, -1) == LIMITLESS_OK);
+  assert(limitless_number_from_u64(&ctx, &out, 0xffffffffffffULL) == LIMITLESS_OK);
+  assert(limitless_number_add(&ctx, &out, &out, &out) == LIMITLESS_OK);
+  assert(limitless_number_mul(&ctx, &out, &out, &out) == LIMITLESS_OK);
+  assert(state.calls == 0);
   state.fail_after = 1000000;
-  expect_marker(&ctx, &out);
+  check_str(&ctx, &out, 10, "316912650057055098574362116100");
 
   set_marker(&ctx, &out);
   state.calls = 0;
   state.fail_after = 0;
-  assert(limitless_number_from_u64(&ctx, &out, 1u) == LIMITLESS_EOOM);
+  assert(limitless_number_from_str(&ctx, &out, "-123456789012345678901234567890123456789012") == LIMITLESS_EOOM);
   state.fail_after = 1000000;
   expect_marker(&ctx, &out);
 
@@ -553,6 +1140,56 @@ static void test_deep_oom_sweeps(void) {
   }
   assert(saw_oom);
 
+  /* a failed modctx_init leaves nothing to leak; powmod under a built one is failure-atomic */
+  saw_oom = 0;
+  for (step = 0; step < 128; ++step) {
+    state.fail_after = step;
+    state.calls = 0;
+    if (limitless_modctx_init(&ctx, &mc, &div_a) == LIMITLESS_EOOM) saw_oom = 1;
+    limitless_modctx_clear(&ctx, &mc);
+  }
+  assert(saw_oom);
+  state.fail_after = 1000000;
+  assert(limitless_number_init(&ctx, &residue) == LIMITLESS_OK);
+  assert(limitless_modctx_init(&ctx, &mc, &div_a) == LIMITLESS_OK);
+  assert(limitless_modctx_to_residue(&ctx, &mc, &residue, &pow_base) == LIMITLESS_OK);
+  saw_oom = 0;
+  for (step = 0; step < 384; ++step) {
+    state.fail_after = 1000000;
+    state.calls = 0;
+    set_marker(&ctx, &out);
+    state.fail_after = step;
+    state.calls = 0;
+    if (limitless_modctx_powmod(&ctx, &mc, &out, &residue, &div_b) == LIMITLESS_EOOM) {
+      saw_oom = 1;
+      state.fail_after = 1000000;
+      expect_marker(&ctx, &out);
+    }
+  }
+  assert(saw_oom);
+  state.fail_after = 1000000;
+  limitless_modctx_clear(&ctx, &mc);
+
+  /* gcdext writes neither output unless every step succeeds */
+  saw_oom = 0;
+  for (step = 0; step < 512; ++step) {
+    state.fail_after = 1000000;
+    state.calls = 0;
+    set_marker(&ctx, &out);
+    set_marker(&ctx, &residue);
+    state.fail_after = step;
+    state.calls = 0;
+    if (limitless_number_gcdext(&ctx, &out, &residue, NULL, &div_a, &div_b) == LIMITLESS_EOOM) {
+      saw_oom = 1;
+      state.fail_after = 1000000;
+      expect_marker(&ctx, &out);
+      expect_marker(&ctx, &residue);
+    }
+  }
+  assert(saw_oom);
+  state.fail_after = 1000000;
+  limitless_number_clear(&ctx, &residue);
+
   state.fail_after = 1000000;
   limitless_number_clear(&ctx, &out);
   limitless_number_clear(&ctx, &neg_int);
@@ -571,6 +1208,12 @@ int main(void) {
   test_failure_atomicity_matrix();
   test_invalid_kind_and_guard_paths();
   test_deep_oom_sweeps();
+  test_karatsuba_allocations();
+  test_inplace_buffer_reuse();
+  test_pool_allocator();
+  test_scratch_stack();
+  test_reserve_and_shrink();
+  test_kernel_dispatch();
   printf("api/alias/failure-atomic tests ok\n");
   return 0;
 }
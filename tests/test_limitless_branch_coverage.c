@@ -51,6 +51,7 @@ static limitless_ctx make_fail_ctx(fail_alloc_state* state) {
 static void test_null_guards(void) {
   limitless_ctx ctx = make_ctx();
   limitless_number n, a, b, out;
+  limitless_modctx mc;
   limitless_alloc good_alloc;
   limitless_status st;
   char buf[64];
@@ -80,6 +81,18 @@ static void test_null_guards(void) {
   /* limitless_ctx_set_karatsuba_threshold: NULL ctx */
   limitless_ctx_set_karatsuba_threshold(NULL, 10);
 
+  /* limitless_ctx_set_toom3_threshold: NULL ctx */
+  limitless_ctx_set_toom3_threshold(NULL, 10);
+
+  /* limitless_ctx_set_ntt_threshold: NULL ctx */
+  limitless_ctx_set_ntt_threshold(NULL, 10);
+
+  /* limitless_ctx_set_bz_threshold: NULL ctx */
+  limitless_ctx_set_bz_threshold(NULL, 10);
+
+  /* limitless_ctx_set_hgcd_threshold: NULL ctx */
+  limitless_ctx_set_hgcd_threshold(NULL, 10);
+
   /* limitless_number_init: NULL n */
   assert(limitless_number_init(&ctx, NULL) == LIMITLESS_EINVAL);
 
@@ -136,6 +149,20 @@ static void test_null_guards(void) {
   assert(limitless_number_gcd(&ctx, &out, NULL, &b) == LIMITLESS_EINVAL);
   assert(limitless_number_gcd(&ctx, &out, &a, NULL) == LIMITLESS_EINVAL);
 
+  /* limitless_number_gcdext: NULL for each required arg, and shared outputs */
+  assert(limitless_number_gcdext(NULL, &out, NULL, NULL, &a, &b) == LIMITLESS_EINVAL);
+  assert(limitless_number_gcdext(&ctx, NULL, NULL, NULL, &a, &b) == LIMITLESS_EINVAL);
+  assert(limitless_number_gcdext(&ctx, &out, NULL, NULL, NULL, &b) == LIMITLESS_EINVAL);
+  assert(limitless_number_gcdext(&ctx, &out, NULL, NULL, &a, NULL) == LIMITLESS_EINVAL);
+  assert(limitless_number_gcdext(&ctx, &out, NULL, &out, &a, &b) == LIMITLESS_EINVAL);
+  assert(limitless_number_gcdext(&ctx, &out, &a, &a, &a, &b) == LIMITLESS_EINVAL);
+
+  /* limitless_number_invmod: NULL for each arg */
+  assert(limitless_number_invmod(NULL, &out, &a, &b) == LIMITLESS_EINVAL);
+  assert(limitless_number_invmod(&ctx, NULL, &a, &b) == LIMITLESS_EINVAL);
+  assert(limitless_number_invmod(&ctx, &out, NULL, &b) == LIMITLESS_EINVAL);
+  assert(limitless_number_invmod(&ctx, &out, &a, NULL) == LIMITLESS_EINVAL);
+
   /* limitless_number_pow_u64: NULL for each arg */
   assert(limitless_number_pow_u64(NULL, &out, &a, 2) == LIMITLESS_EINVAL);
   assert(limitless_number_pow_u64(&ctx, NULL, &a, 2) == LIMITLESS_EINVAL);
@@ -147,6 +174,48 @@ static void test_null_guards(void) {
   assert(limitless_number_modexp_u64(&ctx, &out, NULL, 2, &b) == LIMITLESS_EINVAL);
   assert(limitless_number_modexp_u64(&ctx, &out, &a, 2, NULL) == LIMITLESS_EINVAL);
 
+  /* limitless_number_modexp: NULL for each arg */
+  assert(limitless_number_modexp(NULL, &out, &a, &a, &b) == LIMITLESS_EINVAL);
+  assert(limitless_number_modexp(&ctx, NULL, &a, &a, &b) == LIMITLESS_EINVAL);
+  assert(limitless_number_modexp(&ctx, &out, NULL, &a, &b) == LIMITLESS_EINVAL);
+  assert(limitless_number_modexp(&ctx, &out, &a, NULL, &b) == LIMITLESS_EINVAL);
+  assert(limitless_number_modexp(&ctx, &out, &a, &a, NULL) == LIMITLESS_EINVAL);
+
+  /* limitless_modctx_*: NULL for each arg, and a context that was never built */
+  assert(limitless_modctx_init(NULL, &mc, &b) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_init(&ctx, NULL, &b) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_init(&ctx, &mc, NULL) == LIMITLESS_EINVAL);
+  limitless_modctx_clear(&ctx, NULL);
+  assert(limitless_number_from_i64(&ctx, &b, 0) == LIMITLESS_OK);
+  assert(limitless_modctx_init(&ctx, &mc, &b) == LIMITLESS_EDIVZERO);
+  assert(limitless_modctx_to_residue(&ctx, &mc, &out, &a) == LIMITLESS_EINVAL);
+  assert(limitless_number_from_i64(&ctx, &b, 3) == LIMITLESS_OK);
+  assert(limitless_modctx_init(&ctx, &mc, &b) == LIMITLESS_OK);
+  assert(limitless_modctx_to_residue(NULL, &mc, &out, &a) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_to_residue(&ctx, &mc, &out, NULL) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_from_residue(&ctx, NULL, &out, &a) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_from_residue(&ctx, &mc, NULL, &a) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_addmod(&ctx, &mc, &out, NULL, &a) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_addmod(&ctx, &mc, &out, &a, NULL) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_submod(NULL, &mc, &out, &a, &a) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_submod(&ctx, &mc, NULL, &a, &a) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_mulmod(&ctx, NULL, &out, &a, &a) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_mulmod(&ctx, &mc, &out, &a, NULL) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_powmod(&ctx, &mc, &out, &a, NULL) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_powmod(&ctx, &mc, &out, NULL, &a) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_invmod(&ctx, &mc, NULL, &a) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_invmod(&ctx, &mc, &out, NULL) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_mulmod_ct(&ctx, &mc, &out, NULL, &a) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_mulmod_ct(&ctx, NULL, &out, &a, &a) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_powmod_ct(&ctx, &mc, NULL, &a, &a) == LIMITLESS_EINVAL);
+  assert(limitless_modctx_powmod_ct(&ctx, &mc, &out, &a, NULL) == LIMITLESS_EINVAL);
+  limitless_modctx_clear(&ctx, &mc);
+
+  /* limitless_number_divmod_u64: NULL ctx/a, and both outputs NULL */
+  assert(limitless_number_divmod_u64(NULL, &out, &a, 7, NULL) == LIMITLESS_EINVAL);
+  assert(limitless_number_divmod_u64(&ctx, &out, NULL, 7, NULL) == LIMITLESS_EINVAL);
+  assert(limitless_number_divmod_u64(&ctx, NULL, &a, 7, NULL) == LIMITLESS_EINVAL);
+
   /* limitless_number_is_zero/is_integer/sign: NULL n */
   assert(limitless_number_is_zero(NULL) == 1);
   assert(limitless_number_is_integer(NULL) == 0);
@@ -169,6 +238,25 @@ static void test_karatsuba_threshold_edges(void) {
   limitless_ctx_set_karatsuba_threshold(&ctx, 1);
   /* Valid threshold */
   limitless_ctx_set_karatsuba_threshold(&ctx, 64);
+  assert(ctx.karatsuba_threshold == 64);
+
+  /* limbs < 3 should be clamped to 3 */
+  limitless_ctx_set_toom3_threshold(&ctx, 0);
+  assert(ctx.toom3_threshold == 3);
+  limitless_ctx_set_toom3_threshold(&ctx, 512);
+  assert(ctx.toom3_threshold == 512);
+  limitless_ctx_set_ntt_threshold(&ctx, 0);
+  assert(ctx.ntt_threshold == 2);
+  limitless_ctx_set_ntt_threshold(&ctx, 4096);
+  assert(ctx.ntt_threshold == 4096);
+  limitless_ctx_set_bz_threshold(&ctx, 0);
+  assert(ctx.bz_threshold == 2);
+  limitless_ctx_set_bz_threshold(&ctx, 300);
+  assert(ctx.bz_threshold == 300);
+  limitless_ctx_set_hgcd_threshold(&ctx, 1);
+  assert(ctx.hgcd_threshold == 4);
+  limitless_ctx_set_hgcd_threshold(&ctx, 200);
+  assert(ctx.hgcd_threshold == 200);
 }
 
 static void test_modexp_zero_modulus(void) {
@@ -242,9 +330,9 @@ static void test_oom_cmp_null_st(void) {
   assert(limitless_number_init(&ctx, &int_n) == LIMITLESS_OK);
   assert(limitless_number_init(&ctx, &rat_n) == LIMITLESS_OK);
 
-  /* Cross-type comparison (int vs rational) triggers the alloc path */
-  assert(limitless_number_from_i64(&ctx, &int_n, 42) == LIMITLESS_OK);
-  assert(limitless_number_from_str(&ctx, &rat_n, "99/2") == LIMITLESS_OK);
+  /* Cross-type comparison (int vs rational) triggers the alloc path; past 128 bits so the cross product cannot stay inline */
+  assert(limitless_number_from_str(&ctx, &int_n, "1234567890123456789012345678901234567890") == LIMITLESS_OK);
+  assert(limitless_number_from_str(&ctx, &rat_n, "9876543210987654321098765432109876543210/7") == LIMITLESS_OK);
 
   saw_oom_path = 0;
   for (step = 0; step < 256; ++step) {
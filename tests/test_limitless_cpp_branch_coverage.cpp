@@ -185,8 +185,9 @@ static void test_oom_in_cpp_wrapper() {
 
   /* binary_op OOM (lines 362, 369 error paths) */
   {
-    limitless::number a = 123456789;
-    limitless::number b = 987654321;
+    /* wider than the inline limbs, so the result has to allocate */
+    limitless::number a = limitless::number::parse("123456789012345678901234567890123456789012");
+    limitless::number b = limitless::number::parse("987654321098765432109876543210987654321098");
     assert(limitless::limitless_cpp_last_status() == LIMITLESS_OK);
 
     state.calls = 0;
@@ -198,21 +199,23 @@ static void test_oom_in_cpp_wrapper() {
 
   /* binary_op_inplace OOM (line 374 error path) */
   {
-    limitless::number a = 123456789;
-    limitless::number b = 987654321;
+    /* the product outgrows a's own limbs, so the in-place result has to allocate */
+    limitless::number a = limitless::number::parse("123456789012345678901234567890123456789012");
+    limitless::number b = limitless::number::parse("987654321098765432109876543210987654321098");
     assert(limitless::limitless_cpp_last_status() == LIMITLESS_OK);
 
     state.calls = 0;
     state.fail_after = 0;
-    a += b;
+    a *= b;
     assert(limitless::limitless_cpp_last_status() != LIMITLESS_OK);
     state.fail_after = 1000000;
   }
 
   /* cmp OOM (line 391 error path) */
   {
-    limitless::number a = limitless::number::parse("12345678901234567890/97");
-    limitless::number b = limitless::number::parse("-998877665544332211/89");
+    /* same sign and past 128 bits, so the cross products are computed and allocate */
+    limitless::number a = limitless::number::parse("123456789012345678901234567890123456789012/97");
+    limitless::number b = limitless::number::parse("123456789012345678901234567890123456789011/89");
     assert(limitless::limitless_cpp_last_status() == LIMITLESS_OK);
 
     state.calls = 0;
@@ -230,7 +233,8 @@ static void test_oom_in_cpp_wrapper() {
 
     state.calls = 0;
     state.fail_after = 0;
-    n = 3.14;
+    /* 1e300 is an integer of about 1000 bits, too wide for the inline limbs */
+    n = 1e300;
     assert(limitless::limitless_cpp_last_status() != LIMITLESS_OK);
     state.fail_after = 1000000;
   }
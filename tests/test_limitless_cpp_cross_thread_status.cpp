@@ -57,6 +57,32 @@ static void status_worker(int id, std::atomic<int>* failures) {
   limitless::limitless_cpp_set_default_ctx(NULL);
 }
 
+/* no override: every product below borrows Karatsuba scratch from the builtin context */
+static void builtin_worker(int id, limitless_ctx** seen, std::atomic<int>* failures) {
+  int i;
+
+  limitless::number a(3 + id);
+  limitless::number b(7);
+
+  seen[id] = limitless::limitless_cpp_get_default_ctx();
+  /* (3 + id)^4096 and 7^4096 are both well past the Karatsuba threshold */
+  for (i = 0; i < 12; ++i) {
+    a = a * a;
+    b = b * b;
+  }
+  for (i = 0; i < 40; ++i) {
+    limitless::number p = a * b;
+    if (limitless::limitless_cpp_last_status() != LIMITLESS_OK || p / b != a) {
+      failures->fetch_add(1, std::memory_order_relaxed);
+      break;
+    }
+    b += 1;
+  }
+  if (limitless::limitless_cpp_get_default_ctx() != seen[id]) {
+    failures->fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
 int main() {
   const int threads = 10;
   std::vector<std::thread> pool;
@@ -71,5 +97,24 @@ int main() {
   }
 
   assert(failures.load(std::memory_order_relaxed) == 0);
+
+  {
+    limitless_ctx* seen[threads];
+    int j;
+
+    pool.clear();
+    for (i = 0; i < threads; ++i) {
+      pool.push_back(std::thread(builtin_worker, i, seen, &failures));
+    }
+    for (i = 0; i < threads; ++i) {
+      pool[(size_t)i].join();
+    }
+    assert(failures.load(std::memory_order_relaxed) == 0);
+    /* each thread gets its own builtin context */
+    for (i = 0; i < threads; ++i) {
+      assert(seen[i] != NULL);
+      for (j = i + 1; j < threads; ++j) assert(seen[i] != seen[j]);
+    }
+  }
   return 0;
 }
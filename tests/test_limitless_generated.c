@@ -72,7 +72,7 @@ static void limitless_test_assert_normalized(const limitless_number* n) {
   assert(n->kind == LIMITLESS_KIND_RAT);
   assert(n->v.r.den.sign == 1);
   assert(n->v.r.den.used > 0);
-  assert(!(n->v.r.den.used == 1 && n->v.r.den.limbs[0] == (limitless_limb)1));
+  assert(!(n->v.r.den.used == 1 && LIMITLESS_BIGINT_LIMBS(&n->v.r.den)[0] == (limitless_limb)1));
   assert(n->v.r.num.used > 0);
 }
 